@@ -32,6 +32,15 @@
 #import <CBOR/CBORModel.h>
 #import <CBOR/CBORUndefined.h>
 #import <CBOR/CBORBreak.h>
+#import <CBOR/CBORIncrementalDecoder.h>
+#import <CBOR/CBORDecoderDelegate.h>
+#import <CBOR/CBORDocument.h>
+#import <CBOR/CBORSequence.h>
+#import <CBOR/CBORInternTable.h>
+#import <CBOR/CBORTypedArray.h>
+#import <CBOR/CBORStreamEncoder.h>
+#import <CBOR/CBOREncodeContext.h>
+#import <CBOR/CBORDecodeContext.h>
 
 #elif __has_include("CBORConstant.h")
 
@@ -40,5 +49,14 @@
 #import "CBORModel.h"
 #import "CBORUndefined.h"
 #import "CBORBreak.h"
+#import "CBORIncrementalDecoder.h"
+#import "CBORDecoderDelegate.h"
+#import "CBORDocument.h"
+#import "CBORSequence.h"
+#import "CBORInternTable.h"
+#import "CBORTypedArray.h"
+#import "CBORStreamEncoder.h"
+#import "CBOREncodeContext.h"
+#import "CBORDecodeContext.h"
 
 #endif
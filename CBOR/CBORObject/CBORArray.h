@@ -27,7 +27,9 @@
 
 NS_ASSUME_NONNULL_BEGIN
 /// 数组类型（字节数组/字符串/其他数组）
-@interface CBORArray : CBORObject
+///
+/// 不可变；`-mutableCopy`得到`CBORMutableArray`
+@interface CBORArray : CBORObject <NSMutableCopying>
 
 - (instancetype)initWithMajor:(CBORMajorType)major
                         minor:(CBORByte)minor
@@ -36,8 +38,19 @@ NS_ASSUME_NONNULL_BEGIN
 - (instancetype)initWithMajor:(CBORMajorType)major
                         value:(NSData *)value;
 
+/// 子元素数量
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+@end
+
+/// 可变数组类型，`-copy`得到不可变的`CBORArray`
+@interface CBORMutableArray : CBORArray
+
 - (void)addCBOR:(CBORObject *)cbor;
 
 @end
 
+/// 构建时追加子元素，仅用于对象发布前（解码、原生对象转化）
+FOUNDATION_EXTERN void CBORArrayAppend(CBORArray *array, CBORObject *cbor);
+
 NS_ASSUME_NONNULL_END
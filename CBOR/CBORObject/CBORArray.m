@@ -24,14 +24,18 @@
 //
 
 #import "CBORArray.h"
+#import "CBORUTF8.h"
 
 @interface CBORArray ()
 
-/// 缓存CBOR数据对象列表 `@[CBORObject]`
-@property (nonatomic, strong) NSMutableArray *cborObjects;
+/// 缓存CBOR数据对象列表 `@[CBORObject]`，未追加子元素时为nil
+@property (nonatomic, strong, nullable) NSMutableArray *cborObjects;
 /// 数据资源
 @property (nonatomic, nullable, copy) NSData *value;
 
+/// 拷贝到指定类型
+- (CBORArray *)copyToClass:(Class)cls zone:(nullable NSZone *)zone;
+
 @end
 
 @implementation CBORArray
@@ -53,16 +57,73 @@
                          value:value];
 }
 
-- (void)addCBOR:(CBORObject *)cbor {
-    [self.cborObjects addObject:cbor];
+void CBORArrayAppend(CBORArray *array, CBORObject *cbor) {
+    if (!array->_cborObjects) {
+        array->_cborObjects = [NSMutableArray array];
+    }
+    [array->_cborObjects addObject:cbor];
 }
 
+- (NSUInteger)count {
+    return [_cborObjects count];
+}
+
+/// 拷贝到指定类型，子元素本身不可变，只拷贝列表
+- (CBORArray *)copyToClass:(Class)cls zone:(NSZone *)zone {
+    CBORArray *ret = [[cls allocWithZone:zone] initWithMajor:self.majorType minor:self.minorType];
+    ret->_value = _value;
+    ret->_cborObjects = [_cborObjects mutableCopy];
+    return ret;
+}
+
+- (id)mutableCopyWithZone:(NSZone *)zone {
+    return [self copyToClass:[CBORMutableArray class] zone:zone];
+}
+
+/// 字节数组/字符串的完整内容，分段时拼接
+- (NSData *)contentValue {
+    if (_value) return _value;
+    
+    NSMutableData *ret = [NSMutableData data];
+    for (CBORObject *cbor in _cborObjects) {
+        if (![cbor isKindOfClass:[CBORArray class]]) continue;
+        NSData *chunk = [(CBORArray *)cbor value];
+        if (chunk) [ret appendData:chunk];
+    }
+    return ret;
+}
+
+/// 字节数组/字符串按完整内容比较，数组逐个比较子元素
+- (BOOL)isEqualToCBOR:(CBORObject *)cbor {
+    if (self == cbor) { return YES; }
+    if (![cbor isKindOfClass:[CBORArray class]] || cbor.majorType != self.majorType) { return NO; }
+    
+    CBORArray *other = (CBORArray *)cbor;
+    switch (self.majorType) {
+        case CBORMajorTypeBytes:
+        case CBORMajorTypeString:
+            return [[self contentValue] isEqualToData:[other contentValue]];
+        case CBORMajorTypeArray: {
+            NSUInteger count = [_cborObjects count];
+            if (count != [other->_cborObjects count]) { return NO; }
+            for (NSUInteger index = 0; index < count; index++) {
+                if (![_cborObjects[index] isEqual:other->_cborObjects[index]]) { return NO; }
+            }
+            return YES;
+        }
+        default:
+            return [super isEqualToCBOR:cbor];
+    }
+}
 
-- (NSMutableArray *)cborObjects {
-    if (!_cborObjects) {
-        _cborObjects = [NSMutableArray array];
+- (NSUInteger)hash {
+    switch (self.majorType) {
+        case CBORMajorTypeBytes:
+        case CBORMajorTypeString:
+            return [[self contentValue] hash] ^ self.majorType;
+        default:
+            return [_cborObjects count] ^ self.majorType;
     }
-    return _cborObjects;
 }
 
 /// CBOR对象转化为原生对象
@@ -72,7 +133,7 @@
             if (_value) return _value;
             
             NSMutableData *ret = [NSMutableData data];
-            for (CBORObject *cbor in self.cborObjects) {
+            for (CBORObject *cbor in _cborObjects) {
                 if (![cbor isKindOfClass:[CBORArray class]]) continue;
                 
                 [ret appendData:[(CBORArray *)cbor value]];
@@ -80,19 +141,22 @@
             return ret;
         }
         case CBORMajorTypeString: {
-            if (_value) return [[NSString alloc] initWithData:_value encoding:NSUTF8StringEncoding];
+            if (_value) return CBORUTF8String([_value bytes], [_value length], NO);
             
-            NSMutableString *ret = [NSMutableString string];
-            for (CBORObject *cbor in self.cborObjects) {
+            // 分段逐一校验后拼接为一块连续数据，只构建一次字符串
+            NSMutableData *joined = [NSMutableData data];
+            for (CBORObject *cbor in _cborObjects) {
                 if (![cbor isKindOfClass:[CBORArray class]]) continue;
                 
-                [ret appendString:[[NSString alloc] initWithData:[(CBORArray *)cbor value] encoding:NSUTF8StringEncoding]];
+                NSData *chunk = [(CBORArray *)cbor value];
+                if (!CBORUTF8Validate([chunk bytes], [chunk length], NULL)) return nil;
+                [joined appendData:chunk];
             }
-            return ret;
+            return CBORUTF8String([joined bytes], [joined length], YES);
         }
         case CBORMajorTypeArray: {
             NSMutableArray *ret = [NSMutableArray array];
-            for (CBORObject *cbor in self.cborObjects) {
+            for (CBORObject *cbor in _cborObjects) {
                 if (![cbor isKindOfClass:[CBORObject class]]) continue;
                 
                 [ret addObject:[cbor nsObject]];
@@ -104,26 +168,33 @@
     }
 }
 
-/// CBOR对象编码为数据
-- (nullable NSData *)cborData {
+/// CBOR对象写入数据
+- (BOOL)writeToWriter:(CBORWriter *)writer {
     switch (self.majorType) {
         case CBORMajorTypeBytes:
-        case CBORMajorTypeString:
-            if (_value) { return [self dataWithRaw:_value]; }
-            return [self dataWithRaw:(NSData *)[self nsObject]];
+        case CBORMajorTypeString: {
+            NSData *raw = _value;
+            if (!raw) {
+                // 分段数据拼接为一段定长数据
+                NSObject *joined = [self nsObject];
+                raw = [joined isKindOfClass:[NSString class]] ? [(NSString *)joined dataUsingEncoding:NSUTF8StringEncoding] : (NSData *)joined;
+                if (!raw) { return NO; }
+            }
+            return CBORWriterAppendString(writer, self.majorType, self.minorType, [raw bytes], [raw length]);
+        }
         case CBORMajorTypeArray: {
-            NSMutableData *ret = [NSMutableData data];
-            [ret appendData:[self dataWithLengthOrValue:[self.cborObjects count]]];
+            // 头部非法时仅省略头部，与子元素无关
+            CBORWriterAppendHeader(writer, self.majorType, self.minorType, [_cborObjects count], CBORLengthTypeMaxValue);
             
-            for (CBORObject *cbor in self.cborObjects) {
+            for (CBORObject *cbor in _cborObjects) {
                 if (![cbor isKindOfClass:[CBORObject class]]) continue;
                 
-                [ret appendData:[cbor cborData]];
+                [cbor writeToWriter:writer];
             }
-            return ret;
+            return YES;
         }
         default:
-            return nil;
+            return NO;
     }
 }
 
@@ -132,3 +203,16 @@
 }
 
 @end
+
+
+@implementation CBORMutableArray
+
+- (void)addCBOR:(CBORObject *)cbor {
+    CBORArrayAppend(self, cbor);
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    return [self copyToClass:[CBORArray class] zone:zone];
+}
+
+@end
@@ -26,19 +26,50 @@
 #import "CBORObject.h"
 
 NS_ASSUME_NONNULL_BEGIN
+/// 重复键的处理方式
+typedef NS_ENUM(NSUInteger, CBORMapDuplicateKeyPolicy) {
+    /// 新值替换已有的值，条目保持首次写入的位置
+    CBORMapDuplicateKeyPolicyLastWins = 0,
+    /// 保留已有的值
+    CBORMapDuplicateKeyPolicyFirstWins,
+    /// 拒绝写入
+    CBORMapDuplicateKeyPolicyReject,
+};
+
 /// 键值对类型
-@interface CBORMap : CBORObject
+///
+/// 条目按写入顺序保存，键按内容比较（参考`-isEqualToCBOR:`）；条目较多时建立散列索引，查找为常数时间
+///
+/// 不可变；`-mutableCopy`得到`CBORMutableMap`
+@interface CBORMap : CBORObject <NSMutableCopying>
+
+/// 条目数量
+@property (nonatomic, assign, readonly) NSUInteger count;
 
-/// 存储CBOR键值对
-- (void)setCBOR:(CBORObject *)value forKey:(CBORObject *)key;
 /// 获取已存储的CBOR
 - (nullable CBORObject *)cborForKey:(CBORObject *)key;
 
 /// 下标读取
 - (nullable CBORObject *)objectForKeyedSubscript:(CBORObject *)key;
+
+@end
+
+/// 可变键值对类型，`-copy`得到不可变的`CBORMap`
+@interface CBORMutableMap : CBORMap
+
+/// 重复键的处理方式，默认`CBORMapDuplicateKeyPolicyLastWins`
+@property (nonatomic, assign) CBORMapDuplicateKeyPolicy duplicateKeyPolicy;
+
+/// 存储CBOR键值对
+/// - Returns: 键已存在且按`duplicateKeyPolicy`保留已有的值或拒绝写入时返回NO
+- (BOOL)setCBOR:(CBORObject *)value forKey:(CBORObject *)key;
 /// 下标设置
 - (void)setObject:(CBORObject *)object forKeyedSubscript:(CBORObject *)aKey;
 
 @end
 
+/// 构建时写入键值对，仅用于对象发布前（解码、原生对象转化、模型编码）
+/// - Returns: 键已存在且按`policy`保留已有的值或拒绝写入时返回NO
+FOUNDATION_EXTERN BOOL CBORMapSetEntry(CBORMap *map, CBORObject *key, CBORObject *value, CBORMapDuplicateKeyPolicy policy);
+
 NS_ASSUME_NONNULL_END
@@ -54,51 +54,122 @@
 
 
 
+/// 条目超过该数量时建立散列索引，条目较少时顺序比较更快
+static const NSUInteger CBORMapIndexMinimumCount = 8;
+
 @interface CBORMap ()
 
-/// 缓存数据对象列表
-@property (nonatomic, strong) NSMutableArray *cbors;
+/// 缓存数据对象列表，未写入条目时为nil
+@property (nonatomic, strong, nullable) NSMutableArray *cbors;
+
+/// 拷贝到指定类型
+- (CBORMap *)copyToClass:(Class)cls zone:(nullable NSZone *)zone;
 
 @end
 
-@implementation CBORMap
+@implementation CBORMap {
+    /// 键 → 条目下标，条目较少时为NULL
+    CFMutableDictionaryRef _indexes;
+}
 
-- (void)setCBOR:(CBORObject *)value forKey:(CBORObject *)key {
-    // FIXME: 理论上应该排除同个Key的情况
-    [self.cbors addObject:[[CBORMapModel alloc] initWithKey:key value:value]];
+- (void)dealloc {
+    if (_indexes) CFRelease(_indexes);
 }
 
-- (nullable CBORObject *)cborForKey:(CBORObject *)key {
-    for (CBORMapModel *model in self.cbors) {
-        if (![model.key isEqualToCBOR:key]) continue;
-        return model.value;
+- (NSUInteger)count {
+    return [_cbors count];
+}
+
+/// 键所在条目的下标，不存在时返回NSNotFound
+- (NSUInteger)indexOfKey:(CBORObject *)key {
+    if (_indexes) {
+        const void *index = NULL;
+        return CFDictionaryGetValueIfPresent(_indexes, (__bridge const void *)key, &index) ? (NSUInteger)index : NSNotFound;
     }
-    return nil;
+    
+    NSUInteger index = 0;
+    for (CBORMapModel *model in _cbors) {
+        if ([model.key isEqualToCBOR:key]) return index;
+        index++;
+    }
+    return NSNotFound;
 }
 
-- (nullable CBORObject *)objectForKeyedSubscript:(CBORObject *)key {
-    if (![key isKindOfClass:[CBORObject class]]) return nil;
-    return [self cborForKey:key];
+BOOL CBORMapSetEntry(CBORMap *map, CBORObject *key, CBORObject *value, CBORMapDuplicateKeyPolicy policy) {
+    NSUInteger index = [map indexOfKey:key];
+    if (index != NSNotFound) {
+        if (policy != CBORMapDuplicateKeyPolicyLastWins) return NO;
+        
+        ((CBORMapModel *)map->_cbors[index]).value = value;
+        return YES;
+    }
+    
+    if (!map->_cbors) {
+        map->_cbors = [NSMutableArray array];
+    }
+    // 可变键写入后再修改会改变散列，存储不可变的拷贝；不可变键拷贝即自身
+    key = [key copy];
+    [map->_cbors addObject:[[CBORMapModel alloc] initWithKey:key value:value]];
+    NSUInteger count = [map->_cbors count];
+    if (map->_indexes) {
+        CFDictionarySetValue(map->_indexes, (__bridge const void *)key, (const void *)(count - 1));
+    } else if (count > CBORMapIndexMinimumCount) {
+        // 键的散列与比较经由`-hash`与`-isEqual:`，键已是不可变拷贝，只持有
+        map->_indexes = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &kCFTypeDictionaryKeyCallBacks, NULL);
+        for (NSUInteger i = 0; i < count; i++) {
+            CFDictionarySetValue(map->_indexes, (__bridge const void *)((CBORMapModel *)map->_cbors[i]).key, (const void *)i);
+        }
+    }
+    return YES;
 }
 
-- (void)setObject:(CBORObject *)object forKeyedSubscript:(CBORObject *)aKey {
-    if (![aKey isKindOfClass:[CBORObject class]] || ![object isKindOfClass:[CBORObject class]]) return;
-    [self setCBOR:object forKey:aKey];
+/// 拷贝到指定类型，键值本身不可变，只拷贝条目
+- (CBORMap *)copyToClass:(Class)cls zone:(NSZone *)zone {
+    CBORMap *ret = [[cls allocWithZone:zone] initWithMajor:self.majorType minor:self.minorType];
+    for (CBORMapModel *model in _cbors) {
+        CBORMapSetEntry(ret, model.key, model.value, CBORMapDuplicateKeyPolicyLastWins);
+    }
+    return ret;
+}
+
+- (id)mutableCopyWithZone:(NSZone *)zone {
+    return [self copyToClass:[CBORMutableMap class] zone:zone];
+}
+
+- (nullable CBORObject *)cborForKey:(CBORObject *)key {
+    NSUInteger index = [self indexOfKey:key];
+    return index == NSNotFound ? nil : ((CBORMapModel *)_cbors[index]).value;
 }
 
-- (NSMutableArray *)cbors {
-    if (!_cbors) {
-        _cbors = [NSMutableArray array];
+/// 条目数量相同，且每个键对应的值相等（与顺序无关）
+- (BOOL)isEqualToCBOR:(CBORObject *)cbor {
+    if (self == cbor) { return YES; }
+    if (![cbor isKindOfClass:[CBORMap class]] || cbor.majorType != self.majorType) { return NO; }
+    
+    CBORMap *other = (CBORMap *)cbor;
+    if ([_cbors count] != [other->_cbors count]) { return NO; }
+    for (CBORMapModel *model in _cbors) {
+        CBORObject *value = [other cborForKey:model.key];
+        if (!value || ![value isEqual:model.value]) { return NO; }
     }
-    return _cbors;
+    return YES;
+}
+
+- (NSUInteger)hash {
+    return [_cbors count] ^ self.majorType;
+}
+
+- (nullable CBORObject *)objectForKeyedSubscript:(CBORObject *)key {
+    if (![key isKindOfClass:[CBORObject class]]) return nil;
+    return [self cborForKey:key];
 }
 
 /// CBOR对象转化为原生对象
 - (NSObject *)nsObject {
     if (self.majorType != CBORMajorTypeMap) { return nil; }
     
-    NSMutableDictionary *ret = [NSMutableDictionary dictionaryWithCapacity:[self.cbors count]];
-    for (CBORMapModel *model in self.cbors) {
+    NSMutableDictionary *ret = [NSMutableDictionary dictionaryWithCapacity:[_cbors count]];
+    for (CBORMapModel *model in _cbors) {
         if (![model isKindOfClass:[CBORMapModel class]]) continue;
         
         NSObject *key = [model.key nsObject];
@@ -116,31 +187,44 @@
     return ret;
 }
 
-/// CBOR对象编码为数据
-- (NSData *)cborData {
-    if (self.majorType != CBORMajorTypeMap) { return nil; }
+/// CBOR对象写入数据
+- (BOOL)writeToWriter:(CBORWriter *)writer {
+    if (self.majorType != CBORMajorTypeMap) { return NO; }
     
-    NSMutableData *ret = [NSMutableData data];
-    [ret appendData:[self dataWithLengthOrValue:[self.cbors count]]];
+    CBORWriterAppendHeader(writer, self.majorType, self.minorType, [_cbors count], CBORLengthTypeMaxValue);
     
-    for (CBORMapModel *model in self.cbors) {
+    for (CBORMapModel *model in _cbors) {
         if (![model isKindOfClass:[CBORMapModel class]]) continue;
         
-        NSData *key = [model.key cborData];
-        if (!key) continue;
-        NSData *value = [model.value cborData];
-        if (!value) continue;
-        
-        [ret appendData:key];
-        [ret appendData:value];
+        // 键或值无法编码时整个条目都不写入
+        NSUInteger entry = writer->length;
+        if (![model.key writeToWriter:writer]) continue;
+        if (![model.value writeToWriter:writer]) { CBORWriterTruncate(writer, entry); }
     }
     
-    return ret;
+    return YES;
 }
 
 - (NSString *)description {
-    return [NSString stringWithFormat:@"[CBORMap] %@", self.cbors];
+    return [NSString stringWithFormat:@"[CBORMap] %@", _cbors];
 }
 
 @end
 
+
+@implementation CBORMutableMap
+
+- (BOOL)setCBOR:(CBORObject *)value forKey:(CBORObject *)key {
+    return CBORMapSetEntry(self, key, value, _duplicateKeyPolicy);
+}
+
+- (void)setObject:(CBORObject *)object forKeyedSubscript:(CBORObject *)aKey {
+    if (![aKey isKindOfClass:[CBORObject class]] || ![object isKindOfClass:[CBORObject class]]) return;
+    [self setCBOR:object forKey:aKey];
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    return [self copyToClass:[CBORMap class] zone:zone];
+}
+
+@end
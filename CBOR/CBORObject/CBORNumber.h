@@ -25,6 +25,16 @@
 
 #import "CBORObject.h"
 
+/// 半精度浮点数（位表示）转单精度浮点数
+FOUNDATION_EXPORT float uint16_to_float(uint16_t value);
+/// 单精度浮点数转半精度浮点数（位表示）
+FOUNDATION_EXPORT uint16_t float_to_uint16(float value);
+/// 浮点数无损表示所需的最小精度（次要类型）
+FOUNDATION_EXPORT CBORMinorType check_floating_type(CBORFloat64 value);
+/// 按指定精度写入浮点数
+/// - Returns: 次要类型不是浮点数时不写入并返回NO
+FOUNDATION_EXPORT BOOL CBORNumberWriteFloat(CBORWriter *writer, CBORMajorType major, CBORMinorType minor, CBORFloat64 value);
+
 NS_ASSUME_NONNULL_BEGIN
 /// 数字类型（整数/浮点数/简单值）
 @interface CBORNumber : CBORObject
@@ -43,6 +53,13 @@ NS_ASSUME_NONNULL_BEGIN
 - (instancetype)initWithMajor:(CBORMajorType)major
                 unsignedValue:(CBORUInt64)value;
 
+/// 构建整数 或 半精度浮点数；0~23与-1~-24按最短宽度编码时返回共享实例
++ (instancetype)numberWithMajor:(CBORMajorType)major
+                          minor:(CBORMinorType)minor
+                  unsignedValue:(CBORUInt64)value;
++ (instancetype)numberWithMajor:(CBORMajorType)major
+                  unsignedValue:(CBORUInt64)value;
+
 @end
 
 NS_ASSUME_NONNULL_END
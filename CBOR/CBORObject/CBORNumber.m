@@ -24,6 +24,7 @@
 //
 
 #import "CBORNumber.h"
+#import "CBORDecodeHeader.h"
 
 
 union Fp32 {
@@ -102,6 +103,35 @@ CBORMinorType check_floating_type(CBORFloat64 value) {
     return CBORAdditionalTypeDouble;
 }
 
+BOOL CBORNumberWriteFloat(CBORWriter *writer, CBORMajorType major, CBORMinorType minor, CBORFloat64 value) {
+    CBORAdditionalType minorType = CBORTypeMinor(minor);
+    UInt8 bytes[1 + sizeof(CFSwappedFloat64)];
+    bytes[0] = major | minorType;
+    
+    switch (minorType) {
+        case CBORAdditionalTypeHalf: {
+            UInt16 half = CFSwapInt16HostToBig(float_to_uint16(value));
+            memcpy(bytes + 1, &half, sizeof(half));
+            CBORWriterAppendBytes(writer, bytes, 1 + sizeof(half));
+            return YES;
+        }
+        case CBORAdditionalTypeFloat: {
+            CFSwappedFloat32 single = CFConvertFloat32HostToSwapped(value);
+            memcpy(bytes + 1, &single, sizeof(single));
+            CBORWriterAppendBytes(writer, bytes, 1 + sizeof(single));
+            return YES;
+        }
+        case CBORAdditionalTypeDouble: {
+            CFSwappedFloat64 swapped = CFConvertFloat64HostToSwapped(value);
+            memcpy(bytes + 1, &swapped, sizeof(swapped));
+            CBORWriterAppendBytes(writer, bytes, 1 + sizeof(swapped));
+            return YES;
+        }
+        default:
+            return NO;
+    }
+}
+
 @interface CBORNumber ()
 
 /// 无符号整数
@@ -154,13 +184,84 @@ CBORMinorType check_floating_type(CBORFloat64 value) {
    
 }
 
+/// 直接编码在首字节中的整数个数
+#define CBORNumberSharedCount 24
+
++ (instancetype)numberWithMajor:(CBORMajorType)major
+                          minor:(CBORMinorType)minor
+                  unsignedValue:(CBORUInt64)value {
+    BOOL integer = major == CBORMajorTypeUnsigned || major == CBORMajorTypeNegative;
+    // 指定了编码宽度的整数与共享实例编码结果不同
+    BOOL widened = minor == CBORLengthTypeUInt8 || minor == CBORLengthTypeUInt16 || minor == CBORLengthTypeUInt32 || minor == CBORLengthTypeUInt64;
+    if (!integer || widened || value >= CBORNumberSharedCount) {
+        return [[self alloc] initWithMajor:major minor:minor unsignedValue:value];
+    }
+    
+    // 对象不可变，可跨线程共享
+    static CBORNumber *numbers[2][CBORNumberSharedCount];
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        for (CBORUInt64 index = 0; index < CBORNumberSharedCount; index++) {
+            numbers[0][index] = [[CBORNumber alloc] initWithMajor:CBORMajorTypeUnsigned minor:index unsignedValue:index];
+            numbers[1][index] = [[CBORNumber alloc] initWithMajor:CBORMajorTypeNegative minor:index unsignedValue:index];
+        }
+    });
+    return numbers[major == CBORMajorTypeNegative][value];
+}
+
++ (instancetype)numberWithMajor:(CBORMajorType)major
+                  unsignedValue:(CBORUInt64)value {
+    return [self numberWithMajor:major
+                           minor:CBORMinorWithValue(value)
+                   unsignedValue:value];
+}
+
+/// 是否是浮点数
+- (BOOL)isFloat {
+    if (self.majorType != CBORMajorTypeAdditional) { return NO; }
+    switch (self.minorType) {
+        case CBORAdditionalTypeHalf:
+        case CBORAdditionalTypeFloat:
+        case CBORAdditionalTypeDouble:
+            return YES;
+        default:
+            return NO;
+    }
+}
+
+/// 整数按值比较，不区分编码宽度；浮点数按值比较，不区分精度，NaN与NaN相等；简单值比较次要类型与值
+- (BOOL)isEqualToCBOR:(CBORObject *)cbor {
+    if (self == cbor) { return YES; }
+    if (![cbor isKindOfClass:[CBORNumber class]] || cbor.majorType != self.majorType) { return NO; }
+    
+    CBORNumber *other = (CBORNumber *)cbor;
+    BOOL isFloat = [self isFloat];
+    if (isFloat != [other isFloat]) { return NO; }
+    if (isFloat) { return _floatValue == other->_floatValue || (isnan(_floatValue) && isnan(other->_floatValue)); }
+    
+    if (self.majorType == CBORMajorTypeAdditional && self.minorType != other.minorType) { return NO; }
+    return _unsignedIntegerValue == other->_unsignedIntegerValue;
+}
+
+- (NSUInteger)hash {
+    if ([self isFloat]) {
+        // 与比较一致：所有NaN、正负零分别散列到同一值
+        if (isnan(_floatValue)) { return NSUIntegerMax; }
+        if (_floatValue == 0) { return self.majorType; }
+        UInt64 bits = 0;
+        memcpy(&bits, &_floatValue, sizeof(bits));
+        return (NSUInteger)(bits ^ (bits >> 32));
+    }
+    return (NSUInteger)(_unsignedIntegerValue * 31) ^ self.majorType;
+}
+
 /// CBOR对象转化为原生对象
 - (nullable NSObject *)nsObject {
     switch (self.majorType) {
         case CBORMajorTypeNegative:
-            return @((SInt64)(-(_unsignedIntegerValue + 1)));
+            return CBORDecodeNegativeNumber(_unsignedIntegerValue);
         case CBORMajorTypeUnsigned:
-            return @(_unsignedIntegerValue);
+            return CBORDecodeUnsignedNumber(_unsignedIntegerValue);
         case CBORMajorTypeAdditional: {
             switch (self.minorType) {
                 case CBORAdditionalTypeHalf:
@@ -168,7 +269,7 @@ CBORMinorType check_floating_type(CBORFloat64 value) {
                 case CBORAdditionalTypeDouble:
                     return @(_floatValue);
                 default:
-                    return @(_unsignedIntegerValue);
+                    return CBORDecodeUnsignedNumber(_unsignedIntegerValue);
             }
         }
         default:
@@ -176,63 +277,29 @@ CBORMinorType check_floating_type(CBORFloat64 value) {
     }
 }
 
-/// CBOR对象转化为数据
-- (nullable NSData *)cborData {
+/// CBOR对象写入数据
+- (BOOL)writeToWriter:(CBORWriter *)writer {
     switch (self.majorType) {
         case CBORMajorTypeUnsigned:
-        case CBORMajorTypeNegative: {
-            return [self dataWithLengthOrValue:_unsignedIntegerValue];
-        }
+        case CBORMajorTypeNegative:
+            return CBORWriterAppendHeader(writer, self.majorType, self.minorType, _unsignedIntegerValue, CBORLengthTypeMaxValue);
         case CBORMajorTypeAdditional: {
             switch (self.minorType) {
                 case CBORAdditionalTypeHalf:
                 case CBORAdditionalTypeFloat:
                 case CBORAdditionalTypeDouble:
-                    return [self dataWithFloatValue];;
+                    return [self writeFloatValueToWriter:writer];
                 default:
-                    return [self dataWithLengthOrValue:_unsignedIntegerValue
-                                         minorMaxValue:CBORAdditionalTypeSimpleMinMaxValue];
+                    return CBORWriterAppendHeader(writer, self.majorType, self.minorType, _unsignedIntegerValue, CBORAdditionalTypeSimpleMinMaxValue);
             }
         }
-        default: return nil;
+        default: return NO;
     }
 }
 
-/// 构建CBOR浮点数数据
-- (NSData *)dataWithFloatValue {
-    NSMutableData *ret = [NSMutableData data];
-    
-    CBORAdditionalType minor = CBORTypeMinor(self.minorType);
-    NSData *value = [self floatDataWithType:minor];
-    if (![value length]) { return nil; }
-    
-    CBORByte type = self.majorType | minor;
-    
-    [ret appendBytes:&type length:1];
-    [ret appendData:value];
-    
-    return ret;
-}
-
-- (NSData *)floatDataWithType:(CBORAdditionalType)type {
-    NSUInteger length = CBORByteWithLenghtType(type);
-    
-    switch (type) {
-        case CBORAdditionalTypeHalf: {
-            UInt16 ret = CFSwapInt16HostToBig(float_to_uint16(_floatValue));
-            return [NSData dataWithBytes:&ret length:length];
-        }
-        case CBORAdditionalTypeFloat: {
-            CFSwappedFloat32 ret = CFConvertFloat32HostToSwapped(_floatValue);
-            return [NSData dataWithBytes:&ret length:length];
-        }
-        case CBORAdditionalTypeDouble: {
-            CFSwappedFloat64 ret = CFConvertFloat64HostToSwapped(_floatValue);
-            return [NSData dataWithBytes:&ret length:length];
-        }
-        default:
-            return [NSData data];
-    }
+/// 写入CBOR浮点数数据
+- (BOOL)writeFloatValueToWriter:(CBORWriter *)writer {
+    return CBORNumberWriteFloat(writer, self.majorType, self.minorType, _floatValue);
 }
 
 - (NSString *)description {
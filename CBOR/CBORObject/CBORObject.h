@@ -26,9 +26,12 @@
 #import <Foundation/Foundation.h>
 #import "CBORConstant.h"
 #import "CBORUtils.h"
+#import "CBORWriter.h"
 
 NS_ASSUME_NONNULL_BEGIN
 /// 自定义CBOR对象
+///
+/// 对象构建完成后不可变，可跨线程共享，`-copy`只持有自身；需要修改时使用`CBORMutableArray`/`CBORMutableMap`
 @interface CBORObject : NSObject <NSCopying>
 
 /// 主要类型
@@ -46,6 +49,11 @@ NS_ASSUME_NONNULL_BEGIN
 - (nullable NSObject *)nsObject;
 /// CBOR对象编码为数据
 - (nullable NSData *)cborData;
+/// CBOR对象编码后的字节数，不分配输出内存；无法编码时返回0
+- (NSUInteger)cborLength;
+/// CBOR对象直接写入写入器，子元素与头部追加到同一块内存
+/// - Returns: 无法编码时返回NO（对应`-cborData`返回nil），且不会留下部分写入的内容
+- (BOOL)writeToWriter:(CBORWriter *)writer;
 
 
 
@@ -60,7 +68,9 @@ NS_ASSUME_NONNULL_BEGIN
 /// 是否是终止符
 - (BOOL)isBreak;
 
-/// 两个CBOR是否相等
+/// 两个CBOR是否表示相同的数据项：按内容比较，整数不区分编码宽度，分段与定长的字节数组/字符串内容相同即相等
+///
+/// `-isEqual:`与`-hash`与之一致，可作为散列表的键
 - (BOOL)isEqualToCBOR:(CBORObject *)cbor;
 
 @end
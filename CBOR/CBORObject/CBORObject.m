@@ -47,9 +47,9 @@
     return [self initWithMajor:major minor:0];
 }
 
+/// 对象不可变，拷贝即持有自身；可变子类返回不可变的拷贝
 - (nonnull id)copyWithZone:(nullable NSZone *)zone { 
-    return [[[self class] allocWithZone:zone] initWithMajor:_majorType
-                                                      minor:_minorType];
+    return self;
 }
 
 /// 转化为NS原生对象
@@ -60,8 +60,27 @@
 
 /// 转化为CBOR数据
 - (nullable NSData *)cborData {
+    // 单次写入可增长的缓冲区，不先计量长度
+    CBORWriter writer;
+    CBORWriterInit(&writer, 0);
+    if (![self writeToWriter:&writer]) {
+        CBORWriterDispose(&writer);
+        return nil;
+    }
+    return CBORWriterFinish(&writer);
+}
+
+/// CBOR数据长度
+- (NSUInteger)cborLength {
+    CBORWriter writer;
+    CBORWriterInitMeasuring(&writer);
+    return [self writeToWriter:&writer] ? writer.length : 0;
+}
+
+/// 写入CBOR数据
+- (BOOL)writeToWriter:(CBORWriter *)writer {
     NSAssert(false, @"子类实现");
-    return nil;
+    return NO;
 }
 
 
@@ -106,8 +125,19 @@
 }
 
 - (BOOL)isEqualToCBOR:(CBORObject *)cbor {
+    if (self == cbor) { return YES; }
     if (![cbor isKindOfClass:[self class]]) { return NO; }
-    return self.majorType == cbor.majorType && self.minorType == self.minorType;
+    return self.majorType == cbor.majorType && self.minorType == cbor.minorType;
+}
+
+- (BOOL)isEqual:(id)object {
+    if (self == object) { return YES; }
+    if (![object isKindOfClass:[CBORObject class]]) { return NO; }
+    return [self isEqualToCBOR:object];
+}
+
+- (NSUInteger)hash {
+    return self.majorType ^ (NSUInteger)self.minorType;
 }
 
 
@@ -29,10 +29,14 @@ NS_ASSUME_NONNULL_BEGIN
 /// 简单类型（不包含浮点数，简单值）
 @interface CBORSimple : CBORObject
 
+/// 共享实例，对象不可变，可跨线程共享
 + (instancetype)cborBreak;
 + (instancetype)cborNull;
 + (instancetype)cborYES;
 + (instancetype)cborNO;
++ (instancetype)cborUndefined;
+/// true/false/null/undefined/终止符返回共享实例，其余简单值新建
++ (instancetype)simpleWithMinor:(CBORMinorType)minor;
 
 - (BOOL)isNull;
 - (BOOL)isYES;
@@ -30,13 +30,34 @@
 @implementation CBORSimple
 
 + (instancetype)simpleWithMinor:(CBORMinorType)minor {
-    return [[self alloc] initWithMajor:CBORMajorTypeAdditional minor:minor];
+    static CBORSimple *shared[4];
+    static CBORSimple *cborBreak;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        for (CBORMinorType index = 0; index < 4; index++) {
+            shared[index] = [[CBORSimple alloc] initWithMajor:CBORMajorTypeAdditional minor:CBORAdditionalTypeFalse + index];
+        }
+        cborBreak = [[CBORSimple alloc] initWithMajor:CBORMajorTypeAdditional minor:CBORAdditionalTypeBreak];
+    });
+    
+    switch (minor) {
+        case CBORAdditionalTypeFalse:
+        case CBORAdditionalTypeTrue:
+        case CBORAdditionalTypeNull:
+        case CBORAdditionalTypeUndefined:
+            return shared[minor - CBORAdditionalTypeFalse];
+        case CBORAdditionalTypeBreak:
+            return cborBreak;
+        default:
+            return [[self alloc] initWithMajor:CBORMajorTypeAdditional minor:minor];
+    }
 }
 
 + (instancetype)cborBreak { return [self simpleWithMinor:CBORAdditionalTypeBreak]; }
 + (instancetype)cborNull { return [self simpleWithMinor:CBORAdditionalTypeNull]; }
 + (instancetype)cborYES { return [self simpleWithMinor:CBORAdditionalTypeTrue]; }
 + (instancetype)cborNO { return [self simpleWithMinor:CBORAdditionalTypeFalse]; }
++ (instancetype)cborUndefined { return [self simpleWithMinor:CBORAdditionalTypeUndefined]; }
 
 
 - (BOOL)isNull {
@@ -78,9 +99,9 @@
     }
 }
 
-/// CBOR对象编码为数据
-- (nullable NSData *)cborData {
-    if (self.majorType != CBORMajorTypeAdditional) return nil;
+/// CBOR对象写入数据
+- (BOOL)writeToWriter:(CBORWriter *)writer {
+    if (self.majorType != CBORMajorTypeAdditional) return NO;
     
     switch (self.minorType) {
         case CBORAdditionalTypeTrue:
@@ -89,12 +110,12 @@
         case CBORAdditionalTypeUndefined:
         case CBORAdditionalTypeBreak: {
             CBORByte value = self.majorType | self.minorType;
-            NSUInteger length = sizeof(value);
-            return [NSData dataWithBytes:&value length:length];
+            CBORWriterAppendBytes(writer, &value, sizeof(value));
+            return YES;
         }
             // 浮点数/简单值的类型在CBORNumber中处理
         default:
-            return nil;
+            return NO;
     }
 }
 
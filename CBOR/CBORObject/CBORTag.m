@@ -24,6 +24,7 @@
 //
 
 #import "CBORTag.h"
+#import "CBORTypedArray.h"
 
 @interface CBORTag ()
 
@@ -47,6 +48,19 @@
     return self;
 }
 
+/// 扩展标记与扩展数据均相等
+- (BOOL)isEqualToCBOR:(CBORObject *)cbor {
+    if (self == cbor) { return YES; }
+    if (![cbor isKindOfClass:[CBORTag class]] || cbor.majorType != self.majorType) { return NO; }
+    
+    CBORTag *other = (CBORTag *)cbor;
+    return _tag == other->_tag && (_value == other->_value || [_value isEqual:other->_value]);
+}
+
+- (NSUInteger)hash {
+    return (NSUInteger)_tag ^ [_value hash];
+}
+
 /// CBOR对象转化为原生对象
 - (nullable NSObject *)nsObject {
     if (self.majorType != CBORMajorTypeTag) { return nil; }
@@ -64,21 +78,28 @@
         default: break;
     }
     
+    if ([CBORTypedArray isTypedArrayTag:self.tag]) {
+        NSObject *value = [_value nsObject];
+        if (![value isKindOfClass:[NSData class]]) { return value; }
+        
+        return [CBORTypedArray typedArrayWithTag:self.tag data:(NSData *)value];
+    }
+    
     return [_value nsObject];
 }
 
-/// CBOR对象转化为数据
-- (nullable NSData *)cborData {
-    if (self.majorType != CBORMajorTypeTag) { return nil; }
+/// CBOR对象写入数据
+- (BOOL)writeToWriter:(CBORWriter *)writer {
+    if (self.majorType != CBORMajorTypeTag) { return NO; }
     
-    NSMutableData *ret = [NSMutableData data];
-    [ret appendData:[self dataWithLengthOrValue:self.tag]];
+    NSUInteger start = writer->length;
+    CBORWriterAppendHeader(writer, self.majorType, self.minorType, self.tag, CBORLengthTypeMaxValue);
     
-    NSData *value = [_value cborData];
-    if (!value) { return nil; }
-    [ret appendData:value];
-    
-    return ret;
+    if (![_value writeToWriter:writer]) {
+        CBORWriterTruncate(writer, start);
+        return NO;
+    }
+    return YES;
 }
 
 
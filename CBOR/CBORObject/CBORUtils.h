@@ -86,6 +86,16 @@ static inline CBORMinorType CBORMinorWithValue(CBORUInt64 value) {
 }
 
 
+/// 字符串编入引用表所需的最小字节数：引用本身的长度随下标增长，字符串比引用长时才编入
+/// - Parameter index: 字符串表当前的大小，即新字符串将获得的下标
+static inline NSUInteger CBORStringReferenceMinLength(NSUInteger index) {
+    if (index < 24) return 3;
+    if (index < 256) return 4;
+    if (index < 65536) return 5;
+    if (index <= UINT32_MAX) return 7;
+    return 11;
+}
+
 /// 长度类型是否有效
 static inline bool CBORIsLengthTypeValid(CBORLengthType type) {
     return type != CBORLengthTypeUndefined;
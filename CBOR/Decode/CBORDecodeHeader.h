@@ -0,0 +1,162 @@
+// refer: https://github.com/DanielHusx/CBOR
+//
+// MIT License
+//
+// Copyright (c) 2024 Daniel
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "CBORConstant.h"
+#import "CBORUtils.h"
+#import "CBORStream.h"
+
+// 解码共用的头部解析：对象解码、事件解码、路径解码与文档解码接受完全一致的输入
+
+/// 首字节解码类别
+typedef NS_ENUM(UInt8, CBORDecodeKind) {
+    /// 非法（保留的次要类型等）
+    CBORDecodeKindInvalid = 0,
+    CBORDecodeKindUnsigned,
+    CBORDecodeKindNegative,
+    CBORDecodeKindBytes,
+    CBORDecodeKindString,
+    CBORDecodeKindIndefiniteBytes,
+    CBORDecodeKindIndefiniteString,
+    CBORDecodeKindArray,
+    CBORDecodeKindIndefiniteArray,
+    CBORDecodeKindMap,
+    CBORDecodeKindIndefiniteMap,
+    CBORDecodeKindTag,
+    /// 简单值（0~19，32~255）
+    CBORDecodeKindSimpleValue,
+    /// 简单类型（false/true/null/undefined）
+    CBORDecodeKindSimple,
+    CBORDecodeKindHalf,
+    CBORDecodeKindFloat,
+    CBORDecodeKindDouble,
+    CBORDecodeKindBreak,
+};
+
+/// 首字节分发信息
+typedef struct {
+    /// 解码类别
+    CBORDecodeKind kind;
+    /// 头部参数后续字节数（0/1/2/4/8）
+    UInt8 argumentLength;
+} CBORInitialByte;
+
+/// 首字节分发表：一次查表得到类别与参数长度，避免逐层判断主要/次要类型
+FOUNDATION_EXTERN const CBORInitialByte * CBORInitialByteTable(void);
+
+/// 是否是不定长容器
+static inline BOOL CBORDecodeKindIsIndefinite(CBORDecodeKind kind) {
+    return kind == CBORDecodeKindIndefiniteBytes
+        || kind == CBORDecodeKindIndefiniteString
+        || kind == CBORDecodeKindIndefiniteArray
+        || kind == CBORDecodeKindIndefiniteMap;
+}
+
+
+/// 解码帧（未完成的容器）
+typedef struct {
+    /// 容器类别
+    CBORDecodeKind kind;
+    /// 容器对象（CBOR对象或原生对象；扩展类型及事件解码为空），手动管理引用计数
+    CFTypeRef container;
+    /// 键值对中待匹配值的键
+    CFTypeRef key;
+    /// 定长容器剩余子元素数量（键值对的键与值分别计数）
+    UInt64 remaining;
+    /// 扩展标记
+    CBORTagType tag;
+    /// 容器在文档条目中的位置（仅文档解码）
+    NSUInteger index;
+} CBORDecodeFrame;
+
+/// 解码帧栈，分配在堆上，嵌套深度不再受调用栈限制
+typedef struct {
+    CBORDecodeFrame *frames;
+    NSUInteger depth;
+    NSUInteger capacity;
+} CBORDecodeStack;
+
+/// 压入解码帧，超出深度限制时释放帧持有的容器并返回NO
+FOUNDATION_EXTERN BOOL CBORDecodeStackPush(CBORDecodeStack *stack, CBORDecodeLimits limits, CBORDecodeFrame frame);
+/// 释放解码帧栈（解码失败时仍持有未完成的容器）
+FOUNDATION_EXTERN void CBORDecodeStackDispose(CBORDecodeStack *stack);
+/// 释放帧持有的容器并清空帧栈，保留已分配的帧供下次解码复用
+FOUNDATION_EXTERN void CBORDecodeStackReset(CBORDecodeStack *stack);
+
+/// 从游标位置解码一个元素为原生对象，结果与`+[CBORDecoder decodeObjectWithData:limits:]`一致，成功时游标停在元素之后
+FOUNDATION_EXTERN id CBORDecodeObjectAtCursor(CBORStream *stream, CBORDecodeLimits limits, CBORDecodeStack *stack);
+/// 从游标位置跳过一个元素，仅校验数据合法性
+FOUNDATION_EXTERN BOOL CBORDecodeSkipAtCursor(CBORCursor *cursor, CBORDecodeLimits limits, CBORDecodeStack *stack);
+
+/// 非负整数，0~255返回缓存实例，结果与`@(value)`一致
+FOUNDATION_EXTERN NSNumber * CBORDecodeUnsignedNumber(UInt64 value);
+/// 负整数（参数为编码值），-1~-256返回缓存实例，结果与`@((SInt64)(-(argument + 1)))`一致
+FOUNDATION_EXTERN NSNumber * CBORDecodeNegativeNumber(UInt64 argument);
+
+/// 解码头部
+typedef struct {
+    /// 首字节分发信息
+    CBORInitialByte entry;
+    CBORMajorType major;
+    CBORByte minor;
+    /// 头部参数：值、长度或扩展标记
+    CBORUInt64 argument;
+} CBORDecodeHeader;
+
+/// 读取头部，并校验元素数量限制与不定长分片类型
+static inline BOOL CBORDecodeReadHeader(CBORCursor *cursor,
+                                        const CBORInitialByte *table,
+                                        const CBORDecodeStack *stack,
+                                        CBORDecodeLimits limits,
+                                        NSUInteger *items,
+                                        CBORDecodeHeader *header) {
+    CBORByte byte = 0;
+    if (!CBORCursorReadUInt8(cursor, &byte)) { return NO; }
+    
+    CBORInitialByte entry = table[byte];
+    header->entry = entry;
+    header->major = CBORTypeMajor(byte);
+    header->minor = CBORTypeMinor(byte);
+    header->argument = header->minor;
+    if (entry.argumentLength && !CBORCursorReadUInt(cursor, entry.argumentLength, &header->argument)) { return NO; }
+    
+    if (entry.kind == CBORDecodeKindBreak) { return YES; }
+    if (limits.maxItems && ++(*items) > limits.maxItems) { return NO; }
+    
+    // 不定长字节数组/字符串仅允许同类型的定长分片
+    if (stack->depth) {
+        CBORDecodeKind parent = stack->frames[stack->depth - 1].kind;
+        if (parent == CBORDecodeKindIndefiniteBytes && entry.kind != CBORDecodeKindBytes) { return NO; }
+        if (parent == CBORDecodeKindIndefiniteString && entry.kind != CBORDecodeKindString) { return NO; }
+    }
+    return YES;
+}
+
+
+/// 下一个字节是否是终止符
+static inline BOOL CBORCursorPeekBreak(const CBORCursor *cursor) {
+    return cursor->index < cursor->length
+        && cursor->bytes[cursor->index] == (CBORMajorTypeAdditional | CBORAdditionalTypeBreak);
+}
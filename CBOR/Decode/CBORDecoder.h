@@ -24,15 +24,56 @@
 //
 
 #import <Foundation/Foundation.h>
+#import "CBORConstant.h"
+#import "CBORDecoderDelegate.h"
 
 NS_ASSUME_NONNULL_BEGIN
 @class CBORObject;
+@class CBORInternTable;
 
 /// CBOR解码器
 @interface CBORDecoder : NSObject
 
 /// 解码数据
 + (nullable CBORObject *)decodeData:(NSData *)aData;
+/// 解码数据，超出限制时返回nil
++ (nullable CBORObject *)decodeData:(NSData *)aData limits:(CBORDecodeLimits)limits;
+
+/// 解码数据为原生对象，一次遍历完成，不构建中间CBOR对象
+/// - Returns: 与`[[CBORDecoder decodeData:] nsObject]`结果一致
++ (nullable id)decodeObjectWithData:(NSData *)aData limits:(CBORDecodeLimits)limits;
+/// 解码数据为原生对象，键值对的键通过驻留表复用
+/// - Parameter internTable: 驻留表，为空时本次解码使用独立的驻留表
++ (nullable id)decodeObjectWithData:(NSData *)aData
+                             limits:(CBORDecodeLimits)limits
+                        internTable:(nullable CBORInternTable *)internTable;
+
+/// 内存映射文件后解码为原生对象，字节数组为共享映射内存的数据视图
+/// - Note: 始终映射（包括可移除卷与网络卷），解码结果释放前文件不可被修改或截断
+/// - Returns: 文件无法读取或数据非法时返回nil
++ (nullable id)decodeObjectWithContentsOfFile:(NSString *)path
+                                      options:(CBORDecodeOptions)options
+                                       limits:(CBORDecodeLimits)limits;
+
+/// 从指定位置解码一条记录为原生对象（用于CBOR序列）
+/// - Parameters:
+///   - offset: 输入记录起始位置，输出下一条记录的起始位置
+/// - Returns: 记录非法时返回`CBORDecodeStatusMalformed`并跳过该记录；已无数据时返回`CBORDecodeStatusNeedMoreData`
++ (CBORDecodeStatus)decodeObject:(id _Nullable * _Nullable)object
+                            data:(NSData *)aData
+                          offset:(NSUInteger *)offset
+                          limits:(CBORDecodeLimits)limits;
+
+/// 并行解码为原生对象：顶层为数组时扫描元素边界，分配到多个线程解码后按顺序组装
+/// - Returns: 与`+decodeObjectWithData:limits:`结果一致
++ (nullable id)decodeObjectConcurrentlyWithData:(NSData *)aData limits:(CBORDecodeLimits)limits;
+
+/// 事件驱动解码，依次回调代理，不构建任何对象
+/// - Returns: 数据合法或被代理停止时返回YES
++ (BOOL)decodeData:(NSData *)aData delegate:(id<CBORDecoderDelegate>)delegate limits:(CBORDecodeLimits)limits;
+
+/// 按路径解码单个元素，途经的其他元素仅扫描跳过
++ (nullable id)decodeObjectAtPath:(NSArray *)path data:(NSData *)aData limits:(CBORDecodeLimits)limits;
 
 @end
 
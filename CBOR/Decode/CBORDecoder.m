@@ -26,281 +26,1140 @@
 #import "CBORDecoder.h"
 #import "CBORConstant.h"
 #import "CBORStream.h"
+#import "CBORDecodeHeader.h"
 #import "CBORNumber.h"
 #import "CBORArray.h"
 #import "CBORMap.h"
 #import "CBORTag.h"
 #import "CBORSimple.h"
+#import "CBORUndefined.h"
+#import "CBORBreak.h"
+#import "CBORInternTable.h"
+#import "CBORUTF8.h"
+#import "CBORTypedArray.h"
 
-/// 次要类型是否是不定长
-static inline bool CBORMinorIsIndefinite(CBORByte minor) {
-    return minor == CBORAdditionalTypeIndefinite;
-}
-
-/// 次要类型是否处于可用数据区间内
-static inline bool CBORMinorIsInValueRange(CBORByte minor) {
-    // 0x00~0x1b
-    return minor >= 0 && minor <= CBORLengthTypeMaxDefined;
+// MARK: - 头部解析
+const CBORInitialByte * CBORInitialByteTable(void) {
+    static CBORInitialByte table[256];
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        for (NSUInteger byte = 0; byte < 256; byte++) {
+            CBORMajorType major = CBORTypeMajor((CBORByte)byte);
+            CBORByte minor = CBORTypeMinor((CBORByte)byte);
+            // 0x1c~0x1e 保留
+            if (minor > CBORLengthTypeMaxDefined && minor != CBORAdditionalTypeIndefinite) { continue; }
+            
+            BOOL indefinite = minor == CBORAdditionalTypeIndefinite;
+            CBORDecodeKind kind = CBORDecodeKindInvalid;
+            switch (major) {
+                case CBORMajorTypeUnsigned:
+                    kind = indefinite ? CBORDecodeKindInvalid : CBORDecodeKindUnsigned; break;
+                case CBORMajorTypeNegative:
+                    kind = indefinite ? CBORDecodeKindInvalid : CBORDecodeKindNegative; break;
+                case CBORMajorTypeBytes:
+                    kind = indefinite ? CBORDecodeKindIndefiniteBytes : CBORDecodeKindBytes; break;
+                case CBORMajorTypeString:
+                    kind = indefinite ? CBORDecodeKindIndefiniteString : CBORDecodeKindString; break;
+                case CBORMajorTypeArray:
+                    kind = indefinite ? CBORDecodeKindIndefiniteArray : CBORDecodeKindArray; break;
+                case CBORMajorTypeMap:
+                    kind = indefinite ? CBORDecodeKindIndefiniteMap : CBORDecodeKindMap; break;
+                case CBORMajorTypeTag:
+                    kind = indefinite ? CBORDecodeKindInvalid : CBORDecodeKindTag; break;
+                case CBORMajorTypeAdditional: {
+                    switch (minor) {
+                        case CBORAdditionalTypeFalse:
+                        case CBORAdditionalTypeTrue:
+                        case CBORAdditionalTypeNull:
+                        case CBORAdditionalTypeUndefined:
+                            kind = CBORDecodeKindSimple; break;
+                        case CBORAdditionalTypeHalf: kind = CBORDecodeKindHalf; break;
+                        case CBORAdditionalTypeFloat: kind = CBORDecodeKindFloat; break;
+                        case CBORAdditionalTypeDouble: kind = CBORDecodeKindDouble; break;
+                        case CBORAdditionalTypeBreak: kind = CBORDecodeKindBreak; break;
+                        default: kind = CBORDecodeKindSimpleValue; break;
+                    }
+                } break;
+                default: break;
+            }
+            
+            table[byte].kind = kind;
+            // 0x18~0x1b 对应后续 1/2/4/8 字节
+            table[byte].argumentLength = (minor > CBORLengthTypeMaxValue && !indefinite) ? (1 << (minor & 0x3)) : 0;
+        }
+    });
+    return table;
 }
 
-
-/// 根据次要类型读取长度或实际值
-static BOOL CBORReadValueOrLength(CBORStream *stream, CBORMinorType minor, CBORUInt64 *value) {
-    if (minor <= CBORLengthTypeMaxValue) {
-        if (value) *value = minor;
-        return YES;
+BOOL CBORDecodeStackPush(CBORDecodeStack *stack, CBORDecodeLimits limits, CBORDecodeFrame frame) {
+    if (limits.maxDepth && stack->depth >= limits.maxDepth) {
+        if (frame.container) CFRelease(frame.container);
+        return NO;
     }
     
-    CBORLengthType type = CBORLengthTypeWithMinor(minor);
-    switch (type) {
-        case CBORLengthTypeUInt8:
-        case CBORLengthTypeUInt16:
-        case CBORLengthTypeUInt32:
-        case CBORLengthTypeUInt64:
-            return [stream popBytes:value length:pow(2, (type & 0x3))];
-        default:
+    if (stack->depth == stack->capacity) {
+        NSUInteger capacity = stack->capacity ? stack->capacity * 2 : 16;
+        CBORDecodeFrame *frames = realloc(stack->frames, capacity * sizeof(CBORDecodeFrame));
+        if (!frames) {
+            if (frame.container) CFRelease(frame.container);
             return NO;
+        }
+        stack->frames = frames;
+        stack->capacity = capacity;
     }
+    
+    stack->frames[stack->depth++] = frame;
+    return YES;
 }
 
-static CBORObject * CBORMapUntilBreak(CBORStream *stream, CBORMajorType major);
-static CBORObject * CBORArrayUntilBreak(CBORStream *stream, CBORMajorType major, BOOL shouldElementEqualToMajor);
+void CBORDecodeStackReset(CBORDecodeStack *stack) {
+    for (NSUInteger index = 0; index < stack->depth; index++) {
+        CBORDecodeFrame *frame = &stack->frames[index];
+        if (frame->container) CFRelease(frame->container);
+        if (frame->key) CFRelease(frame->key);
+    }
+    stack->depth = 0;
+}
+
+void CBORDecodeStackDispose(CBORDecodeStack *stack) {
+    CBORDecodeStackReset(stack);
+    free(stack->frames);
+    stack->frames = NULL;
+    stack->capacity = 0;
+}
 
+/// 缓存的小整数数量
+#define CBORCachedNumberCount 256
+
+NSNumber * CBORDecodeUnsignedNumber(UInt64 value) {
+    static NSNumber *numbers[CBORCachedNumberCount];
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        for (UInt64 index = 0; index < CBORCachedNumberCount; index++) {
+            numbers[index] = @(index);
+        }
+    });
+    
+    return value < CBORCachedNumberCount ? numbers[value] : @(value);
+}
 
-/// 数据转CBOR
-static CBORObject * CBORDecodeData(CBORStream *stream) {
-    CBORByte byte = 0;
-    if (![stream popUInt8:&byte]) { return nil; }
+NSNumber * CBORDecodeNegativeNumber(UInt64 argument) {
+    static NSNumber *numbers[CBORCachedNumberCount];
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        for (UInt64 index = 0; index < CBORCachedNumberCount; index++) {
+            numbers[index] = @((SInt64)(-(index + 1)));
+        }
+    });
     
-    CBORMajorType majorType = CBORTypeMajor(byte);
-    CBORByte minorType = CBORTypeMinor(byte);
+    return argument < CBORCachedNumberCount ? numbers[argument] : @((SInt64)(-(argument + 1)));
+}
+
+
+/// 数据转CBOR（循环解码）
+static CBORObject * CBORDecodeData(CBORStream *stream, CBORDecodeLimits limits, CBORDecodeStack *stack) {
+    const CBORInitialByte *table = CBORInitialByteTable();
+    CBORCursor *cursor = [stream cursor];
+    NSUInteger items = 0;
     
-    switch (majorType) {
-            // 非负整数，负整数
-        case CBORMajorTypeUnsigned:
-        case CBORMajorTypeNegative: {
-            if (!CBORMinorIsInValueRange(minorType)) { return nil; }
-            
-            CBORUInt64 value;
-            if (!CBORReadValueOrLength(stream, minorType, &value)) { return nil; }
-            
-            return [[CBORNumber alloc] initWithMajor:majorType
-                                               minor:minorType
-                                       unsignedValue:value];
+    do {
+        CBORDecodeHeader header;
+        if (!CBORDecodeReadHeader(cursor, table, stack, limits, &items, &header)) { return nil; }
+        
+        CBORInitialByte entry = header.entry;
+        CBORMajorType majorType = header.major;
+        CBORByte minorType = header.minor;
+        CBORUInt64 argument = header.argument;
+        CBORDecodeFrame *top = stack->depth ? &stack->frames[stack->depth - 1] : NULL;
+        
+        CBORObject *item = nil;
+        switch (entry.kind) {
+                // 非负整数，负整数
+            case CBORDecodeKindUnsigned:
+            case CBORDecodeKindNegative:
+                // 0~23与-1~-24为共享实例
+                item = [CBORNumber numberWithMajor:majorType
+                                             minor:minorType
+                                     unsignedValue:argument];
+                break;
+                
+                // 字节数组 & UTF8字符串
+            case CBORDecodeKindBytes:
+            case CBORDecodeKindString: {
+                NSData *value;
+                if (![stream popDataWithLength:(NSUInteger)argument data:&value]) { return nil; }
+                if (!value) { return nil; }
+                
+                item = [[CBORArray alloc] initWithMajor:majorType
+                                                  minor:minorType
+                                                  value:value];
+            } break;
+                
+                // 不定长：子元素直接加入容器，无需中间数组
+            case CBORDecodeKindIndefiniteBytes:
+            case CBORDecodeKindIndefiniteString:
+            case CBORDecodeKindIndefiniteArray: {
+                CBORDecodeFrame frame = { entry.kind, CFBridgingRetain([[CBORArray alloc] initWithMajor:majorType]), NULL, 0, 0 };
+                if (!CBORDecodeStackPush(stack, limits, frame)) { return nil; }
+            } continue;
+                
+                // 数组
+            case CBORDecodeKindArray: {
+                // 每个子元素至少占用1字节，声明数量超出剩余数据时提前拒绝
+                if (argument > CBORCursorRemaining(cursor)) { return nil; }
+                
+                CBORArray *array = [[CBORArray alloc] initWithMajor:majorType minor:minorType];
+                if (!argument) {
+                    item = array;
+                    break;
+                }
+                
+                CBORDecodeFrame frame = { entry.kind, CFBridgingRetain(array), NULL, argument, 0 };
+                if (!CBORDecodeStackPush(stack, limits, frame)) { return nil; }
+            } continue;
+                
+                // 键值对
+            case CBORDecodeKindMap: {
+                if (argument > CBORCursorRemaining(cursor) / 2) { return nil; }
+                
+                CBORMap *map = [[CBORMap alloc] initWithMajor:majorType minor:minorType];
+                if (!argument) {
+                    item = map;
+                    break;
+                }
+                
+                CBORDecodeFrame frame = { entry.kind, CFBridgingRetain(map), NULL, argument * 2, 0 };
+                if (!CBORDecodeStackPush(stack, limits, frame)) { return nil; }
+            } continue;
+                
+            case CBORDecodeKindIndefiniteMap: {
+                CBORDecodeFrame frame = { entry.kind, CFBridgingRetain([[CBORMap alloc] initWithMajor:majorType]), NULL, 0, 0 };
+                if (!CBORDecodeStackPush(stack, limits, frame)) { return nil; }
+            } continue;
+                
+                // 扩展类型：等待唯一的子元素
+            case CBORDecodeKindTag: {
+                CBORDecodeFrame frame = { entry.kind, NULL, NULL, 1, argument };
+                if (!CBORDecodeStackPush(stack, limits, frame)) { return nil; }
+            } continue;
+                
+                // 浮点数
+            case CBORDecodeKindHalf:
+                // 解码时的值需要转化，所以传无符号整数进一步内部转化为半精度
+                item = [[CBORNumber alloc] initWithMajor:majorType
+                                                   minor:minorType
+                                           unsignedValue:argument];
+                break;
+            case CBORDecodeKindFloat: {
+                UInt32 raw = (UInt32)argument;
+                Float32 value = 0;
+                memcpy(&value, &raw, sizeof(value));
+                
+                item = [[CBORNumber alloc] initWithMajor:majorType
+                                                   minor:minorType
+                                              floatValue:value];
+            } break;
+            case CBORDecodeKindDouble: {
+                Float64 value = 0;
+                memcpy(&value, &argument, sizeof(value));
+                
+                item = [[CBORNumber alloc] initWithMajor:majorType
+                                                   minor:minorType
+                                              floatValue:value];
+            } break;
+                
+                // 简单类型
+            case CBORDecodeKindSimple:
+                item = [CBORSimple simpleWithMinor:minorType];
+                break;
+                
+                // 简单值
+            case CBORDecodeKindSimpleValue:
+                // 是否处于简单值区间
+                if (!CBORIsSimpleValue(argument)) { return nil; }
+                
+                item = [[CBORNumber alloc] initWithMajor:majorType
+                                                   minor:minorType
+                                           unsignedValue:argument];
+                break;
+                
+                // 终止符
+            case CBORDecodeKindBreak: {
+                // 顶层终止符按简单类型返回
+                if (!top) {
+                    item = [CBORSimple cborBreak];
+                    break;
+                }
+                
+                // 只能结束不定长容器，且键值对不能终止于键与值之间
+                if (!CBORDecodeKindIsIndefinite(top->kind) || top->key) { return nil; }
+                
+                item = CFBridgingRelease(top->container);
+                stack->depth--;
+            } break;
+                
+            default:
+                return nil;
         }
         
-            // 字节数组 & UTF8字符串
-        case CBORMajorTypeBytes:
-        case CBORMajorTypeString: {
-            // 不定长
-            if (CBORMinorIsIndefinite(minorType)) {
-                return CBORArrayUntilBreak(stream, majorType, YES);
-            }
+        // 完成的元素逐层归入父容器，父容器完整时继续向上
+        while (item) {
+            if (!stack->depth) { return item; }
             
-            if (!CBORMinorIsInValueRange(minorType)) { return nil; }
-            
-            CBORUInt64 length;
-            if (!CBORReadValueOrLength(stream, minorType, &length)) { return nil; }
-            
-            NSData *value;
-            if (![stream popDataWithLength:length data:&value]) { return nil; }
-            if (!value) { return nil; }
-            
-            return [[CBORArray alloc] initWithMajor:majorType
-                                              minor:minorType
-                                              value:value];
-        }
-            // 数组
-        case CBORMajorTypeArray: {
-            // 不定长
-            if (CBORMinorIsIndefinite(minorType)) {
-                return CBORArrayUntilBreak(stream, majorType, NO);
+            top = &stack->frames[stack->depth - 1];
+            switch (top->kind) {
+                case CBORDecodeKindTag:
+                    item = [[CBORTag alloc] initWithMajor:CBORMajorTypeTag
+                                                      tag:top->tag
+                                                    value:item];
+                    stack->depth--;
+                    continue;
+                    
+                case CBORDecodeKindMap:
+                case CBORDecodeKindIndefiniteMap:
+                    if (!top->key) {
+                        top->key = CFBridgingRetain(item);
+                    } else {
+                        CBORMap *map = (__bridge CBORMap *)top->container;
+                        CBORMapSetEntry(map, (__bridge CBORObject *)top->key, item, CBORMapDuplicateKeyPolicyLastWins);
+                        CFRelease(top->key);
+                        top->key = NULL;
+                    }
+                    break;
+                    
+                default:
+                    CBORArrayAppend((__bridge CBORArray *)top->container, item);
+                    break;
             }
             
-            if (!CBORMinorIsInValueRange(minorType)) { return nil; }
-            
-            CBORUInt64 length;
-            if (!CBORReadValueOrLength(stream, minorType, &length)) { return nil; }
-            
-            CBORArray *ret = [[CBORArray alloc] initWithMajor:majorType
-                                                        minor:minorType];
-            
-            for (UInt64 index = 0; index < length; index++) {
-                CBORObject *cbor = CBORDecodeData(stream);
-                
-                if (!cbor) { return nil; }
-                [ret addCBOR:cbor];
+            if (CBORDecodeKindIsIndefinite(top->kind) || --top->remaining) {
+                item = nil;
+            } else {
+                item = CFBridgingRelease(top->container);
+                stack->depth--;
             }
+        }
+    } while (YES);
+}
+
+
+/// 缺省值：原生对象无法表示的元素（如非法UTF8字符串），键值对中对应项被忽略
+static id CBORDecodeAbsent(void) {
+    static id absent = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        absent = [NSObject new];
+    });
+    return absent;
+}
+
+/// 扩展类型转原生对象，与`-[CBORTag nsObject]`一致
+static id CBORDecodeTagObject(CBORTagType tag, id value, id absent) {
+    if (value == absent) { return absent; }
+    
+    switch (tag) {
+        case CBORTagTypeBase64:
+        case CBORTagTypeBase64URL: {
+            if (![value isKindOfClass:[NSString class]]) { return absent; }
             
-            return ret;
+            // Base64解码
+            NSData *data = [[NSData alloc] initWithBase64EncodedString:value options:NSDataBase64DecodingIgnoreUnknownCharacters];
+            if (!data) { return absent; }
+            return [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding] ?: absent;
         }
-            // 键值对
-        case CBORMajorTypeMap: {
-            // 不定长
-            if (CBORMinorIsIndefinite(minorType)) {
-                return CBORMapUntilBreak(stream, majorType);
+        default:
+            // 类型化数组：元素长度不整齐时无法表示
+            if ([CBORTypedArray isTypedArrayTag:tag] && [value isKindOfClass:[NSData class]]) {
+                return [CBORTypedArray typedArrayWithTag:tag data:value] ?: absent;
             }
-            
-            if (!CBORMinorIsInValueRange(minorType)) { return nil; }
-            
-            CBORUInt64 length = 0;
-            if (!CBORReadValueOrLength(stream, minorType, &length)) { return nil; }
-            
-            CBORMap *ret = [[CBORMap alloc] initWithMajor:majorType minor:minorType];
-            
-            for (CBORUInt64 index = 0; index < length; index++) {
-                CBORObject *key = CBORDecodeData(stream);
-                if (!key) { return nil; }
+            return value;
+    }
+}
+
+/// 字符串引用命名空间内的定长字符串按出现顺序编入字符串表，规则与编码一致
+static inline void CBORDecodeAddStringReference(NSMutableArray *strings, id item, CBORUInt64 length) {
+    if (strings && length >= CBORStringReferenceMinLength([strings count])) { [strings addObject:item]; }
+}
+
+/// 数据直接转原生对象（循环解码），不构建CBOR对象树，结果与`-[CBORObject nsObject]`一致
+///
+/// 字符串引用（tag 256/25）在此解析为字符串表中的同一实例
+static id CBORDecodeObject(CBORStream *stream, CBORDecodeLimits limits, CBORDecodeStack *stack) {
+    const CBORInitialByte *table = CBORInitialByteTable();
+    CBORCursor *cursor = [stream cursor];
+    CBORInternTable *interns = [stream internTable];
+    id absent = CBORDecodeAbsent();
+    NSUInteger items = 0;
+    // 当前命名空间的字符串表，外层的表保存在命名空间标记的帧中
+    NSMutableArray *strings = nil;
+    
+    do {
+        CBORDecodeHeader header;
+        if (!CBORDecodeReadHeader(cursor, table, stack, limits, &items, &header)) { return nil; }
+        
+        CBORInitialByte entry = header.entry;
+        CBORUInt64 argument = header.argument;
+        CBORDecodeFrame *top = stack->depth ? &stack->frames[stack->depth - 1] : NULL;
+        
+        id item = nil;
+        switch (entry.kind) {
+                // 非负整数，负整数
+            case CBORDecodeKindUnsigned:
+                item = CBORDecodeUnsignedNumber(argument);
+                break;
+            case CBORDecodeKindNegative:
+                item = CBORDecodeNegativeNumber(argument);
+                break;
                 
-                CBORObject *value = CBORDecodeData(stream);
+                // 字节数组
+            case CBORDecodeKindBytes: {
+                NSData *value;
+                if (![stream popDataWithLength:argument data:&value]) { return nil; }
                 if (!value) { return nil; }
                 
-                ret[key] = value;
-            }
-            
-            return ret;
+                item = value;
+                if (!top || top->kind != CBORDecodeKindIndefiniteBytes) { CBORDecodeAddStringReference(strings, item, argument); }
+            } break;
+                
+                // UTF8字符串
+            case CBORDecodeKindString: {
+                const UInt8 *bytes = NULL;
+                if (!CBORCursorReadBytes(cursor, argument, &bytes)) { return nil; }
+                
+                // 不定长字符串的分段逐一校验后拼接原始字节，终止时只构建一次字符串；
+                // 分段非法时释放已拼接的字节，后续分段只读取不拼接
+                if (top && top->kind == CBORDecodeKindIndefiniteString) {
+                    if (!top->container) { continue; }
+                    if (!CBORUTF8Validate(bytes, argument, NULL)) {
+                        CFRelease(top->container);
+                        top->container = NULL;
+                        continue;
+                    }
+                    [(__bridge NSMutableData *)top->container appendBytes:bytes length:argument];
+                    continue;
+                }
+                
+                // 键值对的键在同类数据中反复出现，驻留为同一实例
+                if (top && (top->kind == CBORDecodeKindMap || top->kind == CBORDecodeKindIndefiniteMap) && !top->key) {
+                    if (!interns) {
+                        interns = [CBORInternTable new];
+                        [stream setInternTable:interns];
+                    }
+                    item = [interns stringWithUTF8Bytes:bytes length:argument] ?: absent;
+                } else {
+                    item = [stream stringWithBytes:bytes length:argument] ?: absent;
+                }
+                CBORDecodeAddStringReference(strings, item, argument);
+            } break;
+                
+                // 不定长
+            case CBORDecodeKindIndefiniteBytes:
+            case CBORDecodeKindIndefiniteString:
+            case CBORDecodeKindIndefiniteArray:
+            case CBORDecodeKindIndefiniteMap: {
+                id container = nil;
+                switch (entry.kind) {
+                    case CBORDecodeKindIndefiniteBytes:
+                    case CBORDecodeKindIndefiniteString: container = [NSMutableData data]; break;
+                    case CBORDecodeKindIndefiniteArray: container = [NSMutableArray array]; break;
+                    default: container = [NSMutableDictionary dictionary]; break;
+                }
+                
+                CBORDecodeFrame frame = { entry.kind, CFBridgingRetain(container), NULL, 0, 0 };
+                if (!CBORDecodeStackPush(stack, limits, frame)) { return nil; }
+            } continue;
+                
+                // 数组
+            case CBORDecodeKindArray: {
+                // 每个子元素至少占用1字节，声明数量超出剩余数据时提前拒绝
+                if (argument > CBORCursorRemaining(cursor)) { return nil; }
+                if (!argument) {
+                    item = [NSMutableArray array];
+                    break;
+                }
+                
+                CBORDecodeFrame frame = { entry.kind, CFBridgingRetain([NSMutableArray arrayWithCapacity:(NSUInteger)argument]), NULL, argument, 0 };
+                if (!CBORDecodeStackPush(stack, limits, frame)) { return nil; }
+            } continue;
+                
+                // 键值对
+            case CBORDecodeKindMap: {
+                if (argument > CBORCursorRemaining(cursor) / 2) { return nil; }
+                if (!argument) {
+                    item = [NSMutableDictionary dictionary];
+                    break;
+                }
+                
+                CBORDecodeFrame frame = { entry.kind, CFBridgingRetain([NSMutableDictionary dictionaryWithCapacity:(NSUInteger)argument]), NULL, argument * 2, 0 };
+                if (!CBORDecodeStackPush(stack, limits, frame)) { return nil; }
+            } continue;
+                
+                // 扩展类型：等待唯一的子元素
+            case CBORDecodeKindTag: {
+                CBORDecodeFrame frame = { entry.kind, NULL, NULL, 1, argument };
+                BOOL namespace = argument == CBORTagTypeStringReferenceNamespace;
+                if (namespace && strings) { frame.container = CFBridgingRetain(strings); }
+                if (!CBORDecodeStackPush(stack, limits, frame)) { return nil; }
+                if (namespace) { strings = [NSMutableArray array]; }
+            } continue;
+                
+                // 浮点数
+            case CBORDecodeKindHalf:
+                item = @((Float64)uint16_to_float((uint16_t)argument));
+                break;
+            case CBORDecodeKindFloat: {
+                UInt32 raw = (UInt32)argument;
+                Float32 value = 0;
+                memcpy(&value, &raw, sizeof(value));
+                
+                item = @((Float64)value);
+            } break;
+            case CBORDecodeKindDouble: {
+                Float64 value = 0;
+                memcpy(&value, &argument, sizeof(value));
+                
+                item = @(value);
+            } break;
+                
+                // 简单类型
+            case CBORDecodeKindSimple: {
+                switch (header.minor) {
+                    case CBORAdditionalTypeTrue: item = @(YES); break;
+                    case CBORAdditionalTypeFalse: item = @(NO); break;
+                    case CBORAdditionalTypeNull: item = [NSNull null]; break;
+                    default: item = [CBORUndefined new]; break;
+                }
+            } break;
+                
+                // 简单值
+            case CBORDecodeKindSimpleValue:
+                if (!CBORIsSimpleValue(argument)) { return nil; }
+                
+                item = CBORDecodeUnsignedNumber(argument);
+                break;
+                
+                // 终止符
+            case CBORDecodeKindBreak: {
+                if (!top) {
+                    item = [CBORBreak new];
+                    break;
+                }
+                
+                if (!CBORDecodeKindIsIndefinite(top->kind) || top->key) { return nil; }
+                
+                item = CFBridgingRelease(top->container);
+                stack->depth--;
+                // 分段均已校验，拼接后的字节必然合法；存在非法分段时与定长字符串一致视为无法表示
+                if (top->kind == CBORDecodeKindIndefiniteString) {
+                    NSData *joined = item;
+                    item = joined ? CBORUTF8String([joined bytes], [joined length], YES) : absent;
+                }
+            } break;
+                
+            default:
+                return nil;
         }
-            // 扩展类型
-        case CBORMajorTypeTag: {
-            if (!CBORMinorIsInValueRange(minorType)) { return nil; }
-            
-            CBORTagType tag;
-            if (!CBORReadValueOrLength(stream, minorType, &tag)) { return nil; }
-            
-            CBORObject *value = CBORDecodeData(stream);
-            
-            if (!value) { return nil; }
+        
+        // 完成的元素逐层归入父容器，父容器完整时继续向上
+        while (item) {
+            if (!stack->depth) { return item == absent ? nil : item; }
             
-            return [[CBORTag alloc] initWithMajor:majorType
-                                              tag:tag
-                                            value:value];
-        }
-            // 浮点数或简单类型
-        case CBORMajorTypeAdditional: {
-            switch (minorType) {
-                case CBORAdditionalTypeHalf: {
-                    Float16 value = 0;
-                    if (![stream popFloat16:&value]) { return nil; }
+            top = &stack->frames[stack->depth - 1];
+            switch (top->kind) {
+                case CBORDecodeKindTag:
+                    if (top->tag == CBORTagTypeStringReferenceNamespace) {
+                        strings = top->container ? CFBridgingRelease(top->container) : nil;
+                        top->container = NULL;
+                    } else if (top->tag == CBORTagTypeStringReference && strings) {
+                        // 引用须为字符串表中已有的下标
+                        if (![item isKindOfClass:[NSNumber class]] || [(NSNumber *)item unsignedLongLongValue] >= [strings count] || [(NSNumber *)item compare:@0] == NSOrderedAscending) { return nil; }
+                        item = strings[[(NSNumber *)item unsignedIntegerValue]];
+                        stack->depth--;
+                        continue;
+                    }
+                    item = CBORDecodeTagObject(top->tag, item, absent);
+                    stack->depth--;
+                    continue;
                     
-                    // 解码时的值需要转化，所以传无符号整数进一步内部转化为半精度
-                    return [[CBORNumber alloc] initWithMajor:majorType
-                                                       minor:minorType
-                                               unsignedValue:value];
-                }
-                case CBORAdditionalTypeFloat: {
-                    Float32 value = 0;
-                    if (![stream popFloat32:&value]) { return nil; }
+                case CBORDecodeKindMap:
+                case CBORDecodeKindIndefiniteMap: {
+                    if (!top->key) {
+                        top->key = CFBridgingRetain(item);
+                        break;
+                    }
                     
-                    return [[CBORNumber alloc] initWithMajor:majorType
-                                                       minor:minorType
-                                                  floatValue:value];
-                }
-                case CBORAdditionalTypeDouble: {
-                    Float64 value = 0;
-                    if (![stream popFloat64:&value]) { return nil; }
+                    id key = CFBridgingRelease(top->key);
+                    top->key = NULL;
+                    // 无法表示的键或值忽略该项
+                    if (key == absent || item == absent) { break; }
                     
-                    return [[CBORNumber alloc] initWithMajor:majorType
-                                                       minor:minorType
-                                                  floatValue:value];
-                }
-                case CBORAdditionalTypeBreak:
-                case CBORAdditionalTypeNull:
-                case CBORAdditionalTypeFalse:
-                case CBORAdditionalTypeTrue:
-                case CBORAdditionalTypeUndefined:
-                    return  [[CBORSimple alloc] initWithMajor:majorType
-                                                        minor:minorType];
-                default: {
-                    // 简单值
-                    CBORUInt64 value;
-                    if (!CBORReadValueOrLength(stream, minorType, &value)) { return nil; }
-                    // 是否处于简单值区间
-                    if (!CBORIsSimpleValue(value)) { return nil; }
+                    NSMutableDictionary *dictionary = (__bridge NSMutableDictionary *)top->container;
+                    if ([key conformsToProtocol:@protocol(NSCopying)]) {
+                        dictionary[key] = item;
+                    } else {
+                        dictionary[[NSString stringWithFormat:@"%@", key]] = item;
+                    }
+                } break;
                     
-                    return [[CBORNumber alloc] initWithMajor:majorType
-                                                       minor:minorType
-                                               unsignedValue:value];
-                    
-                }
+                case CBORDecodeKindIndefiniteBytes:
+                    [(__bridge NSMutableData *)top->container appendData:item];
+                    break;
                     
+                default:
+                    if (item == absent) { return nil; }
+                    [(__bridge NSMutableArray *)top->container addObject:item];
+                    break;
+            }
+            
+            if (CBORDecodeKindIsIndefinite(top->kind) || --top->remaining) {
+                item = nil;
+            } else {
+                item = CFBridgingRelease(top->container);
+                stack->depth--;
             }
         }
+    } while (YES);
+}
+
+
+/// 代理已实现的事件，解码前查询一次
+typedef struct {
+    unsigned int beginArray : 1;
+    unsigned int endArray : 1;
+    unsigned int beginMap : 1;
+    unsigned int endMap : 1;
+    unsigned int unsignedValue : 1;
+    unsigned int negativeValue : 1;
+    unsigned int floatValue : 1;
+    unsigned int simpleValue : 1;
+    unsigned int tag : 1;
+    unsigned int bytes : 1;
+    unsigned int string : 1;
+    unsigned int beginChunkedBytes : 1;
+    unsigned int endChunkedBytes : 1;
+    unsigned int beginChunkedString : 1;
+    unsigned int endChunkedString : 1;
+} CBORDecoderDelegateFlags;
+
+static CBORDecoderDelegateFlags CBORDecoderDelegateFlagsMake(id<CBORDecoderDelegate> delegate) {
+    CBORDecoderDelegateFlags flags;
+    flags.beginArray = [delegate respondsToSelector:@selector(decoderDidBeginArray:)];
+    flags.endArray = [delegate respondsToSelector:@selector(decoderDidEndArray)];
+    flags.beginMap = [delegate respondsToSelector:@selector(decoderDidBeginMap:)];
+    flags.endMap = [delegate respondsToSelector:@selector(decoderDidEndMap)];
+    flags.unsignedValue = [delegate respondsToSelector:@selector(decoderDidReadUnsigned:)];
+    flags.negativeValue = [delegate respondsToSelector:@selector(decoderDidReadNegative:)];
+    flags.floatValue = [delegate respondsToSelector:@selector(decoderDidReadFloat:)];
+    flags.simpleValue = [delegate respondsToSelector:@selector(decoderDidReadSimple:)];
+    flags.tag = [delegate respondsToSelector:@selector(decoderDidReadTag:)];
+    flags.bytes = [delegate respondsToSelector:@selector(decoderDidReadBytes:length:)];
+    flags.string = [delegate respondsToSelector:@selector(decoderDidReadString:length:)];
+    flags.beginChunkedBytes = [delegate respondsToSelector:@selector(decoderDidBeginChunkedBytes)];
+    flags.endChunkedBytes = [delegate respondsToSelector:@selector(decoderDidEndChunkedBytes)];
+    flags.beginChunkedString = [delegate respondsToSelector:@selector(decoderDidBeginChunkedString)];
+    flags.endChunkedString = [delegate respondsToSelector:@selector(decoderDidEndChunkedString)];
+    return flags;
+}
+
+/// 容器结束事件
+static inline CBORDecodeAction CBORDecodeEndEvent(id<CBORDecoderDelegate> delegate, CBORDecoderDelegateFlags flags, CBORDecodeKind kind) {
+    switch (kind) {
+        case CBORDecodeKindArray:
+        case CBORDecodeKindIndefiniteArray:
+            return flags.endArray ? [delegate decoderDidEndArray] : CBORDecodeActionContinue;
+        case CBORDecodeKindMap:
+        case CBORDecodeKindIndefiniteMap:
+            return flags.endMap ? [delegate decoderDidEndMap] : CBORDecodeActionContinue;
+        case CBORDecodeKindIndefiniteBytes:
+            return flags.endChunkedBytes ? [delegate decoderDidEndChunkedBytes] : CBORDecodeActionContinue;
+        case CBORDecodeKindIndefiniteString:
+            return flags.endChunkedString ? [delegate decoderDidEndChunkedString] : CBORDecodeActionContinue;
         default:
-            return nil;
+            return CBORDecodeActionContinue;
     }
-    return nil;
 }
 
-/// 读取不定长
-static NSArray * CBORObjectsUntilBreak(CBORStream *stream) {
-    NSMutableArray *ret = [NSMutableArray array];
-    CBORObject *cbor;
+/// 数据转事件（循环解码），与对象解码共用头部解析与校验
+///
+/// 只校验结构：字符串不校验UTF8（对象解码将其作为无法表示的元素，不影响结构）；
+/// 单独的终止符不是数据项，顶层与定长容器内的终止符均不合法
+/// - Returns: 数据合法（或被代理提前停止）时返回YES
+static BOOL CBORDecodeEvents(CBORCursor *cursor, id<CBORDecoderDelegate> delegate, CBORDecodeLimits limits, CBORDecodeStack *stack) {
+    const CBORInitialByte *table = CBORInitialByteTable();
+    CBORDecoderDelegateFlags flags = CBORDecoderDelegateFlagsMake(delegate);
+    NSUInteger items = 0;
+    // 被跳过容器的深度（入栈后），此深度及以下不回调事件；0表示未跳过
+    NSUInteger skipDepth = 0;
     
     do {
-        cbor = CBORDecodeData(stream);
+        CBORDecodeHeader header;
+        if (!CBORDecodeReadHeader(cursor, table, stack, limits, &items, &header)) { return NO; }
         
-        if (!cbor) { return nil; }
-        if ([cbor isBreak]) { break; }
+        CBORDecodeKind kind = header.entry.kind;
+        CBORUInt64 argument = header.argument;
+        BOOL report = !skipDepth;
+        CBORDecodeAction action = CBORDecodeActionContinue;
+        // 容器入栈时的子元素数量（定长为剩余数量，不定长为已读数量）
+        UInt64 remaining = 0;
         
-        [ret addObject:cbor];
+        switch (kind) {
+                // 非负整数，负整数
+            case CBORDecodeKindUnsigned:
+                if (report && flags.unsignedValue) { action = [delegate decoderDidReadUnsigned:argument]; }
+                break;
+            case CBORDecodeKindNegative:
+                if (report && flags.negativeValue) { action = [delegate decoderDidReadNegative:argument]; }
+                break;
+                
+                // 字节数组 & UTF8字符串
+            case CBORDecodeKindBytes:
+            case CBORDecodeKindString: {
+                const UInt8 *bytes = NULL;
+                if (!CBORCursorReadBytes(cursor, argument, &bytes)) { return NO; }
+                if (!report) { break; }
+                
+                if (kind == CBORDecodeKindBytes) {
+                    if (flags.bytes) { action = [delegate decoderDidReadBytes:bytes length:argument]; }
+                } else {
+                    if (flags.string) { action = [delegate decoderDidReadString:bytes length:argument]; }
+                }
+            } break;
+                
+                // 容器
+            case CBORDecodeKindArray:
+                if (argument > CBORCursorRemaining(cursor)) { return NO; }
+                if (report && flags.beginArray) { action = [delegate decoderDidBeginArray:argument]; }
+                remaining = argument;
+                break;
+            case CBORDecodeKindIndefiniteArray:
+                if (report && flags.beginArray) { action = [delegate decoderDidBeginArray:CBORIndefiniteCount]; }
+                break;
+            case CBORDecodeKindMap:
+                if (argument > CBORCursorRemaining(cursor) / 2) { return NO; }
+                if (report && flags.beginMap) { action = [delegate decoderDidBeginMap:argument]; }
+                remaining = argument * 2;
+                break;
+            case CBORDecodeKindIndefiniteMap:
+                if (report && flags.beginMap) { action = [delegate decoderDidBeginMap:CBORIndefiniteCount]; }
+                break;
+            case CBORDecodeKindIndefiniteBytes:
+                if (report && flags.beginChunkedBytes) { action = [delegate decoderDidBeginChunkedBytes]; }
+                break;
+            case CBORDecodeKindIndefiniteString:
+                if (report && flags.beginChunkedString) { action = [delegate decoderDidBeginChunkedString]; }
+                break;
+            case CBORDecodeKindTag:
+                if (report && flags.tag) { action = [delegate decoderDidReadTag:argument]; }
+                remaining = 1;
+                break;
+                
+                // 浮点数
+            case CBORDecodeKindHalf:
+                if (report && flags.floatValue) { action = [delegate decoderDidReadFloat:uint16_to_float((uint16_t)argument)]; }
+                break;
+            case CBORDecodeKindFloat: {
+                if (!report || !flags.floatValue) { break; }
+                
+                UInt32 raw = (UInt32)argument;
+                Float32 value = 0;
+                memcpy(&value, &raw, sizeof(value));
+                action = [delegate decoderDidReadFloat:value];
+            } break;
+            case CBORDecodeKindDouble: {
+                if (!report || !flags.floatValue) { break; }
+                
+                Float64 value = 0;
+                memcpy(&value, &argument, sizeof(value));
+                action = [delegate decoderDidReadFloat:value];
+            } break;
+                
+                // 简单类型
+            case CBORDecodeKindSimple:
+                if (report && flags.simpleValue) { action = [delegate decoderDidReadSimple:header.minor]; }
+                break;
+                
+                // 简单值
+            case CBORDecodeKindSimpleValue:
+                if (!CBORIsSimpleValue(argument)) { return NO; }
+                if (report && flags.simpleValue) { action = [delegate decoderDidReadSimple:(UInt8)argument]; }
+                break;
+                
+                // 终止符
+            case CBORDecodeKindBreak: {
+                if (!stack->depth) { return NO; }
+                
+                // 只能结束不定长容器，且键值对不能终止于键与值之间
+                CBORDecodeFrame *top = &stack->frames[stack->depth - 1];
+                if (!CBORDecodeKindIsIndefinite(top->kind)) { return NO; }
+                if (top->kind == CBORDecodeKindIndefiniteMap && (top->remaining & 1)) { return NO; }
+            } break;
+                
+            default:
+                return NO;
+        }
         
+        if (action == CBORDecodeActionStop) { return YES; }
+        
+        // 容器入栈，空的定长容器直接完成
+        BOOL isContainer = kind == CBORDecodeKindTag || CBORDecodeKindIsIndefinite(kind)
+                        || ((kind == CBORDecodeKindArray || kind == CBORDecodeKindMap) && remaining);
+        if (isContainer) {
+            CBORDecodeFrame frame = { kind, NULL, NULL, remaining, argument };
+            if (!CBORDecodeStackPush(stack, limits, frame)) { return NO; }
+            if (report && action == CBORDecodeActionSkip) { skipDepth = stack->depth; }
+            continue;
+        }
+        if (report && action != CBORDecodeActionSkip && (kind == CBORDecodeKindArray || kind == CBORDecodeKindMap)) {
+            if (CBORDecodeEndEvent(delegate, flags, kind) == CBORDecodeActionStop) { return YES; }
+        }
+        
+        // 终止符结束当前容器，随后作为完成的元素计入父容器
+        BOOL pop = kind == CBORDecodeKindBreak && stack->depth;
+        do {
+            if (pop) {
+                CBORDecodeKind popped = stack->frames[stack->depth - 1].kind;
+                BOOL skipped = skipDepth && stack->depth >= skipDepth;
+                stack->depth--;
+                if (skipDepth > stack->depth) { skipDepth = 0; }
+                
+                if (!skipped && CBORDecodeEndEvent(delegate, flags, popped) == CBORDecodeActionStop) { return YES; }
+            }
+            if (!stack->depth) { return YES; }
+            
+            CBORDecodeFrame *top = &stack->frames[stack->depth - 1];
+            if (CBORDecodeKindIsIndefinite(top->kind)) {
+                top->remaining++;
+                pop = NO;
+            } else {
+                pop = !--top->remaining;
+            }
+        } while (pop);
     } while (YES);
-    
-    return ret;
 }
 
-/// 读取不定长键值对
-/// - Parameters:
-///   - stream: 输入流
-///   - major: 主要类型
-static CBORObject * CBORMapUntilBreak(CBORStream *stream, CBORMajorType major) {
-    CBORMap *ret = [[CBORMap alloc] initWithMajor:major];
+
+/// 跳过一个元素：仅扫描头部，字节数组/字符串按长度直接跳过，同样校验数据合法性
+static inline BOOL CBORDecodeSkip(CBORCursor *cursor, CBORDecodeLimits limits, CBORDecodeStack *stack) {
+    return CBORDecodeEvents(cursor, nil, limits, stack);
+}
+
+id CBORDecodeObjectAtCursor(CBORStream *stream, CBORDecodeLimits limits, CBORDecodeStack *stack) {
+    return CBORDecodeObject(stream, limits, stack);
+}
+
+BOOL CBORDecodeSkipAtCursor(CBORCursor *cursor, CBORDecodeLimits limits, CBORDecodeStack *stack) {
+    return CBORDecodeSkip(cursor, limits, stack);
+}
+
+/// 路径中的键
+typedef struct {
+    /// 路径组件（NSString/NSNumber...）
+    __unsafe_unretained id component;
+    /// 字符串组件的UTF8字节，用于与定长字符串键直接比较
+    const char *utf8;
+    NSUInteger utf8Length;
+} CBORDecodePathKey;
+
+/// 读取键值对的键并与路径组件比较，游标停在值的起始位置
+static BOOL CBORDecodeMatchKey(CBORStream *stream, CBORDecodePathKey key, CBORDecodeLimits limits, CBORDecodeStack *stack, BOOL *match) {
+    CBORCursor *cursor = [stream cursor];
+    NSUInteger start = cursor->index;
     
-    CBORObject *key;
-    CBORObject *value;
+    // 字符串键直接比较字节，不构建对象
+    if (key.utf8) {
+        NSUInteger items = 0;
+        CBORDecodeHeader header;
+        if (!CBORDecodeReadHeader(cursor, CBORInitialByteTable(), stack, limits, &items, &header)) { return NO; }
+        
+        if (header.entry.kind == CBORDecodeKindString) {
+            const UInt8 *bytes = NULL;
+            if (!CBORCursorReadBytes(cursor, header.argument, &bytes)) { return NO; }
+            
+            *match = header.argument == key.utf8Length && memcmp(bytes, key.utf8, key.utf8Length) == 0;
+            return YES;
+        }
+        cursor->index = start;
+    }
     
-    do {
-        key = CBORDecodeData(stream);
-        if (!key) { return nil; }
-        // Key识别终止则不定长结束循环
-        if ([key isBreak]) { break; }
+    // 其他类型的键解码后比较
+    id object = CBORDecodeObject(stream, limits, stack);
+    if (!object) { return NO; }
+    
+    *match = [object isEqual:key.component];
+    return YES;
+}
+
+/// 按路径定位元素，游标停在目标元素的起始位置；途经的兄弟元素仅做扫描跳过
+static BOOL CBORDecodeSeekPath(CBORStream *stream, NSArray *path, CBORDecodeLimits limits, CBORDecodeStack *stack) {
+    const CBORInitialByte *table = CBORInitialByteTable();
+    CBORCursor *cursor = [stream cursor];
+    NSUInteger items = 0;
+    
+    for (id component in path) {
+        // 扩展类型对路径透明
+        CBORDecodeHeader header;
+        do {
+            if (!CBORDecodeReadHeader(cursor, table, stack, limits, &items, &header)) { return NO; }
+        } while (header.entry.kind == CBORDecodeKindTag);
         
-        value = CBORDecodeData(stream);
-        // Value终止属于异常情况
-        if (!value || [value isBreak]) { return nil; }
+        CBORDecodeKind kind = header.entry.kind;
+        BOOL indefinite = CBORDecodeKindIsIndefinite(kind);
         
-        ret[key] = value;
+        switch (kind) {
+                // 数组：组件为下标
+            case CBORDecodeKindArray:
+            case CBORDecodeKindIndefiniteArray: {
+                if (![component isKindOfClass:[NSNumber class]]) { return NO; }
+                
+                NSInteger index = [component integerValue];
+                if (index < 0) { return NO; }
+                // 定长数组越界无需扫描
+                if (!indefinite && (UInt64)index >= header.argument) { return NO; }
+                
+                for (NSInteger skip = 0; skip < index; skip++) {
+                    if (indefinite && CBORCursorPeekBreak(cursor)) { return NO; }
+                    if (!CBORDecodeSkip(cursor, limits, stack)) { return NO; }
+                }
+                if (indefinite && CBORCursorPeekBreak(cursor)) { return NO; }
+            } break;
+                
+                // 键值对：组件为键，与完整解码一致取最后一个匹配的键，须扫描完整个键值对
+            case CBORDecodeKindMap:
+            case CBORDecodeKindIndefiniteMap: {
+                CBORDecodePathKey key = { component, NULL, 0 };
+                if ([component isKindOfClass:[NSString class]]) {
+                    key.utf8 = [(NSString *)component UTF8String];
+                    key.utf8Length = [(NSString *)component lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+                }
+                
+                NSUInteger value = NSNotFound;
+                for (UInt64 index = 0; indefinite || index < header.argument; index++) {
+                    if (indefinite && CBORCursorPeekBreak(cursor)) { break; }
+                    
+                    BOOL match = NO;
+                    if (!CBORDecodeMatchKey(stream, key, limits, stack, &match)) { return NO; }
+                    if (match) { value = cursor->index; }
+                    if (!CBORDecodeSkip(cursor, limits, stack)) { return NO; }
+                }
+                if (value == NSNotFound) { return NO; }
+                cursor->index = value;
+            } break;
+                
+            default:
+                return NO;
+        }
+    }
+    return YES;
+}
+
+
+/// 并行解码的最少元素数量，元素过少时线程调度开销超过收益
+static const NSUInteger CBORConcurrentMinimumCount = 256;
+/// 每个任务的最少元素数量
+static const NSUInteger CBORConcurrentMinimumChunk = 64;
+
+/// 扫描顶层数组的元素边界：仅读取头部，字节数组/字符串按长度跳过
+/// - Parameters:
+///   - offsets: 各元素起始位置，由调用方释放
+/// - Returns: 顶层为合法数组时返回YES
+static BOOL CBORDecodeScanArray(CBORCursor *cursor, CBORDecodeLimits limits, CBORDecodeStack *stack, NSUInteger **offsets, NSUInteger *count) {
+    NSUInteger items = 0;
+    CBORDecodeHeader header;
+    if (!CBORDecodeReadHeader(cursor, CBORInitialByteTable(), stack, limits, &items, &header)) { return NO; }
+    
+    BOOL indefinite = header.entry.kind == CBORDecodeKindIndefiniteArray;
+    if (!indefinite && header.entry.kind != CBORDecodeKindArray) { return NO; }
+    if (!indefinite && header.argument > CBORCursorRemaining(cursor)) { return NO; }
+    
+    NSUInteger capacity = indefinite ? CBORConcurrentMinimumCount : MAX((NSUInteger)header.argument, 1);
+    NSUInteger *ret = malloc(capacity * sizeof(NSUInteger));
+    if (!ret) { return NO; }
+    *offsets = ret;
+    *count = 0;
+    
+    while (indefinite ? !CBORCursorPeekBreak(cursor) : *count < header.argument) {
+        if (*count == capacity) {
+            capacity *= 2;
+            ret = realloc(*offsets, capacity * sizeof(NSUInteger));
+            if (!ret) { return NO; }
+            *offsets = ret;
+        }
         
-    } while (YES);
+        // 定长数组的元素不能是终止符，否则单独解码该元素会得到终止符对象，与顺序解码不一致
+        if (CBORCursorPeekBreak(cursor)) { return NO; }
+        (*offsets)[(*count)++] = cursor->index;
+        if (!CBORDecodeSkip(cursor, limits, stack)) { return NO; }
+    }
+    return YES;
+}
+
+
+@implementation CBORDecoder
+
++ (CBORObject *)decodeData:(NSData *)aData {
+    return [self decodeData:aData limits:CBORDecodeLimitsDefault];
+}
+
++ (CBORObject *)decodeData:(NSData *)aData limits:(CBORDecodeLimits)limits {
+    if (limits.maxBytes && [aData length] > limits.maxBytes) { return nil; }
+    
+    CBORStream *stream = [[CBORStream alloc] initWithData:aData];
+    CBORDecodeStack stack = { NULL, 0, 0 };
+    CBORObject *ret = CBORDecodeData(stream, limits, &stack);
+    CBORDecodeStackDispose(&stack);
     
     return ret;
 }
 
-/// 读取不定长数组
-/// - Parameters:
-///   - stream: 输入流
-///   - major: 主要类型
-///   - shouldElementEqualToMajor: 是否限制子元素必须与主要类型一致
-static CBORObject * CBORArrayUntilBreak(CBORStream *stream, CBORMajorType major, BOOL shouldElementEqualToMajor) {
-    NSArray *items = CBORObjectsUntilBreak(stream);
-    CBORArray *ret = [[CBORArray alloc] initWithMajor:major];
++ (id)decodeObjectWithData:(NSData *)aData limits:(CBORDecodeLimits)limits {
+    return [self decodeObjectWithData:aData limits:limits internTable:nil];
+}
+
++ (id)decodeObjectWithData:(NSData *)aData limits:(CBORDecodeLimits)limits internTable:(CBORInternTable *)internTable {
+    if (limits.maxBytes && [aData length] > limits.maxBytes) { return nil; }
     
-    for (CBORArray *item in items) {
-        // 字节数组限制子元素必须与主要类型一致
-        if (shouldElementEqualToMajor && [item majorType] != major) { return nil; }
+    CBORStream *stream = [[CBORStream alloc] initWithData:aData];
+    stream.internTable = internTable;
+    CBORDecodeStack stack = { NULL, 0, 0 };
+    id ret = CBORDecodeObject(stream, limits, &stack);
+    CBORDecodeStackDispose(&stack);
+    
+    return ret;
+}
+
++ (id)decodeObjectWithContentsOfFile:(NSString *)path options:(CBORDecodeOptions)options limits:(CBORDecodeLimits)limits {
+    // 始终映射，按需分页载入，常驻内存只随实际访问的数据增长
+    NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedAlways error:NULL];
+    if (!data) { return nil; }
+    if (limits.maxBytes && [data length] > limits.maxBytes) { return nil; }
+    
+    CBORStream *stream = [[CBORStream alloc] initWithData:data];
+    stream.noCopyStrings = (options & CBORDecodeOptionsNoCopyStrings) != 0;
+    CBORDecodeStack stack = { NULL, 0, 0 };
+    id ret = CBORDecodeObject(stream, limits, &stack);
+    CBORDecodeStackDispose(&stack);
+    
+    return ret;
+}
+
++ (CBORDecodeStatus)decodeObject:(id *)object data:(NSData *)aData offset:(NSUInteger *)offset limits:(CBORDecodeLimits)limits {
+    if (object) { *object = nil; }
+    if (*offset >= [aData length]) { return CBORDecodeStatusNeedMoreData; }
+    
+    CBORStream *stream = [[CBORStream alloc] initWithData:aData];
+    CBORCursor *cursor = [stream cursor];
+    NSUInteger start = *offset;
+    cursor->index = start;
+    // 单独的终止符不是数据项，不能作为一条记录
+    if (CBORCursorPeekBreak(cursor)) {
+        *offset = start + 1;
+        return CBORDecodeStatusMalformed;
+    }
+    
+    CBORDecodeStack stack = { NULL, 0, 0 };
+    id ret = CBORDecodeObject(stream, limits, &stack);
+    CBORDecodeStackDispose(&stack);
+    
+    if (ret) {
+        if (object) { *object = ret; }
+        *offset = cursor->index;
+        return CBORDecodeStatusOK;
+    }
+    
+    // 结构完整但无法转为原生对象时跳过整条记录，否则从下一个字节重新同步
+    cursor->index = start;
+    BOOL wellFormed = CBORDecodeSkip(cursor, limits, &stack);
+    CBORDecodeStackDispose(&stack);
+    *offset = wellFormed ? cursor->index : start + 1;
+    
+    return CBORDecodeStatusMalformed;
+}
+
++ (id)decodeObjectConcurrentlyWithData:(NSData *)aData limits:(CBORDecodeLimits)limits {
+    // 元素数量限制需全局计数；深度限制为1时数组无法入栈，均按顺序解码
+    if (limits.maxItems || limits.maxDepth == 1) { return [self decodeObjectWithData:aData limits:limits]; }
+    if (limits.maxBytes && [aData length] > limits.maxBytes) { return nil; }
+    
+    CBORStream *stream = [[CBORStream alloc] initWithData:aData];
+    NSData *source = [stream source];
+    // 元素位于第二层，嵌套深度限制相应减一
+    CBORDecodeLimits elementLimits = limits;
+    if (elementLimits.maxDepth) { elementLimits.maxDepth--; }
+    
+    NSUInteger *offsets = NULL;
+    NSUInteger count = 0;
+    CBORDecodeStack stack = { NULL, 0, 0 };
+    BOOL scanned = CBORDecodeScanArray([stream cursor], elementLimits, &stack, &offsets, &count);
+    CBORDecodeStackDispose(&stack);
+    
+    // 非数组、元素过少或数据非法时按顺序解码，结果保持一致
+    if (!scanned || count < CBORConcurrentMinimumCount) {
+        free(offsets);
+        return [self decodeObjectWithData:source limits:limits];
+    }
+    
+    NSUInteger workers = MAX([[NSProcessInfo processInfo] activeProcessorCount], 1);
+    NSUInteger chunk = MAX(count / (workers * 4), CBORConcurrentMinimumChunk);
+    NSUInteger chunks = (count + chunk - 1) / chunk;
+    CFTypeRef *results = calloc(count, sizeof(CFTypeRef));
+    if (!results) {
+        free(offsets);
+        return [self decodeObjectWithData:source limits:limits];
+    }
+    
+    // 每个任务使用独立的数据流、帧栈与驻留表（首个键值对时由数据流创建），只共享数据源；
+    // 共享驻留表会使所有任务的键查找争用同一把锁
+    dispatch_apply(chunks, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t index) {
+        CBORStream *worker = [[CBORStream alloc] initWithData:source];
+        CBORDecodeStack workerStack = { NULL, 0, 0 };
+        NSUInteger end = MIN((index + 1) * chunk, count);
         
-        [ret addCBOR:item];
+        for (NSUInteger element = index * chunk; element < end; element++) {
+            [worker cursor]->index = offsets[element];
+            id object = CBORDecodeObject(worker, elementLimits, &workerStack);
+            if (!object) { break; }
+            
+            results[element] = CFBridgingRetain(object);
+        }
+        CBORDecodeStackDispose(&workerStack);
+    });
+    free(offsets);
+    
+    // 按顺序组装，任一元素失败则与顺序解码一样返回nil
+    NSMutableArray *ret = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger index = 0; index < count; index++) {
+        if (!results[index]) { ret = nil; continue; }
+        
+        id object = CFBridgingRelease(results[index]);
+        [ret addObject:object];
     }
+    free(results);
     
     return ret;
 }
 
++ (BOOL)decodeData:(NSData *)aData delegate:(id<CBORDecoderDelegate>)delegate limits:(CBORDecodeLimits)limits {
+    if (limits.maxBytes && [aData length] > limits.maxBytes) { return NO; }
+    
+    // 事件均引用输入数据，无需数据流持有视图
+    CBORCursor cursor = { [aData bytes], [aData length], 0 };
+    CBORDecodeStack stack = { NULL, 0, 0 };
+    BOOL ret = CBORDecodeEvents(&cursor, delegate, limits, &stack);
+    CBORDecodeStackDispose(&stack);
+    
+    return ret;
+}
 
-@implementation CBORDecoder
-
-+ (CBORObject *)decodeData:(NSData *)aData {
++ (id)decodeObjectAtPath:(NSArray *)path data:(NSData *)aData limits:(CBORDecodeLimits)limits {
+    if (limits.maxBytes && [aData length] > limits.maxBytes) { return nil; }
+    
     CBORStream *stream = [[CBORStream alloc] initWithData:aData];
-    CBORObject *ret = CBORDecodeData(stream);
+    CBORDecodeStack stack = { NULL, 0, 0 };
+    id ret = nil;
+    if (CBORDecodeSeekPath(stream, path, limits, &stack)) {
+        ret = CBORDecodeObject(stream, limits, &stack);
+    }
+    CBORDecodeStackDispose(&stack);
     
     return ret;
 }
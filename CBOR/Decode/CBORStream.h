@@ -28,16 +28,112 @@
 /// 半精度
 typedef UInt16 Float16;
 
+/// 数据游标：直接指向数据源字节，读取时仅做边界校验与大端转换，不产生任何内存分配
+typedef struct {
+    /// 数据源首地址
+    const UInt8 *bytes;
+    /// 数据源长度
+    NSUInteger length;
+    /// 当前读取位置
+    NSUInteger index;
+} CBORCursor;
+
+/// 剩余可读取长度
+static inline NSUInteger CBORCursorRemaining(const CBORCursor *cursor) {
+    return cursor->length - cursor->index;
+}
+
+/// 校验读取区间是否溢出数据长度
+static inline BOOL CBORCursorCanRead(const CBORCursor *cursor, NSUInteger length) {
+    return length <= cursor->length - cursor->index;
+}
+
+static inline BOOL CBORCursorReadUInt8(CBORCursor *cursor, UInt8 *value) {
+    if (!CBORCursorCanRead(cursor, sizeof(UInt8))) return NO;
+    if (value) *value = cursor->bytes[cursor->index];
+    cursor->index += sizeof(UInt8);
+    return YES;
+}
+
+static inline BOOL CBORCursorReadUInt16(CBORCursor *cursor, UInt16 *value) {
+    if (!CBORCursorCanRead(cursor, sizeof(UInt16))) return NO;
+    UInt16 raw;
+    // memcpy定长读取会被编译为单条非对齐加载指令
+    memcpy(&raw, cursor->bytes + cursor->index, sizeof(raw));
+    if (value) *value = CFSwapInt16BigToHost(raw);
+    cursor->index += sizeof(UInt16);
+    return YES;
+}
+
+static inline BOOL CBORCursorReadUInt32(CBORCursor *cursor, UInt32 *value) {
+    if (!CBORCursorCanRead(cursor, sizeof(UInt32))) return NO;
+    UInt32 raw;
+    memcpy(&raw, cursor->bytes + cursor->index, sizeof(raw));
+    if (value) *value = CFSwapInt32BigToHost(raw);
+    cursor->index += sizeof(UInt32);
+    return YES;
+}
+
+static inline BOOL CBORCursorReadUInt64(CBORCursor *cursor, UInt64 *value) {
+    if (!CBORCursorCanRead(cursor, sizeof(UInt64))) return NO;
+    UInt64 raw;
+    memcpy(&raw, cursor->bytes + cursor->index, sizeof(raw));
+    if (value) *value = CFSwapInt64BigToHost(raw);
+    cursor->index += sizeof(UInt64);
+    return YES;
+}
+
+/// 读取1/2/4/8字节的大端无符号整数
+static inline BOOL CBORCursorReadUInt(CBORCursor *cursor, NSUInteger length, UInt64 *value) {
+    switch (length) {
+        case 1: { UInt8 v = 0; if (!CBORCursorReadUInt8(cursor, &v)) return NO; if (value) *value = v; return YES; }
+        case 2: { UInt16 v = 0; if (!CBORCursorReadUInt16(cursor, &v)) return NO; if (value) *value = v; return YES; }
+        case 4: { UInt32 v = 0; if (!CBORCursorReadUInt32(cursor, &v)) return NO; if (value) *value = v; return YES; }
+        case 8: return CBORCursorReadUInt64(cursor, value);
+        default: return NO;
+    }
+}
+
+/// 读取指定长度的字节，返回指向数据源的指针（不拷贝）
+static inline BOOL CBORCursorReadBytes(CBORCursor *cursor, NSUInteger length, const UInt8 **bytes) {
+    if (!CBORCursorCanRead(cursor, length)) return NO;
+    if (bytes) *bytes = cursor->bytes + cursor->index;
+    cursor->index += length;
+    return YES;
+}
+
+
+@class CBORInternTable;
+
 NS_ASSUME_NONNULL_BEGIN
 /// 数据输入输出流（相当于简单的管理器）
 @interface CBORStream : NSObject
 /// 初始化数据
 - (instancetype)initWithData:(NSData *)data;
+/// 重新指定数据源并回到起始位置，复用同一个流解码多份数据
+- (void)resetWithData:(NSData *)data;
+
+/// 数据源
+@property (nonatomic, copy, readonly) NSData *source;
+/// 当前读取位置
+@property (nonatomic, assign, readonly) NSUInteger index;
+/// 数据游标，生命周期与流一致
+@property (nonatomic, assign, readonly) CBORCursor *cursor;
+/// 字符串是否直接引用数据源字节（不拷贝）
+@property (nonatomic, assign) BOOL noCopyStrings;
+/// 键值对的键所用的驻留表，为空时解码过程中按需创建
+@property (nonatomic, strong, nullable) CBORInternTable *internTable;
 
+/// 是否已读取完毕
+- (BOOL)isAtEnd;
 
-/// 弹出数据
+/// 弹出数据；返回的数据与数据源共享内存（持有数据源），不拷贝
 - (BOOL)popDataWithLength:(NSUInteger)length
                      data:(NSData * _Nullable * _Nullable)data;
+/// 构建共享数据源内存的数据视图
+- (NSData *)dataViewWithBytes:(const UInt8 *)bytes length:(NSUInteger)length;
+/// 构建UTF8字符串，`noCopyStrings`时共享数据源内存（持有数据源）；编码非法返回nil
+- (nullable NSString *)stringWithBytes:(const UInt8 *)bytes length:(NSUInteger)length;
 
 - (BOOL)popUInt8:(UInt8 * _Nullable)value;
 - (BOOL)popUInt16:(UInt16 * _Nullable)value;
@@ -24,132 +24,108 @@
 //
 
 #import "CBORStream.h"
+#import "CBORUTF8.h"
 
-#define CBOR_POP_VALUE(type) \
-NSUInteger length = sizeof(type); \
-NSData *reversed = [self reversedWithData:[self popDataWithLength:length]]; \
-if (![reversed length]) return 0; \
-type ret = 0; \
-[reversed getBytes:&ret length:length]; \
-return ret;
-
-#define CBOR_POP_VALUE_ERROR(type) \
-NSUInteger length = sizeof(type); \
-NSData *data; \
-BOOL ret = [self popDataWithLength:length data:&data]; \
-if (!ret) return NO; \
-NSData *reversed = [self reversedWithData:data]; \
-if (![reversed length]) return NO; \
-type _value = 0; \
-[reversed getBytes:&_value length:length]; \
-if (value) *value = _value; \
-return YES;
-
-@interface CBORStream()
-
-/// 数据源
-@property (nonatomic, copy) NSData *source;
-/// 指向数据源的位置
-@property (nonatomic, assign) NSUInteger index;
-
-@end
-
-@implementation CBORStream
+@implementation CBORStream {
+    /// 数据游标
+    CBORCursor _cursorValue;
+}
 
 // MARK: - Public
 /// 初始化数据
 - (instancetype)initWithData:(NSData *)data {
     self = [super init];
     if (self) {
-        _source = [data copy];
-        _index = 0;
+        [self resetWithData:data];
     }
     return self;
 }
 
-/// 弹出数据
-- (nullable NSData *)popDataWithLength:(NSUInteger)length {
-    if ([self isOverflowWithLength:length]) return nil;
-    
-    NSData *ret = [_source subdataWithRange:NSMakeRange(_index, length)];
-    
-    // 读取完数据后移动偏移长度
-    _index += length;
-    
-    return ret;
+- (void)resetWithData:(NSData *)data {
+    // 不可变数据copy仅增加引用计数；已创建的数据视图各自持有原数据源
+    _source = [data copy];
+    _cursorValue.bytes = [_source bytes];
+    _cursorValue.length = [_source length];
+    _cursorValue.index = 0;
 }
 
-- (UInt8)popUInt8 { CBOR_POP_VALUE(UInt8) }
-- (UInt16)popUInt16 { CBOR_POP_VALUE(UInt16) }
-- (UInt32)popUInt32 { CBOR_POP_VALUE(UInt32) }
-- (UInt64)popUInt64 { CBOR_POP_VALUE(UInt64) }
+- (NSUInteger)index {
+    return _cursorValue.index;
+}
+
+- (CBORCursor *)cursor {
+    return &_cursorValue;
+}
 
-- (Float16)popFloat16 { return [self popUInt16]; }
-- (Float32)popFloat32 { CBOR_POP_VALUE(Float32) }
-- (Float64)popFloat64 { CBOR_POP_VALUE(Float64) }
+- (BOOL)isAtEnd {
+    return _cursorValue.index >= _cursorValue.length;
+}
 
 /// 弹出数据
 - (BOOL)popDataWithLength:(NSUInteger)length
                      data:(NSData * _Nullable * _Nullable)data {
-    if (!length) {
-        if (data) *data = [NSData data];
-        return YES;
-    }
-    
-    if ([self isOverflowWithLength:length]) return NO;
+    const UInt8 *bytes = NULL;
+    if (!CBORCursorReadBytes(&_cursorValue, length, &bytes)) return NO;
     
-    NSData *ret = [_source subdataWithRange:NSMakeRange(_index, length)];
-    if (data) *data = ret;
-    
-    // 读取完数据后移动偏移长度
-    _index += MAX(length, 1);
+    if (data) *data = [self dataViewWithBytes:bytes length:length];
     
     return YES;
 }
 
-- (BOOL)popUInt8:(UInt8 *)value { CBOR_POP_VALUE_ERROR(UInt8); }
-- (BOOL)popUInt16:(UInt16 *)value { CBOR_POP_VALUE_ERROR(UInt16) }
-- (BOOL)popUInt32:(UInt32 *)value { CBOR_POP_VALUE_ERROR(UInt32) }
-- (BOOL)popUInt64:(UInt64 *)value { CBOR_POP_VALUE_ERROR(UInt64) }
+- (NSData *)dataViewWithBytes:(const UInt8 *)bytes length:(NSUInteger)length {
+    if (!length) { return [NSData data]; }
+    
+    // 数据视图持有数据源，数据源释放前视图始终有效
+    NSData *source = _source;
+    return [[NSData alloc] initWithBytesNoCopy:(void *)bytes
+                                        length:length
+                                   deallocator:^(void *viewBytes, NSUInteger viewLength) {
+        (void)source;
+    }];
+}
 
-- (BOOL)popFloat16:(Float16 *)value { return [self popUInt16:value]; }
-- (BOOL)popFloat32:(Float32 *)value { CBOR_POP_VALUE_ERROR(Float32) }
-- (BOOL)popFloat64:(Float64 *)value { CBOR_POP_VALUE_ERROR(Float64) }
+- (NSString *)stringWithBytes:(const UInt8 *)bytes length:(NSUInteger)length {
+    if (_noCopyStrings && length) {
+        if (@available(iOS 13.0, macOS 10.15, *)) {
+            BOOL ascii = NO;
+            if (!CBORUTF8Validate(bytes, length, &ascii)) { return nil; }
+            
+            // 字符串持有数据源；非ASCII内容仍会由系统转码为独立存储
+            NSData *source = _source;
+            return [[NSString alloc] initWithBytesNoCopy:(void *)bytes
+                                                  length:length
+                                                encoding:ascii ? NSASCIIStringEncoding : NSUTF8StringEncoding
+                                             deallocator:^(void *stringBytes, NSUInteger stringLength) {
+                (void)source;
+            }];
+        }
+    }
+    return CBORUTF8String(bytes, length, NO);
+}
 
-- (BOOL)popBytes:(UInt64 *)value length:(NSUInteger)length {
-    NSData *data;
-    BOOL ret = [self popDataWithLength:length data:&data];
-    if (!ret) return NO;
-    
-    NSData *reversed = [self reversedWithData:data];
-    if (![reversed length]) return NO;
-    
-    UInt64 _value = 0;
-    [reversed getBytes:&_value length:length];
-    
-    if (value) *value = _value;
-    
+- (BOOL)popUInt8:(UInt8 *)value { return CBORCursorReadUInt8(&_cursorValue, value); }
+- (BOOL)popUInt16:(UInt16 *)value { return CBORCursorReadUInt16(&_cursorValue, value); }
+- (BOOL)popUInt32:(UInt32 *)value { return CBORCursorReadUInt32(&_cursorValue, value); }
+- (BOOL)popUInt64:(UInt64 *)value { return CBORCursorReadUInt64(&_cursorValue, value); }
+
+- (BOOL)popFloat16:(Float16 *)value { return CBORCursorReadUInt16(&_cursorValue, value); }
+
+- (BOOL)popFloat32:(Float32 *)value {
+    UInt32 raw = 0;
+    if (!CBORCursorReadUInt32(&_cursorValue, &raw)) return NO;
+    if (value) memcpy(value, &raw, sizeof(raw));
     return YES;
 }
 
-// MARK: - Private
-/// 校验读取区间是否溢出数据长度
-- (BOOL)isOverflowWithLength:(NSUInteger)length {
-    return [_source length] < _index + length;
+- (BOOL)popFloat64:(Float64 *)value {
+    UInt64 raw = 0;
+    if (!CBORCursorReadUInt64(&_cursorValue, &raw)) return NO;
+    if (value) memcpy(value, &raw, sizeof(raw));
+    return YES;
 }
 
-/// 倒序数据
-- (NSData *)reversedWithData:(NSData *)data {
-    NSUInteger length = [data length];
-    if (length <= 1) { return data; }
-    
-    const char *bytes = [data bytes];
-    char *reversedBytes = malloc(sizeof(char) * length);
-    
-    for (NSUInteger index = length; index > 0; index--)
-        reversedBytes[length - index] = bytes[index - 1];
-    
-    return [NSData dataWithBytesNoCopy:reversedBytes length:length];
+- (BOOL)popBytes:(UInt64 *)value length:(NSUInteger)length {
+    return CBORCursorReadUInt(&_cursorValue, length, value);
 }
 
 @end
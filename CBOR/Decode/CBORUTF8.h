@@ -0,0 +1,49 @@
+// refer: https://github.com/DanielHusx/CBOR
+//
+// MIT License
+//
+// Copyright (c) 2024 Daniel
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// UTF8校验：ASCII连续区段使用向量指令（NEON/SSE2/AVX2，运行时选择）批量跳过，
+/// 其余部分按查表法（NEON/SSE4.1/AVX2）整块校验，仅在非法时逐个字符定位首个非法位置；无向量指令时逐个字符校验
+/// - Parameters:
+///   - bytes: UTF8字节
+///   - length: 字节长度
+///   - ascii: 输出是否全部为ASCII字符
+/// - Returns: 合法前缀的字节长度，等于`length`时整体合法，否则为首个非法字符的位置
+FOUNDATION_EXTERN NSUInteger CBORUTF8ValidLength(const UInt8 *bytes, NSUInteger length, BOOL * _Nullable ascii);
+
+/// UTF8编码是否合法
+static inline BOOL CBORUTF8Validate(const UInt8 *bytes, NSUInteger length, BOOL * _Nullable ascii) {
+    return CBORUTF8ValidLength(bytes, length, ascii) == length;
+}
+
+/// 构建字符串：纯ASCII直接按单字节编码构建，其余按UTF8转码
+/// - Parameter isMutable: 是否构建可变字符串
+/// - Returns: UTF8编码非法时返回nil
+FOUNDATION_EXTERN NSString * _Nullable CBORUTF8String(const UInt8 *bytes, NSUInteger length, BOOL isMutable);
+
+NS_ASSUME_NONNULL_END
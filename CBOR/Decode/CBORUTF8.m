@@ -0,0 +1,414 @@
+// refer: https://github.com/DanielHusx/CBOR
+//
+// MIT License
+//
+// Copyright (c) 2024 Daniel
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import "CBORUTF8.h"
+#if defined(__x86_64__)
+#import <immintrin.h>
+#import <sys/sysctl.h>
+#elif defined(__arm64__) || defined(__aarch64__)
+#import <arm_neon.h>
+#endif
+
+// MARK: - ASCII区段
+/// 返回开头连续ASCII字符的字节数
+typedef NSUInteger (*CBORUTF8ASCIIKernel)(const UInt8 *bytes, NSUInteger length);
+
+/// 标量：每次检查8字节
+static NSUInteger CBORUTF8ASCIIScalar(const UInt8 *bytes, NSUInteger length) {
+    NSUInteger index = 0;
+    for (; index + sizeof(UInt64) <= length; index += sizeof(UInt64)) {
+        UInt64 word;
+        memcpy(&word, bytes + index, sizeof(word));
+        if (word & 0x8080808080808080ULL) { break; }
+    }
+    while (index < length && bytes[index] < 0x80) { index++; }
+    return index;
+}
+
+#if defined(__x86_64__)
+/// SSE2：每次检查16字节
+static NSUInteger CBORUTF8ASCIISSE2(const UInt8 *bytes, NSUInteger length) {
+    NSUInteger index = 0;
+    for (; index + 16 <= length; index += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *)(bytes + index));
+        if (_mm_movemask_epi8(block)) { break; }
+    }
+    return index + CBORUTF8ASCIIScalar(bytes + index, length - index);
+}
+
+/// AVX2：每次检查32字节
+__attribute__((target("avx2")))
+static NSUInteger CBORUTF8ASCIIAVX2(const UInt8 *bytes, NSUInteger length) {
+    NSUInteger index = 0;
+    for (; index + 32 <= length; index += 32) {
+        __m256i block = _mm256_loadu_si256((const __m256i *)(bytes + index));
+        if (_mm256_movemask_epi8(block)) { break; }
+    }
+    return index + CBORUTF8ASCIISSE2(bytes + index, length - index);
+}
+#elif defined(__arm64__) || defined(__aarch64__)
+/// NEON：每次检查16字节
+static NSUInteger CBORUTF8ASCIINEON(const UInt8 *bytes, NSUInteger length) {
+    NSUInteger index = 0;
+    for (; index + 16 <= length; index += 16) {
+        uint8x16_t block = vld1q_u8(bytes + index);
+        if (vmaxvq_u8(block) >= 0x80) { break; }
+    }
+    return index + CBORUTF8ASCIIScalar(bytes + index, length - index);
+}
+#endif
+
+/// 按处理器能力选择内核，仅选择一次
+static CBORUTF8ASCIIKernel CBORUTF8ASCIIKernelSelect(void) {
+    static CBORUTF8ASCIIKernel kernel = CBORUTF8ASCIIScalar;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+#if defined(__x86_64__)
+        int avx2 = 0;
+        size_t size = sizeof(avx2);
+        if (!sysctlbyname("hw.optional.avx2_0", &avx2, &size, NULL, 0) && avx2) {
+            kernel = CBORUTF8ASCIIAVX2;
+        } else {
+            kernel = CBORUTF8ASCIISSE2;
+        }
+#elif defined(__arm64__) || defined(__aarch64__)
+        kernel = CBORUTF8ASCIINEON;
+#endif
+    });
+    return kernel;
+}
+
+
+// MARK: - 多字节校验
+// 查表校验（Keiser & Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte"）：
+// 按前一字节的高/低4位与当前字节的高4位各查一次表，三者按位与非零即为非法的两字节组合；
+// 第三、四个字节是否应为后续字节由前两、三个字节推出，与查表结果异或
+#define CBORUTF8TooShort        (1 << 0)
+#define CBORUTF8TooLong         (1 << 1)
+#define CBORUTF8Overlong3       (1 << 2)
+#define CBORUTF8TooLarge        (1 << 3)
+#define CBORUTF8Surrogate       (1 << 4)
+#define CBORUTF8Overlong2       (1 << 5)
+#define CBORUTF8TooLarge1000    (1 << 6)
+#define CBORUTF8Overlong4       (1 << 6)
+#define CBORUTF8TwoContinuations (1 << 7)
+#define CBORUTF8Carry           (CBORUTF8TooShort | CBORUTF8TooLong | CBORUTF8TwoContinuations)
+
+/// 前一字节高4位
+static const UInt8 CBORUTF8Byte1High[16] = {
+    // 0_______ ASCII
+    CBORUTF8TooLong, CBORUTF8TooLong, CBORUTF8TooLong, CBORUTF8TooLong,
+    CBORUTF8TooLong, CBORUTF8TooLong, CBORUTF8TooLong, CBORUTF8TooLong,
+    // 10______ 后续字节
+    CBORUTF8TwoContinuations, CBORUTF8TwoContinuations, CBORUTF8TwoContinuations, CBORUTF8TwoContinuations,
+    // 1100____ 1101____ 两字节首字节
+    CBORUTF8TooShort | CBORUTF8Overlong2,
+    CBORUTF8TooShort,
+    // 1110____ 三字节首字节
+    CBORUTF8TooShort | CBORUTF8Overlong3 | CBORUTF8Surrogate,
+    // 1111____ 四字节首字节
+    CBORUTF8TooShort | CBORUTF8TooLarge | CBORUTF8TooLarge1000 | CBORUTF8Overlong4,
+};
+
+/// 前一字节低4位
+static const UInt8 CBORUTF8Byte1Low[16] = {
+    // ____0000
+    CBORUTF8Carry | CBORUTF8Overlong3 | CBORUTF8Overlong2 | CBORUTF8Overlong4,
+    // ____0001
+    CBORUTF8Carry | CBORUTF8Overlong2,
+    // ____001_
+    CBORUTF8Carry,
+    CBORUTF8Carry,
+    // ____0100
+    CBORUTF8Carry | CBORUTF8TooLarge,
+    // ____0101 ~ ____1100
+    CBORUTF8Carry | CBORUTF8TooLarge | CBORUTF8TooLarge1000,
+    CBORUTF8Carry | CBORUTF8TooLarge | CBORUTF8TooLarge1000,
+    CBORUTF8Carry | CBORUTF8TooLarge | CBORUTF8TooLarge1000,
+    CBORUTF8Carry | CBORUTF8TooLarge | CBORUTF8TooLarge1000,
+    CBORUTF8Carry | CBORUTF8TooLarge | CBORUTF8TooLarge1000,
+    CBORUTF8Carry | CBORUTF8TooLarge | CBORUTF8TooLarge1000,
+    CBORUTF8Carry | CBORUTF8TooLarge | CBORUTF8TooLarge1000,
+    CBORUTF8Carry | CBORUTF8TooLarge | CBORUTF8TooLarge1000,
+    // ____1101
+    CBORUTF8Carry | CBORUTF8TooLarge | CBORUTF8TooLarge1000 | CBORUTF8Surrogate,
+    // ____111_
+    CBORUTF8Carry | CBORUTF8TooLarge | CBORUTF8TooLarge1000,
+    CBORUTF8Carry | CBORUTF8TooLarge | CBORUTF8TooLarge1000,
+};
+
+/// 当前字节高4位
+static const UInt8 CBORUTF8Byte2High[16] = {
+    // 0_______ ASCII
+    CBORUTF8TooShort, CBORUTF8TooShort, CBORUTF8TooShort, CBORUTF8TooShort,
+    CBORUTF8TooShort, CBORUTF8TooShort, CBORUTF8TooShort, CBORUTF8TooShort,
+    // 1000____
+    CBORUTF8TooLong | CBORUTF8Overlong2 | CBORUTF8TwoContinuations | CBORUTF8Overlong3 | CBORUTF8TooLarge1000 | CBORUTF8Overlong4,
+    // 1001____
+    CBORUTF8TooLong | CBORUTF8Overlong2 | CBORUTF8TwoContinuations | CBORUTF8Overlong3 | CBORUTF8TooLarge,
+    // 101_____
+    CBORUTF8TooLong | CBORUTF8Overlong2 | CBORUTF8TwoContinuations | CBORUTF8Surrogate | CBORUTF8TooLarge,
+    CBORUTF8TooLong | CBORUTF8Overlong2 | CBORUTF8TwoContinuations | CBORUTF8Surrogate | CBORUTF8TooLarge,
+    // 11______ 首字节
+    CBORUTF8TooShort, CBORUTF8TooShort, CBORUTF8TooShort, CBORUTF8TooShort,
+};
+
+/// 块末尾未完成的多字节字符：倒数第1/2/3字节分别不小于0xC0/0xE0/0xF0
+static const UInt8 CBORUTF8IncompleteMax[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF,
+};
+
+/// 整体是否合法
+typedef BOOL (*CBORUTF8MultibyteKernel)(const UInt8 *bytes, NSUInteger length);
+
+#if defined(__x86_64__)
+/// SSE4.1：每次校验16字节
+__attribute__((target("sse4.1")))
+static BOOL CBORUTF8MultibyteSSE4(const UInt8 *bytes, NSUInteger length) {
+    const __m128i byte1HighTable = _mm_loadu_si128((const __m128i *)CBORUTF8Byte1High);
+    const __m128i byte1LowTable = _mm_loadu_si128((const __m128i *)CBORUTF8Byte1Low);
+    const __m128i byte2HighTable = _mm_loadu_si128((const __m128i *)CBORUTF8Byte2High);
+    const __m128i incompleteMax = _mm_loadu_si128((const __m128i *)(CBORUTF8IncompleteMax + 16));
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    
+    __m128i error = _mm_setzero_si128();
+    __m128i previous = _mm_setzero_si128();
+    __m128i previousIncomplete = _mm_setzero_si128();
+    UInt8 tail[16];
+    for (NSUInteger index = 0; index < length; index += 16) {
+        __m128i input;
+        if (length - index >= 16) {
+            input = _mm_loadu_si128((const __m128i *)(bytes + index));
+        } else {
+            // 不足一块时以ASCII补齐
+            memset(tail, 0, sizeof(tail));
+            memcpy(tail, bytes + index, length - index);
+            input = _mm_loadu_si128((const __m128i *)tail);
+        }
+        
+        if (!_mm_movemask_epi8(input)) {
+            // 整块ASCII：只需检查上一块末尾的字符是否完整
+            error = _mm_or_si128(error, previousIncomplete);
+        } else {
+            __m128i prev1 = _mm_alignr_epi8(input, previous, 15);
+            __m128i byte1High = _mm_shuffle_epi8(byte1HighTable, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+            __m128i byte1Low = _mm_shuffle_epi8(byte1LowTable, _mm_and_si128(prev1, nibble));
+            __m128i byte2High = _mm_shuffle_epi8(byte2HighTable, _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+            __m128i special = _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+            
+            __m128i prev2 = _mm_alignr_epi8(input, previous, 14);
+            __m128i prev3 = _mm_alignr_epi8(input, previous, 13);
+            __m128i must23 = _mm_or_si128(_mm_subs_epu8(prev2, _mm_set1_epi8(0xE0 - 0x80)), _mm_subs_epu8(prev3, _mm_set1_epi8(0xF0 - 0x80)));
+            error = _mm_or_si128(error, _mm_xor_si128(_mm_and_si128(must23, _mm_set1_epi8((char)0x80)), special));
+            previousIncomplete = _mm_subs_epu8(input, incompleteMax);
+        }
+        previous = input;
+    }
+    error = _mm_or_si128(error, previousIncomplete);
+    return _mm_testz_si128(error, error);
+}
+
+/// AVX2：每次校验32字节
+__attribute__((target("avx2")))
+static BOOL CBORUTF8MultibyteAVX2(const UInt8 *bytes, NSUInteger length) {
+    const __m256i byte1HighTable = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)CBORUTF8Byte1High));
+    const __m256i byte1LowTable = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)CBORUTF8Byte1Low));
+    const __m256i byte2HighTable = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)CBORUTF8Byte2High));
+    const __m256i incompleteMax = _mm256_loadu_si256((const __m256i *)CBORUTF8IncompleteMax);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    
+    __m256i error = _mm256_setzero_si256();
+    __m256i previous = _mm256_setzero_si256();
+    __m256i previousIncomplete = _mm256_setzero_si256();
+    UInt8 tail[32];
+    for (NSUInteger index = 0; index < length; index += 32) {
+        __m256i input;
+        if (length - index >= 32) {
+            input = _mm256_loadu_si256((const __m256i *)(bytes + index));
+        } else {
+            memset(tail, 0, sizeof(tail));
+            memcpy(tail, bytes + index, length - index);
+            input = _mm256_loadu_si256((const __m256i *)tail);
+        }
+        
+        if (!_mm256_movemask_epi8(input)) {
+            error = _mm256_or_si256(error, previousIncomplete);
+        } else {
+            // 跨128位通道取前1~3个字节
+            __m256i shifted = _mm256_permute2x128_si256(previous, input, 0x21);
+            __m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+            __m256i byte1High = _mm256_shuffle_epi8(byte1HighTable, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+            __m256i byte1Low = _mm256_shuffle_epi8(byte1LowTable, _mm256_and_si256(prev1, nibble));
+            __m256i byte2High = _mm256_shuffle_epi8(byte2HighTable, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+            __m256i special = _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+            
+            __m256i prev2 = _mm256_alignr_epi8(input, shifted, 14);
+            __m256i prev3 = _mm256_alignr_epi8(input, shifted, 13);
+            __m256i must23 = _mm256_or_si256(_mm256_subs_epu8(prev2, _mm256_set1_epi8(0xE0 - 0x80)), _mm256_subs_epu8(prev3, _mm256_set1_epi8(0xF0 - 0x80)));
+            error = _mm256_or_si256(error, _mm256_xor_si256(_mm256_and_si256(must23, _mm256_set1_epi8((char)0x80)), special));
+            previousIncomplete = _mm256_subs_epu8(input, incompleteMax);
+        }
+        previous = input;
+    }
+    error = _mm256_or_si256(error, previousIncomplete);
+    return _mm256_testz_si256(error, error);
+}
+#elif defined(__arm64__) || defined(__aarch64__)
+/// NEON：每次校验16字节
+static BOOL CBORUTF8MultibyteNEON(const UInt8 *bytes, NSUInteger length) {
+    const uint8x16_t byte1HighTable = vld1q_u8(CBORUTF8Byte1High);
+    const uint8x16_t byte1LowTable = vld1q_u8(CBORUTF8Byte1Low);
+    const uint8x16_t byte2HighTable = vld1q_u8(CBORUTF8Byte2High);
+    const uint8x16_t incompleteMax = vld1q_u8(CBORUTF8IncompleteMax + 16);
+    const uint8x16_t nibble = vdupq_n_u8(0x0F);
+    
+    uint8x16_t error = vdupq_n_u8(0);
+    uint8x16_t previous = vdupq_n_u8(0);
+    uint8x16_t previousIncomplete = vdupq_n_u8(0);
+    UInt8 tail[16];
+    for (NSUInteger index = 0; index < length; index += 16) {
+        uint8x16_t input;
+        if (length - index >= 16) {
+            input = vld1q_u8(bytes + index);
+        } else {
+            memset(tail, 0, sizeof(tail));
+            memcpy(tail, bytes + index, length - index);
+            input = vld1q_u8(tail);
+        }
+        
+        if (vmaxvq_u8(input) < 0x80) {
+            error = vorrq_u8(error, previousIncomplete);
+        } else {
+            uint8x16_t prev1 = vextq_u8(previous, input, 15);
+            uint8x16_t byte1High = vqtbl1q_u8(byte1HighTable, vshrq_n_u8(prev1, 4));
+            uint8x16_t byte1Low = vqtbl1q_u8(byte1LowTable, vandq_u8(prev1, nibble));
+            uint8x16_t byte2High = vqtbl1q_u8(byte2HighTable, vshrq_n_u8(input, 4));
+            uint8x16_t special = vandq_u8(vandq_u8(byte1High, byte1Low), byte2High);
+            
+            uint8x16_t prev2 = vextq_u8(previous, input, 14);
+            uint8x16_t prev3 = vextq_u8(previous, input, 13);
+            uint8x16_t must23 = vorrq_u8(vqsubq_u8(prev2, vdupq_n_u8(0xE0 - 0x80)), vqsubq_u8(prev3, vdupq_n_u8(0xF0 - 0x80)));
+            error = vorrq_u8(error, veorq_u8(vandq_u8(must23, vdupq_n_u8(0x80)), special));
+            previousIncomplete = vqsubq_u8(input, incompleteMax);
+        }
+        previous = input;
+    }
+    error = vorrq_u8(error, previousIncomplete);
+    return vmaxvq_u8(error) == 0;
+}
+#endif
+
+/// 按处理器能力选择内核，仅选择一次；无可用向量指令时返回NULL
+static CBORUTF8MultibyteKernel CBORUTF8MultibyteKernelSelect(void) {
+    static CBORUTF8MultibyteKernel kernel = NULL;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+#if defined(__x86_64__)
+        int supported = 0;
+        size_t size = sizeof(supported);
+        if (!sysctlbyname("hw.optional.avx2_0", &supported, &size, NULL, 0) && supported) {
+            kernel = CBORUTF8MultibyteAVX2;
+            return;
+        }
+        supported = 0;
+        size = sizeof(supported);
+        if (!sysctlbyname("hw.optional.sse4_1", &supported, &size, NULL, 0) && supported) {
+            kernel = CBORUTF8MultibyteSSE4;
+        }
+#elif defined(__arm64__) || defined(__aarch64__)
+        kernel = CBORUTF8MultibyteNEON;
+#endif
+    });
+    return kernel;
+}
+
+
+// MARK: - 校验
+static inline BOOL CBORUTF8IsContinuation(UInt8 byte) {
+    return (byte & 0xC0) == 0x80;
+}
+
+/// 逐个字符校验，返回合法前缀的字节长度
+static NSUInteger CBORUTF8ValidLengthScalar(const UInt8 *bytes, NSUInteger length, NSUInteger index, CBORUTF8ASCIIKernel kernel) {
+    while (index < length) {
+        UInt8 lead = bytes[index];
+        if (lead < 0x80) {
+            index += kernel(bytes + index, length - index);
+            continue;
+        }
+        
+        // 排除超长编码、代理区与超出U+10FFFF的码点
+        NSUInteger remaining = length - index;
+        if (lead < 0xC2) { return index; }
+        if (lead < 0xE0) {
+            if (remaining < 2 || !CBORUTF8IsContinuation(bytes[index + 1])) { return index; }
+            index += 2;
+        } else if (lead < 0xF0) {
+            if (remaining < 3) { return index; }
+            UInt8 second = bytes[index + 1];
+            UInt8 lower = lead == 0xE0 ? 0xA0 : 0x80;
+            UInt8 upper = lead == 0xED ? 0x9F : 0xBF;
+            if (second < lower || second > upper || !CBORUTF8IsContinuation(bytes[index + 2])) { return index; }
+            index += 3;
+        } else if (lead < 0xF5) {
+            if (remaining < 4) { return index; }
+            UInt8 second = bytes[index + 1];
+            UInt8 lower = lead == 0xF0 ? 0x90 : 0x80;
+            UInt8 upper = lead == 0xF4 ? 0x8F : 0xBF;
+            if (second < lower || second > upper
+                || !CBORUTF8IsContinuation(bytes[index + 2])
+                || !CBORUTF8IsContinuation(bytes[index + 3])) { return index; }
+            index += 4;
+        } else {
+            return index;
+        }
+    }
+    return length;
+}
+
+NSUInteger CBORUTF8ValidLength(const UInt8 *bytes, NSUInteger length, BOOL *ascii) {
+    CBORUTF8ASCIIKernel kernel = CBORUTF8ASCIIKernelSelect();
+    NSUInteger index = kernel(bytes, length);
+    if (ascii) { *ascii = index == length; }
+    if (index == length) { return length; }
+    
+    // 向量校验整体合法即可返回，非法时再逐个定位首个非法字符
+    CBORUTF8MultibyteKernel multibyte = CBORUTF8MultibyteKernelSelect();
+    if (multibyte && multibyte(bytes + index, length - index)) { return length; }
+    return CBORUTF8ValidLengthScalar(bytes, length, index, kernel);
+}
+
+
+// MARK: - 构建
+NSString * CBORUTF8String(const UInt8 *bytes, NSUInteger length, BOOL isMutable) {
+    BOOL ascii = NO;
+    if (!CBORUTF8Validate(bytes, length, &ascii)) { return nil; }
+    
+    // 已校验合法，ASCII按单字节编码构建无需转码
+    NSStringEncoding encoding = ascii ? NSASCIIStringEncoding : NSUTF8StringEncoding;
+    if (isMutable) { return [[NSMutableString alloc] initWithBytes:bytes length:length encoding:encoding]; }
+    return [[NSString alloc] initWithBytes:bytes length:length encoding:encoding];
+}
@@ -25,6 +25,7 @@
 
 #import <Foundation/Foundation.h>
 #import "CBORConstant.h"
+#import "CBORWriter.h"
 
 NS_ASSUME_NONNULL_BEGIN
 @class CBORObject;
@@ -37,6 +38,42 @@ NS_ASSUME_NONNULL_BEGIN
                        major:(CBORMajorType)major
                        minor:(CBORUInt64)minor;
 
+/// 按编码选项编码对象
++ (CBORObject *)encodeObject:(id)object
+                       major:(CBORMajorType)major
+                       minor:(CBORUInt64)minor
+                     options:(CBOREncodeOptions)options;
+
+/// 对象直接编码为数据：数组、字典与模型不构建CBOR对象树，所有内容写入同一块内存，结果与`-[CBORObject cborData]`完全一致
++ (nullable NSData *)encodeDataWithObject:(id)object
+                                    major:(CBORMajorType)major
+                                    minor:(CBORUInt64)minor
+                                  options:(CBOREncodeOptions)options;
+
+/// 对象直接追加到写入器
+/// - Returns: 无法编码时回退已写入的内容并返回NO
++ (BOOL)writeObject:(id)object
+              major:(CBORMajorType)major
+              minor:(CBORUInt64)minor
+            options:(CBOREncodeOptions)options
+           toWriter:(CBORWriter *)writer;
+
+/// 元素列表编码为定长数组或CBOR序列（RFC 8742），输出与顺序编码一致
+/// - Parameters:
+///   - sequence: 为YES时元素首尾相接，不写数组头部
+///   - parallel: 为YES且元素较多时分块由多个线程编码，再按顺序拼接
+/// - Returns: 任一元素无法编码时返回nil
++ (nullable NSData *)encodeDataWithObjects:(NSArray *)objects
+                                  sequence:(BOOL)sequence
+                                  parallel:(BOOL)parallel;
+
+/// 对象编码后的字节数，与`+encodeDataWithObject:major:minor:options:`的输出长度一致，不分配输出内存
+/// - Returns: 无法编码时返回0
++ (NSUInteger)encodedLengthOfObject:(id)object
+                              major:(CBORMajorType)major
+                              minor:(CBORUInt64)minor
+                            options:(CBOREncodeOptions)options;
+
 @end
 
 NS_ASSUME_NONNULL_END
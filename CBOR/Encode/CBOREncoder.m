@@ -25,23 +25,57 @@
 
 #import "CBOREncoder.h"
 #import "CBORMap.h"
+#import "CBORNumber.h"
 #import "NSNull+CBOR.h"
 #import "NSString+CBOR.h"
+#import "NSNumber+CBOR.h"
+#import "NSDate+CBOR.h"
 #import "CBORClassInfo.h"
 #import "CBOREncodable.h"
+#import "CBORTypedArray.h"
 #import <objc/message.h>
 
 extern NSNumber *CBORModelCreateNumberFromProperty(__unsafe_unretained id model,
                                                             __unsafe_unretained CBORModelPropertyMeta *meta);
 
+/// 编码子元素的函数，子元素以同一函数继续编码以保持编码选项
+typedef CBORObject * (*CBOREncodeContext)(NSObject *, CBORMajorType, CBORUInt64);
+
+/// 模型属性的待编码值（数值属性转为NSNumber，类与选择器转为名称）
+static NSObject * CBOREncodePropertyValue(NSObject *model, CBORModelPropertyMeta *propertyMeta) {
+    if (propertyMeta->_isCNumber) {
+        // 数字类型创建数字对象
+        return CBORModelCreateNumberFromProperty(model, propertyMeta);
+    }
+    if (propertyMeta->_nsType) {
+        // 原生对象再循环
+        return ((id (*)(id, SEL))(void *) objc_msgSend)((id)model, propertyMeta->_getter);
+    }
+    switch (propertyMeta->_type & CBOREncodingTypeMask) {
+        case CBOREncodingTypeObject:
+            // 对象类型再循环
+            return ((id (*)(id, SEL))(void *) objc_msgSend)((id)model, propertyMeta->_getter);
+        case CBOREncodingTypeClass: {
+            Class v = ((Class (*)(id, SEL))(void *) objc_msgSend)((id)model, propertyMeta->_getter);
+            return v ? NSStringFromClass(v) : nil;
+        }
+        case CBOREncodingTypeSEL: {
+            SEL v = ((SEL (*)(id, SEL))(void *) objc_msgSend)((id)model, propertyMeta->_getter);
+            return v ? NSStringFromSelector(v) : nil;
+        }
+        default:
+            return nil;
+    }
+}
+
 /// 循环模型转CBOR对象
-static CBORObject * CBOREncodeObject(NSObject *model, CBORMajorType major, CBORMinorType minor) {
+static CBORObject * CBOREncodeModel(NSObject *model, CBORMajorType major, CBORMinorType minor, CBOREncodeContext context) {
     if (!model) { return nil; }
     if (model == (id)kCFNull) return [[NSNull null] cborObjectWithMajor:major minor:minor];
     if ([(id<CBOREncodable>)model respondsToSelector:@selector(cborObjectWithMajor:minor:context:)]) {
         return [(id<CBOREncodable>)model cborObjectWithMajor:major
                                                        minor:minor
-                                                     context:CBOREncodeObject];
+                                                     context:context];
     }
     if ([(id<CBOREncodable>)model respondsToSelector:@selector(cborObjectWithMajor:minor:)]) {
         return [(id<CBOREncodable>)model cborObjectWithMajor:major
@@ -52,6 +86,7 @@ static CBORObject * CBOREncodeObject(NSObject *model, CBORMajorType major, CBORM
     CBORModelMeta *modelMeta = [CBORModelMeta metaWithClass:[model class]];
     if (!modelMeta || modelMeta->_keyMappedCount == 0) return nil;
     
+    // 多个属性映射到同一个键时与转JSON一致，保留首个有值的属性
     CBORMap *ret = [[CBORMap alloc] initWithMajor:CBORMajorTypeMap minor:0];
     __unsafe_unretained CBORMap *temp = ret;
     // 遍历属性
@@ -64,36 +99,17 @@ static CBORObject * CBOREncodeObject(NSObject *model, CBORMajorType major, CBORM
         CBORMajorType major = isCustom ? propertyMeta->_major : CBORUnknownMajorType;
         CBORUInt64 minor = isCustom ? propertyMeta->_minor : CBORUnknownMinorType;
         
-        CBORObject *value = nil;
-        if (propertyMeta->_isCNumber) {
-            // 数字类型创建数字对象
-            NSNumber *number = CBORModelCreateNumberFromProperty(model, propertyMeta);
-            value = CBOREncodeObject(number, major, minor);
-        } else if (propertyMeta->_nsType) {
-            // 原生对象再循环
-            id v = ((id (*)(id, SEL))(void *) objc_msgSend)((id)model, propertyMeta->_getter);
-            value = CBOREncodeObject(v, major, minor);
-        } else {
-            switch (propertyMeta->_type & CBOREncodingTypeMask) {
-                case CBOREncodingTypeObject: {
-                    // 对象类型再循环
-                    id v = ((id (*)(id, SEL))(void *) objc_msgSend)((id)model, propertyMeta->_getter);
-                    value = CBOREncodeObject(v, major, minor);
-                } break;
-                case CBOREncodingTypeClass: {
-                    Class v = ((Class (*)(id, SEL))(void *) objc_msgSend)((id)model, propertyMeta->_getter);
-                    value = v ? CBOREncodeObject(NSStringFromClass(v), major, minor) : nil;
-                } break;
-                case CBOREncodingTypeSEL: {
-                    SEL v = ((SEL (*)(id, SEL))(void *) objc_msgSend)((id)model, propertyMeta->_getter);
-                    value = v ? CBOREncodeObject(NSStringFromSelector(v), major, minor) : nil;
-                } break;
-                default: break;
-            }
-        }
+        NSObject *object = CBOREncodePropertyValue(model, propertyMeta);
+        CBORObject *value = object ? context(object, major, minor) : nil;
         if (!value) return;
         
-        if (propertyMeta->_mappedToKeyPath) {
+        if (propertyMeta->_integerKey) {
+            // 整数键替代映射的Key或KeyPath
+            CBORObject *key = [propertyMeta->_integerKey cborObject];
+            if (!key) return;
+            
+            CBORMapSetEntry(temp, key, value, CBORMapDuplicateKeyPolicyFirstWins);
+        } else if (propertyMeta->_mappedToKeyPath) {
             CBORMap *superCBOR = temp;
             CBORObject *subCBOR = nil;
             // 遍历替换的键值路径
@@ -101,21 +117,17 @@ static CBORObject * CBOREncodeObject(NSObject *model, CBORMajorType major, CBORM
                 CBORObject *key = [propertyMeta->_mappedToKeyPath[i] cborObject];
                 
                 if (i + 1 == max) { // end
-                    if (!superCBOR[key]) { superCBOR[key] = value; }
+                    CBORMapSetEntry(superCBOR, key, value, CBORMapDuplicateKeyPolicyFirstWins);
                     break;
                 }
                 
                 subCBOR = superCBOR[key];
                 if (subCBOR) {
-                    if ([subCBOR isKindOfClass:[CBORMap class]]) {
-                        superCBOR[key] = subCBOR;
-                    } else {
-                        // 其他类型则无法进行下一步
-                        break;
-                    }
+                    // 已存在的嵌套字典继续写入，其他类型则无法进行下一步
+                    if (![subCBOR isKindOfClass:[CBORMap class]]) { break; }
                 } else {
                     subCBOR = [[CBORMap alloc] initWithMajor:CBORMajorTypeMap];
-                    superCBOR[key] = subCBOR;
+                    CBORMapSetEntry(superCBOR, key, subCBOR, CBORMapDuplicateKeyPolicyFirstWins);
                 }
                 superCBOR = (CBORMap *)subCBOR;
                 subCBOR = nil;
@@ -124,13 +136,364 @@ static CBORObject * CBOREncodeObject(NSObject *model, CBORMajorType major, CBORM
             CBORObject *key = [propertyMeta->_mappedToKey cborObject];
             if (!key) return;
             
-            [temp setCBOR:value forKey:key];
+            CBORMapSetEntry(temp, key, value, CBORMapDuplicateKeyPolicyFirstWins);
         }
     }];
     
     return ret;
 }
 
+/// 默认编码
+static CBORObject * CBOREncodeObject(NSObject *model, CBORMajorType major, CBORMinorType minor) {
+    return CBOREncodeModel(model, major, minor, CBOREncodeObject);
+}
+
+/// 未指定类型的数值数组在元素类型一致时编码为类型化数组
+static CBORObject * CBOREncodeObjectTypedArrays(NSObject *model, CBORMajorType major, CBORMinorType minor) {
+    if (CBORMajorTypeIsUnknown(major) && [model isKindOfClass:[NSArray class]]) {
+        CBORTypedArray *typedArray = [CBORTypedArray typedArrayWithNumbers:(NSArray *)model];
+        if (typedArray) { return [(id<CBOREncodable>)typedArray cborObjectWithMajor:major minor:minor]; }
+    }
+    return CBOREncodeModel(model, major, minor, CBOREncodeObjectTypedArrays);
+}
+
+
+// MARK: - 写入器
+/// 写入结果，区分两种失败以保持与CBOR对象树编码完全一致的输出
+typedef NS_ENUM(UInt8, CBORWriteResult) {
+    /// 无法编码（对应CBOR对象为空）：数组整体失败，键值对不计入数量
+    CBORWriteResultNone = 0,
+    /// 可构建但无数据（对应`-cborData`为空）：计入容器数量但不写入
+    CBORWriteResultEmpty,
+    /// 已写入
+    CBORWriteResultWritten,
+};
+
+static CBORWriteResult CBOREncodeWrite(CBORWriter *writer, NSObject *model, CBORMajorType major, CBORUInt64 minor, CBOREncodeContext context);
+
+/// 写入单个CBOR对象
+static inline CBORWriteResult CBOREncodeWriteCBOR(CBORWriter *writer, CBORObject *cbor) {
+    if (!cbor) { return CBORWriteResultNone; }
+    return [cbor writeToWriter:writer] ? CBORWriteResultWritten : CBORWriteResultEmpty;
+}
+
+/// 数组直接写入，任一元素无法编码时整体回退
+static CBORWriteResult CBOREncodeWriteArray(CBORWriter *writer, NSArray *array, CBORUInt64 minor, CBOREncodeContext context) {
+    NSUInteger start = writer->length;
+    CBORWriterAppendHeader(writer, CBORMajorTypeArray, minor, [array count], CBORLengthTypeMaxValue);
+    
+    for (NSObject *item in array) {
+        if (!CBOREncodeWrite(writer, item, CBORUnknownMajorType, CBORUnknownMinorType, context)) {
+            CBORWriterTruncate(writer, start);
+            return CBORWriteResultNone;
+        }
+    }
+    return CBORWriteResultWritten;
+}
+
+/// 写入键值对条目，返回是否计入数量
+static inline BOOL CBOREncodeWriteEntry(CBORWriter *writer, NSObject *key, NSObject *value, CBORMajorType major, CBORUInt64 minor, CBOREncodeContext context) {
+    NSUInteger entry = writer->length;
+    CBORWriteResult keyResult = CBOREncodeWrite(writer, key, CBORUnknownMajorType, CBORUnknownMinorType, context);
+    CBORWriteResult valueResult = keyResult ? CBOREncodeWrite(writer, value, major, minor, context) : CBORWriteResultNone;
+    
+    if (keyResult != CBORWriteResultWritten || valueResult != CBORWriteResultWritten) { CBORWriterTruncate(writer, entry); }
+    return keyResult && valueResult;
+}
+
+/// 字典直接写入：按字典数量预写头部，跳过的条目较多时再修正头部
+static CBORWriteResult CBOREncodeWriteDictionary(CBORWriter *writer, NSDictionary *dictionary, CBORUInt64 minor, CBOREncodeContext context) {
+    NSUInteger start = writer->length;
+    NSUInteger count = [dictionary count];
+    NSUInteger headerLength = CBORWriterAppendHeader(writer, CBORMajorTypeMap, minor, count, CBORLengthTypeMaxValue) ? writer->length - start : 0;
+    
+    __block NSUInteger written = 0;
+    [dictionary enumerateKeysAndObjectsUsingBlock:^(id key, id obj, BOOL *stop) {
+        if (CBOREncodeWriteEntry(writer, key, obj, CBORUnknownMajorType, CBORUnknownMinorType, context)) { written++; }
+    }];
+    
+    if (written != count) { CBORWriterReplaceHeader(writer, start, headerLength, CBORMajorTypeMap, minor, written, CBORLengthTypeMaxValue); }
+    return CBORWriteResultWritten;
+}
+
+/// 写入整数，规则与`-[NSNumber cborObject]`一致
+static inline void CBOREncodeWriteInteger(CBORWriter *writer, SInt64 value) {
+    if (value >= 0) {
+        CBORWriterAppendHeader(writer, CBORMajorTypeUnsigned, CBORUnknownMinorType, (UInt64)value, CBORLengthTypeMaxValue);
+    } else {
+        CBORWriterAppendHeader(writer, CBORMajorTypeNegative, CBORUnknownMinorType, ~(UInt64)value, CBORLengthTypeMaxValue);
+    }
+}
+
+/// 写入浮点数，非法值（NaN、无穷）与`CBORModelCreateNumberFromProperty`一致不编码
+static inline CBORWriteResult CBOREncodeWriteFloat(CBORWriter *writer, CBORFloat64 value) {
+    if (isnan(value) || isinf(value)) return CBORWriteResultNone;
+    return CBORNumberWriteFloat(writer, CBORMajorTypeAdditional, check_floating_type(value), value) ? CBORWriteResultWritten : CBORWriteResultEmpty;
+}
+
+/// 标量属性直接读取C数值写入，不装箱为NSNumber，输出与装箱后编码一致
+static CBORWriteResult CBOREncodeWriteScalar(CBORWriter *writer, NSObject *model, SEL getter, CBOREncodingType scalar) {
+    switch (scalar) {
+        case CBOREncodingTypeBool:
+        case CBOREncodingTypeInt8: {
+            // int8装箱后与布尔同为char类型，同样编码为简单值
+            BOOL value = scalar == CBOREncodingTypeBool
+                ? ((bool (*)(id, SEL))(void *) objc_msgSend)((id)model, getter)
+                : ((int8_t (*)(id, SEL))(void *) objc_msgSend)((id)model, getter) != 0;
+            CBORByte byte = CBORMajorTypeAdditional | (value ? CBORAdditionalTypeTrue : CBORAdditionalTypeFalse);
+            CBORWriterAppendBytes(writer, &byte, sizeof(byte));
+            return CBORWriteResultWritten;
+        }
+        case CBOREncodingTypeUInt8:
+            CBOREncodeWriteInteger(writer, ((uint8_t (*)(id, SEL))(void *) objc_msgSend)((id)model, getter));
+            return CBORWriteResultWritten;
+        case CBOREncodingTypeInt16:
+            CBOREncodeWriteInteger(writer, ((int16_t (*)(id, SEL))(void *) objc_msgSend)((id)model, getter));
+            return CBORWriteResultWritten;
+        case CBOREncodingTypeUInt16:
+            CBOREncodeWriteInteger(writer, ((uint16_t (*)(id, SEL))(void *) objc_msgSend)((id)model, getter));
+            return CBORWriteResultWritten;
+        case CBOREncodingTypeInt32:
+            CBOREncodeWriteInteger(writer, ((int32_t (*)(id, SEL))(void *) objc_msgSend)((id)model, getter));
+            return CBORWriteResultWritten;
+        case CBOREncodingTypeUInt32:
+            CBOREncodeWriteInteger(writer, ((uint32_t (*)(id, SEL))(void *) objc_msgSend)((id)model, getter));
+            return CBORWriteResultWritten;
+        case CBOREncodingTypeInt64:
+            CBOREncodeWriteInteger(writer, ((int64_t (*)(id, SEL))(void *) objc_msgSend)((id)model, getter));
+            return CBORWriteResultWritten;
+        case CBOREncodingTypeUInt64: {
+            UInt64 value = ((uint64_t (*)(id, SEL))(void *) objc_msgSend)((id)model, getter);
+            CBORWriterAppendHeader(writer, CBORMajorTypeUnsigned, CBORUnknownMinorType, value, CBORLengthTypeMaxValue);
+            return CBORWriteResultWritten;
+        }
+        case CBOREncodingTypeFloat:
+            return CBOREncodeWriteFloat(writer, ((float (*)(id, SEL))(void *) objc_msgSend)((id)model, getter));
+        case CBOREncodingTypeDouble:
+            return CBOREncodeWriteFloat(writer, ((double (*)(id, SEL))(void *) objc_msgSend)((id)model, getter));
+        case CBOREncodingTypeLongDouble:
+            return CBOREncodeWriteFloat(writer, (double)((long double (*)(id, SEL))(void *) objc_msgSend)((id)model, getter));
+        default:
+            return CBORWriteResultNone;
+    }
+}
+
+/// 按编码计划写入一层键值对（嵌套字典递归写入），返回计入数量的键值对数
+static NSUInteger CBOREncodeWriteSteps(CBORWriter *writer, NSObject *model, const CBORModelEncodeStep *steps, NSUInteger stepCount, const UInt8 *keys, CBOREncodeContext context) {
+    NSUInteger written = 0;
+    for (NSUInteger i = 0; i < stepCount; i += steps[i].span) {
+        const CBORModelEncodeStep *step = &steps[i];
+        NSUInteger entry = writer->length;
+        if (writer->strings && step->stringKey) {
+            CBORWriterAppendString(writer, CBORMajorTypeString, CBORUnknownMinorType, keys + step->keyOffset + step->keyHeaderLength, step->keyLength - step->keyHeaderLength);
+        } else {
+            CBORWriterAppendBytes(writer, keys + step->keyOffset, step->keyLength);
+        }
+        
+        // 键路径的嵌套字典：无任何值时整个不写入
+        if (!step->property) {
+            NSUInteger start = writer->length;
+            NSUInteger headerLength = CBORWriterAppendHeader(writer, CBORMajorTypeMap, 0, step->count, CBORLengthTypeMaxValue) ? writer->length - start : 0;
+            NSUInteger count = CBOREncodeWriteSteps(writer, model, step + 1, step->span - 1, keys, context);
+            if (!count) {
+                CBORWriterTruncate(writer, entry);
+                continue;
+            }
+            if (count != step->count) { CBORWriterReplaceHeader(writer, start, headerLength, CBORMajorTypeMap, 0, count, CBORLengthTypeMaxValue); }
+            written++;
+            continue;
+        }
+        
+        CBORModelPropertyMeta *propertyMeta = step->property;
+        CBORWriteResult result;
+        if (step->scalar) {
+            result = CBOREncodeWriteScalar(writer, model, propertyMeta->_getter, step->scalar);
+        } else {
+            BOOL isCustom = propertyMeta->_isCustomCBORType;
+            CBORMajorType major = isCustom ? propertyMeta->_major : CBORUnknownMajorType;
+            CBORUInt64 minor = isCustom ? propertyMeta->_minor : CBORUnknownMinorType;
+            
+            NSObject *value = CBOREncodePropertyValue(model, propertyMeta);
+            result = value ? CBOREncodeWrite(writer, value, major, minor, context) : CBORWriteResultNone;
+        }
+        
+        // 值可构建但无数据时计入数量而不写入，与CBOR对象树一致
+        if (result != CBORWriteResultWritten) { CBORWriterTruncate(writer, entry); }
+        if (result) { written++; }
+    }
+    return written;
+}
+
+/// 模型按类的编码计划直接写入：键预先编码，标量不装箱，键路径的嵌套结构预先确定；无法预先确定结构时仍构建CBOR对象
+static CBORWriteResult CBOREncodeWriteModel(CBORWriter *writer, NSObject *model, CBORMajorType major, CBORUInt64 minor, CBOREncodeContext context) {
+    CBORModelMeta *modelMeta = [CBORModelMeta metaWithClass:[model class]];
+    if (!modelMeta || modelMeta->_keyMappedCount == 0) return CBORWriteResultNone;
+    if (!modelMeta->_encodeSteps) { return CBOREncodeWriteCBOR(writer, context(model, major, minor)); }
+    
+    NSUInteger start = writer->length;
+    NSUInteger count = modelMeta->_encodeCount;
+    NSUInteger headerLength = CBORWriterAppendHeader(writer, CBORMajorTypeMap, 0, count, CBORLengthTypeMaxValue) ? writer->length - start : 0;
+    
+    NSUInteger written = CBOREncodeWriteSteps(writer, model, modelMeta->_encodeSteps, modelMeta->_encodeStepCount, modelMeta->_encodeKeys.bytes, context);
+    
+    if (written != count) { CBORWriterReplaceHeader(writer, start, headerLength, CBORMajorTypeMap, 0, written, CBORLengthTypeMaxValue); }
+    return CBORWriteResultWritten;
+}
+
+/// 对象直接写入写入器：数组、字典与模型不构建CBOR对象树，其余类型由编码函数构建后写入
+static CBORWriteResult CBOREncodeWrite(CBORWriter *writer, NSObject *model, CBORMajorType major, CBORUInt64 minor, CBOREncodeContext context) {
+    if (!model) { return CBORWriteResultNone; }
+    
+    BOOL unknown = CBORMajorTypeIsUnknown(major);
+    if ([model isKindOfClass:[NSArray class]] || [model isKindOfClass:[NSSet class]]) {
+        if (!unknown && CBORTypeMajor(major) != CBORMajorTypeArray) { return CBOREncodeWriteCBOR(writer, context(model, major, minor)); }
+        
+        NSArray *array = [model isKindOfClass:[NSSet class]] ? [(NSSet *)model allObjects] : (NSArray *)model;
+        if (context == CBOREncodeObjectTypedArrays && unknown && [model isKindOfClass:[NSArray class]]) {
+            CBORTypedArray *typedArray = [CBORTypedArray typedArrayWithNumbers:array];
+            if (typedArray) { return CBOREncodeWriteCBOR(writer, [(id<CBOREncodable>)typedArray cborObjectWithMajor:major minor:minor]); }
+        }
+        return CBOREncodeWriteArray(writer, array, unknown ? CBORUnknownMinorType : minor, context);
+    }
+    if ([model isKindOfClass:[NSDictionary class]]) {
+        if (!unknown && CBORTypeMajor(major) != CBORMajorTypeMap) { return CBOREncodeWriteCBOR(writer, context(model, major, minor)); }
+        
+        return CBOREncodeWriteDictionary(writer, (NSDictionary *)model, minor, context);
+    }
+    
+    // 常见的叶子类型直接写入，不构建CBOR对象
+    if (unknown) {
+        if ([model isKindOfClass:[NSString class]] && CBORWriteString(writer, (NSString *)model)) { return CBORWriteResultWritten; }
+        if ([model isKindOfClass:[NSNumber class]] && CBORWriteNumber(writer, (NSNumber *)model)) { return CBORWriteResultWritten; }
+        if ([model isKindOfClass:[NSDate class]] && CBORWriteDate(writer, (NSDate *)model)) { return CBORWriteResultWritten; }
+    }
+    
+    // 自定义编码的类型（含NSNull）
+    if (model == (id)kCFNull
+        || [(id<CBOREncodable>)model respondsToSelector:@selector(cborObjectWithMajor:minor:context:)]
+        || [(id<CBOREncodable>)model respondsToSelector:@selector(cborObjectWithMajor:minor:)]) {
+        return CBOREncodeWriteCBOR(writer, context(model, major, minor));
+    }
+    
+    return CBOREncodeWriteModel(writer, model, major, minor, context);
+}
+
+/// 写入顶层对象：按编码选项选择编码函数，启用字符串引用时包裹在引用命名空间中
+static CBORWriteResult CBOREncodeWriteRoot(CBORWriter *writer, id object, CBORMajorType major, CBORUInt64 minor, CBOREncodeOptions options) {
+    CBOREncodeContext context = (options & CBOREncodeOptionsTypedArrays) ? CBOREncodeObjectTypedArrays : CBOREncodeObject;
+    if (!(options & CBOREncodeOptionsStringReferences)) { return CBOREncodeWrite(writer, object, major, minor, context); }
+    
+    CBORWriterStrings *outer = CBORWriterBeginStringReferences(writer);
+    CBORWriteResult result = CBOREncodeWrite(writer, object, major, minor, context);
+    CBORWriterEndStringReferences(writer, outer);
+    return result;
+}
+
+/// 对象编码后的字节数：计量模式走完整编码流程，无法编码时返回0
+static NSUInteger CBOREncodeLength(id object, CBORMajorType major, CBORUInt64 minor, CBOREncodeOptions options) {
+    CBORWriter writer;
+    CBORWriterInitMeasuring(&writer);
+    if (CBOREncodeWriteRoot(&writer, object, major, minor, options) != CBORWriteResultWritten) { return 0; }
+    return writer.length;
+}
+
+/// 对象编码为数据：默认单次写入可增长的缓冲区，`CBOREncodeOptionsExactCapacity`时先计量长度，输出缓冲区只分配一次
+static NSData * CBOREncodeData(id object, CBORMajorType major, CBORUInt64 minor, CBOREncodeOptions options) {
+    NSUInteger length = 0;
+    if (options & CBOREncodeOptionsExactCapacity) {
+        length = CBOREncodeLength(object, major, minor, options);
+        if (!length) { return nil; }
+    }
+    
+    CBORWriter writer;
+    CBORWriterInit(&writer, length);
+    if (CBOREncodeWriteRoot(&writer, object, major, minor, options) != CBORWriteResultWritten) {
+        CBORWriterDispose(&writer);
+        return nil;
+    }
+    return CBORWriterFinish(&writer);
+}
+
+/// 并行编码的最少元素数量，元素过少时线程调度开销大于收益
+static const NSUInteger CBOREncodeConcurrentMinimumCount = 256;
+/// 并行编码每个任务的最少元素数量
+static const NSUInteger CBOREncodeConcurrentMinimumChunk = 64;
+
+/// 按顺序写入元素
+/// - Parameter sequence: 为CBOR序列时每个元素须有数据；为数组时与`CBOREncodeWriteArray`一致，仅无法编码的元素导致失败
+static BOOL CBOREncodeWriteElements(CBORWriter *writer, NSArray *objects, NSRange range, BOOL sequence) {
+    for (NSUInteger index = range.location, end = NSMaxRange(range); index < end; index++) {
+        CBORWriteResult result = CBOREncodeWrite(writer, objects[index], CBORUnknownMajorType, CBORUnknownMinorType, CBOREncodeObject);
+        if (sequence ? result != CBORWriteResultWritten : !result) { return NO; }
+    }
+    return !writer->failed;
+}
+
+/// 元素列表编码为定长数组或CBOR序列：元素分块由多个线程各自写入独立的写入器，再按顺序拼接，输出与顺序编码一致
+static NSData * CBOREncodeDataWithElements(NSArray *objects, BOOL sequence, BOOL parallel) {
+    NSUInteger count = [objects count];
+    
+    if (!parallel || count < CBOREncodeConcurrentMinimumCount) {
+        if (!sequence) { return CBOREncodeData(objects, CBORUnknownMajorType, CBORUnknownMinorType, CBOREncodeOptionsNone); }
+        
+        CBORWriter writer;
+        CBORWriterInit(&writer, 0);
+        if (!CBOREncodeWriteElements(&writer, objects, NSMakeRange(0, count), YES)) {
+            CBORWriterDispose(&writer);
+            return nil;
+        }
+        return CBORWriterFinish(&writer);
+    }
+    
+    NSUInteger workers = MAX([[NSProcessInfo processInfo] activeProcessorCount], 1);
+    NSUInteger chunk = MAX(count / (workers * 4), CBOREncodeConcurrentMinimumChunk);
+    NSUInteger chunks = (count + chunk - 1) / chunk;
+    CBORWriter *writers = calloc(chunks, sizeof(CBORWriter));
+    BOOL *succeeded = calloc(chunks, sizeof(BOOL));
+    if (!writers || !succeeded) {
+        free(writers);
+        free(succeeded);
+        return nil;
+    }
+    
+    dispatch_apply(chunks, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t index) {
+        @autoreleasepool {
+            NSRange range = NSMakeRange(index * chunk, MIN(chunk, count - index * chunk));
+            CBORWriterInit(&writers[index], 0);
+            succeeded[index] = CBOREncodeWriteElements(&writers[index], objects, range, sequence);
+        }
+    });
+    
+    // 按顺序拼接：数组头部在前，输出缓冲区一次分配
+    UInt8 header[CBORWriterMaxHeaderLength];
+    NSUInteger headerLength = sequence ? 0 : CBORWriterHeaderBytes(header, CBORMajorTypeArray, CBORUnknownMinorType, count, CBORLengthTypeMaxValue);
+    NSUInteger length = headerLength;
+    BOOL valid = YES;
+    for (NSUInteger index = 0; index < chunks; index++) {
+        valid = valid && succeeded[index];
+        length += writers[index].length;
+    }
+    
+    NSData *ret = nil;
+    if (valid) {
+        CBORWriter writer;
+        CBORWriterInit(&writer, length);
+        CBORWriterAppendBytes(&writer, header, headerLength);
+        for (NSUInteger index = 0; index < chunks; index++) {
+            CBORWriterAppendBytes(&writer, writers[index].bytes, writers[index].length);
+        }
+        ret = CBORWriterFinish(&writer);
+    }
+    
+    for (NSUInteger index = 0; index < chunks; index++) {
+        CBORWriterDispose(&writers[index]);
+    }
+    free(writers);
+    free(succeeded);
+    return ret;
+}
+
+
 @implementation CBOREncoder
 
 + (CBORObject *)encodeObject:(id)object
@@ -141,4 +504,47 @@ static CBORObject * CBOREncodeObject(NSObject *model, CBORMajorType major, CBORM
     return ret;
 }
 
++ (CBORObject *)encodeObject:(id)object
+                       major:(CBORMajorType)major
+                       minor:(CBORUInt64)minor
+                     options:(CBOREncodeOptions)options {
+    if (options & CBOREncodeOptionsTypedArrays) {
+        return CBOREncodeObjectTypedArrays(object, major, minor);
+    }
+    return CBOREncodeObject(object, major, minor);
+}
+
++ (NSData *)encodeDataWithObject:(id)object
+                           major:(CBORMajorType)major
+                           minor:(CBORUInt64)minor
+                         options:(CBOREncodeOptions)options {
+    return CBOREncodeData(object, major, minor, options);
+}
+
++ (BOOL)writeObject:(id)object
+              major:(CBORMajorType)major
+              minor:(CBORUInt64)minor
+            options:(CBOREncodeOptions)options
+           toWriter:(CBORWriter *)writer {
+    NSUInteger start = writer->length;
+    if (CBOREncodeWriteRoot(writer, object, major, minor, options) != CBORWriteResultWritten) {
+        CBORWriterTruncate(writer, start);
+        return NO;
+    }
+    return YES;
+}
+
++ (NSData *)encodeDataWithObjects:(NSArray *)objects
+                         sequence:(BOOL)sequence
+                         parallel:(BOOL)parallel {
+    return CBOREncodeDataWithElements([objects copy], sequence, parallel);
+}
+
++ (NSUInteger)encodedLengthOfObject:(id)object
+                              major:(CBORMajorType)major
+                              minor:(CBORUInt64)minor
+                            options:(CBOREncodeOptions)options {
+    return CBOREncodeLength(object, major, minor, options);
+}
+
 @end
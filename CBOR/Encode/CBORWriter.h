@@ -0,0 +1,186 @@
+// refer: https://github.com/DanielHusx/CBOR
+//
+// MIT License
+//
+// Copyright (c) 2024 Daniel
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "CBORConstant.h"
+#import "CBORUtils.h"
+
+/// 头部最大字节数：首字节 + 8字节参数
+#define CBORWriterMaxHeaderLength 9
+
+/// 数据写入器：所有头部与内容直接追加到同一块连续内存，按倍数扩容，编码过程不产生中间数据对象
+///
+/// 计量模式下不分配内存，只累加长度：与实际写入走同一编码流程，得到的长度与输出完全一致
+typedef struct CBORWriterStrings CBORWriterStrings;
+
+typedef struct {
+    /// 缓冲区首地址
+    UInt8 *bytes;
+    /// 已写入长度
+    NSUInteger length;
+    /// 缓冲区容量
+    NSUInteger capacity;
+    /// 内存分配失败，后续写入均被忽略
+    BOOL failed;
+    /// 仅计量长度
+    BOOL measuring;
+    /// 字符串引用表，为NULL时不启用字符串引用
+    CBORWriterStrings *strings;
+} CBORWriter;
+
+/// 初始化写入器
+/// - Parameter capacity: 初始容量，为0时首次写入再分配；已知编码长度时一次分配，不再扩容
+FOUNDATION_EXTERN void CBORWriterInit(CBORWriter *writer, NSUInteger capacity);
+/// 初始化计量模式的写入器
+FOUNDATION_EXTERN void CBORWriterInitMeasuring(CBORWriter *writer);
+/// 扩容至至少可再写入`length`字节
+FOUNDATION_EXTERN BOOL CBORWriterGrow(CBORWriter *writer, NSUInteger length);
+/// 结束写入，缓冲区转交给返回的数据对象（不拷贝）；分配失败时返回nil
+FOUNDATION_EXTERN NSData * CBORWriterFinish(CBORWriter *writer);
+/// 释放缓冲区
+FOUNDATION_EXTERN void CBORWriterDispose(CBORWriter *writer);
+
+/// 清空已写入的内容，保留缓冲区供下次写入复用
+static inline void CBORWriterReset(CBORWriter *writer) {
+    writer->length = 0;
+    writer->failed = NO;
+}
+
+/// 开始字符串引用命名空间：写入命名空间标记，之后的定长字符串经引用表写入
+/// - Returns: 外层的引用表，结束时交给`CBORWriterEndStringReferences`恢复
+FOUNDATION_EXTERN CBORWriterStrings * CBORWriterBeginStringReferences(CBORWriter *writer);
+/// 结束字符串引用命名空间，释放引用表并恢复外层的引用表
+FOUNDATION_EXTERN void CBORWriterEndStringReferences(CBORWriter *writer, CBORWriterStrings *outer);
+/// 回退引用表：移除在指定长度之后写入的字符串
+FOUNDATION_EXTERN void CBORWriterTruncateStrings(CBORWriter *writer, NSUInteger length);
+/// 写入定长字符串（文本或字节数组）；启用字符串引用时，已在引用表中的字符串写为引用
+/// - Returns: 次要类型非法时不写入并返回NO
+FOUNDATION_EXTERN BOOL CBORWriterAppendString(CBORWriter *writer,
+                                              CBORMajorType major,
+                                              CBORMinorType minor,
+                                              const void *bytes,
+                                              NSUInteger length);
+
+/// 追加字节
+static inline void CBORWriterAppendBytes(CBORWriter *writer, const void *bytes, NSUInteger length) {
+    if (!length) return;
+    if (writer->measuring) {
+        writer->length += length;
+        return;
+    }
+    if (length > writer->capacity - writer->length && !CBORWriterGrow(writer, length)) return;
+    memcpy(writer->bytes + writer->length, bytes, length);
+    writer->length += length;
+}
+
+/// 预留字节供调用方直接写入（避免先生成中间数据再拷贝）
+/// - Returns: 写入位置；计量模式或分配失败时返回NULL，长度仍按预留累加
+static inline UInt8 *CBORWriterReserve(CBORWriter *writer, NSUInteger length) {
+    if (writer->measuring) {
+        writer->length += length;
+        return NULL;
+    }
+    if (length > writer->capacity - writer->length && !CBORWriterGrow(writer, length)) return NULL;
+    UInt8 *bytes = writer->bytes + writer->length;
+    writer->length += length;
+    return bytes;
+}
+
+/// 回退到指定长度，丢弃之后写入的内容
+static inline void CBORWriterTruncate(CBORWriter *writer, NSUInteger length) {
+    if (length >= writer->length) return;
+    writer->length = length;
+    if (writer->strings) CBORWriterTruncateStrings(writer, length);
+}
+
+/// 构建头部字节，规则与`-[CBORObject dataWithLengthOrValue:...]`一致
+/// - Parameters:
+///   - header: 输出头部字节，至少`CBORWriterMaxHeaderLength`字节
+///   - major: 主要类型
+///   - minor: 次要类型（指定的最小长度类型）
+///   - lengthOrValue: 长度或者就是值
+///   - minorMaxValue: 次要类型单字节后五位最大可表示的值
+/// - Returns: 头部字节数；次要类型非法时返回0
+static inline NSUInteger CBORWriterHeaderBytes(UInt8 *header,
+                                               CBORMajorType major,
+                                               CBORMinorType minor,
+                                               CBORUInt64 lengthOrValue,
+                                               CBORByte minorMaxValue) {
+    /// 此处长度类型即次要类型
+    CBORLengthType minorType = CBORLengthTypeWithLengthOrMinor(lengthOrValue, minorMaxValue, minor);
+    if (!CBORIsLengthTypeValid(minor)) { return 0; }
+    
+    header[0] = major | minorType;
+    switch (minorType) {
+        case CBORLengthTypeUInt8: {
+            header[1] = (UInt8)lengthOrValue;
+            return 2;
+        }
+        case CBORLengthTypeUInt16: {
+            UInt16 value = CFSwapInt16HostToBig((UInt16)lengthOrValue);
+            memcpy(header + 1, &value, sizeof(value));
+            return 1 + sizeof(value);
+        }
+        case CBORLengthTypeUInt32: {
+            UInt32 value = CFSwapInt32HostToBig((UInt32)lengthOrValue);
+            memcpy(header + 1, &value, sizeof(value));
+            return 1 + sizeof(value);
+        }
+        case CBORLengthTypeUInt64: {
+            UInt64 value = CFSwapInt64HostToBig(lengthOrValue);
+            memcpy(header + 1, &value, sizeof(value));
+            return 1 + sizeof(value);
+        }
+        default:
+            return 1;
+    }
+}
+
+/// 追加头部
+/// - Returns: 次要类型非法时不写入并返回NO
+static inline BOOL CBORWriterAppendHeader(CBORWriter *writer,
+                                          CBORMajorType major,
+                                          CBORMinorType minor,
+                                          CBORUInt64 lengthOrValue,
+                                          CBORByte minorMaxValue) {
+    UInt8 header[CBORWriterMaxHeaderLength];
+    NSUInteger length = CBORWriterHeaderBytes(header, major, minor, lengthOrValue, minorMaxValue);
+    if (!length) { return NO; }
+    
+    CBORWriterAppendBytes(writer, header, length);
+    return YES;
+}
+
+/// 替换已写入的头部（容器实际元素数量与预估不同时），头部长度变化时移动其后的内容
+/// - Parameters:
+///   - offset: 头部起始位置
+///   - headerLength: 原头部字节数
+FOUNDATION_EXTERN void CBORWriterReplaceHeader(CBORWriter *writer,
+                                               NSUInteger offset,
+                                               NSUInteger headerLength,
+                                               CBORMajorType major,
+                                               CBORMinorType minor,
+                                               CBORUInt64 lengthOrValue,
+                                               CBORByte minorMaxValue);
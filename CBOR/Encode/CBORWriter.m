@@ -0,0 +1,220 @@
+// refer: https://github.com/DanielHusx/CBOR
+//
+// MIT License
+//
+// Copyright (c) 2024 Daniel
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import "CBORWriter.h"
+
+/// 首次分配的最小容量
+#define CBORWriterMinCapacity 64
+
+void CBORWriterInit(CBORWriter *writer, NSUInteger capacity) {
+    writer->bytes = capacity ? malloc(capacity) : NULL;
+    writer->length = 0;
+    writer->capacity = writer->bytes ? capacity : 0;
+    writer->failed = capacity && !writer->bytes;
+    writer->measuring = NO;
+    writer->strings = NULL;
+}
+
+void CBORWriterInitMeasuring(CBORWriter *writer) {
+    CBORWriterInit(writer, 0);
+    writer->measuring = YES;
+}
+
+BOOL CBORWriterGrow(CBORWriter *writer, NSUInteger length) {
+    if (writer->failed) { return NO; }
+    if (length > NSUIntegerMax - writer->length) { writer->failed = YES; return NO; }
+    
+    NSUInteger required = writer->length + length;
+    NSUInteger capacity = MAX(writer->capacity, CBORWriterMinCapacity);
+    while (capacity < required) {
+        capacity = capacity > NSUIntegerMax / 2 ? required : capacity * 2;
+    }
+    
+    UInt8 *bytes = realloc(writer->bytes, capacity);
+    if (!bytes) { writer->failed = YES; return NO; }
+    
+    writer->bytes = bytes;
+    writer->capacity = capacity;
+    return YES;
+}
+
+NSData * CBORWriterFinish(CBORWriter *writer) {
+    if (writer->failed) {
+        CBORWriterDispose(writer);
+        return nil;
+    }
+    if (!writer->length) {
+        CBORWriterDispose(writer);
+        return [NSData data];
+    }
+    
+    // 缓冲区直接转交，不再拷贝
+    NSData *ret = [[NSData alloc] initWithBytesNoCopy:writer->bytes length:writer->length freeWhenDone:YES];
+    writer->bytes = NULL;
+    writer->length = 0;
+    writer->capacity = 0;
+    return ret;
+}
+
+void CBORWriterDispose(CBORWriter *writer) {
+    free(writer->bytes);
+    writer->bytes = NULL;
+    writer->length = 0;
+    writer->capacity = 0;
+}
+
+// MARK: - 字符串引用
+/// 字符串引用表：按写入顺序记录字符串及其写入位置，内容回退时一并移除
+struct CBORWriterStrings {
+    /// 主要类型与内容 → 下标
+    CFMutableDictionaryRef indexes;
+    /// 按下标排列的键
+    CFMutableArrayRef keys;
+    /// 按下标排列的写入位置
+    NSUInteger *offsets;
+    /// `offsets`容量
+    NSUInteger capacity;
+};
+
+CBORWriterStrings * CBORWriterBeginStringReferences(CBORWriter *writer) {
+    CBORWriterStrings *outer = writer->strings;
+    CBORWriterAppendHeader(writer, CBORMajorTypeTag, 0, CBORTagTypeStringReferenceNamespace, CBORLengthTypeMaxValue);
+    
+    CBORWriterStrings *strings = calloc(1, sizeof(CBORWriterStrings));
+    if (!strings) {
+        writer->failed = YES;
+        return outer;
+    }
+    strings->indexes = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &kCFTypeDictionaryKeyCallBacks, NULL);
+    strings->keys = CFArrayCreateMutable(kCFAllocatorDefault, 0, &kCFTypeArrayCallBacks);
+    writer->strings = strings;
+    return outer;
+}
+
+void CBORWriterEndStringReferences(CBORWriter *writer, CBORWriterStrings *outer) {
+    CBORWriterStrings *strings = writer->strings;
+    if (strings && strings != outer) {
+        CFRelease(strings->indexes);
+        CFRelease(strings->keys);
+        free(strings->offsets);
+        free(strings);
+    }
+    writer->strings = outer;
+}
+
+void CBORWriterTruncateStrings(CBORWriter *writer, NSUInteger length) {
+    CBORWriterStrings *strings = writer->strings;
+    CFIndex count = CFArrayGetCount(strings->keys);
+    while (count && strings->offsets[count - 1] >= length) {
+        count--;
+        CFDictionaryRemoveValue(strings->indexes, CFArrayGetValueAtIndex(strings->keys, count));
+        CFArrayRemoveValueAtIndex(strings->keys, count);
+    }
+}
+
+BOOL CBORWriterAppendString(CBORWriter *writer, CBORMajorType major, CBORMinorType minor, const void *bytes, NSUInteger length) {
+    CBORWriterStrings *strings = writer->strings;
+    // 短于最短引用的字符串不会编入引用表
+    if (!strings || length < CBORStringReferenceMinLength(0)) {
+        if (!CBORWriterAppendHeader(writer, major, minor, length, CBORLengthTypeMaxValue)) { return NO; }
+        CBORWriterAppendBytes(writer, bytes, length);
+        return YES;
+    }
+    
+    // 文本与字节数组共用引用表，键带上主要类型加以区分
+    CFMutableDataRef key = CFDataCreateMutable(kCFAllocatorDefault, 1 + length);
+    CBORByte type = major;
+    CFDataAppendBytes(key, &type, 1);
+    CFDataAppendBytes(key, bytes, length);
+    
+    const void *value = NULL;
+    if (CFDictionaryGetValueIfPresent(strings->indexes, key, &value)) {
+        CFRelease(key);
+        CBORWriterAppendHeader(writer, CBORMajorTypeTag, 0, CBORTagTypeStringReference, CBORLengthTypeMaxValue);
+        CBORWriterAppendHeader(writer, CBORMajorTypeUnsigned, CBORUnknownMinorType, (uintptr_t)value, CBORLengthTypeMaxValue);
+        return YES;
+    }
+    
+    NSUInteger offset = writer->length;
+    if (!CBORWriterAppendHeader(writer, major, minor, length, CBORLengthTypeMaxValue)) {
+        CFRelease(key);
+        return NO;
+    }
+    CBORWriterAppendBytes(writer, bytes, length);
+    
+    NSUInteger index = CFArrayGetCount(strings->keys);
+    if (length >= CBORStringReferenceMinLength(index)) {
+        if (index == strings->capacity) {
+            NSUInteger capacity = strings->capacity ? strings->capacity * 2 : 16;
+            NSUInteger *offsets = realloc(strings->offsets, capacity * sizeof(NSUInteger));
+            if (!offsets) {
+                CFRelease(key);
+                writer->failed = YES;
+                return YES;
+            }
+            strings->offsets = offsets;
+            strings->capacity = capacity;
+        }
+        strings->offsets[index] = offset;
+        CFArrayAppendValue(strings->keys, key);
+        CFDictionarySetValue(strings->indexes, key, (const void *)(uintptr_t)index);
+    }
+    CFRelease(key);
+    return YES;
+}
+
+
+void CBORWriterReplaceHeader(CBORWriter *writer,
+                             NSUInteger offset,
+                             NSUInteger headerLength,
+                             CBORMajorType major,
+                             CBORMinorType minor,
+                             CBORUInt64 lengthOrValue,
+                             CBORByte minorMaxValue) {
+    if (writer->failed) { return; }
+    
+    UInt8 header[CBORWriterMaxHeaderLength];
+    NSUInteger length = CBORWriterHeaderBytes(header, major, minor, lengthOrValue, minorMaxValue);
+    // 其后的字符串随内容移动，引用表中的位置同步修正
+    if (length != headerLength && writer->strings) {
+        CBORWriterStrings *strings = writer->strings;
+        for (CFIndex index = CFArrayGetCount(strings->keys) - 1; index >= 0 && strings->offsets[index] > offset; index--) {
+            strings->offsets[index] = strings->offsets[index] - headerLength + length;
+        }
+    }
+    if (writer->measuring) {
+        writer->length = writer->length - headerLength + length;
+        return;
+    }
+    NSUInteger contentOffset = offset + headerLength;
+    NSUInteger contentLength = writer->length - contentOffset;
+    
+    if (length > headerLength && !CBORWriterGrow(writer, length - headerLength)) { return; }
+    if (length != headerLength) {
+        memmove(writer->bytes + offset + length, writer->bytes + contentOffset, contentLength);
+        writer->length = offset + length + contentLength;
+    }
+    if (length) { memcpy(writer->bytes + offset, header, length); }
+}
@@ -88,7 +88,7 @@
         CBORObject *cbor = context(item, CBORUnknownMajorType, CBORUnknownMinorType);
         if (!cbor) { return nil; }
         
-        [ret addCBOR:cbor];
+        CBORArrayAppend(ret, cbor);
     }
     
     return ret;
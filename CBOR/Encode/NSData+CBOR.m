@@ -26,6 +26,7 @@
 #import "NSData+CBOR.h"
 #import "CBORArray.h"
 #import "CBORTag.h"
+#import "CBORTypedArray.h"
 
 @implementation NSData (CBOR)
 
@@ -61,8 +62,17 @@
                                                       tag:tag
                                                     value:value];
                 }
-                default:
-                    return nil;
+                default: {
+                    // 类型化数组：数据需已按标记的字节序排列
+                    if (![CBORTypedArray isTypedArrayTag:tag]) { return nil; }
+                    
+                    CBORObject *value = [[CBORArray alloc] initWithMajor:CBORMajorTypeBytes
+                                                                   minor:minorType
+                                                                   value:self];
+                    return [[CBORTag alloc] initWithMajor:majorType
+                                                      tag:tag
+                                                    value:value];
+                }
             }
         }
         default:
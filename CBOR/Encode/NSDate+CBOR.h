@@ -24,6 +24,7 @@
 //
 
 #import "CBOREncodable.h"
+#import "CBORWriter.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -31,5 +32,7 @@ NS_ASSUME_NONNULL_BEGIN
 
 @end
 
+/// 时间直接写入，编码与`-[NSDate cborObject]`一致
+FOUNDATION_EXPORT BOOL CBORWriteDate(CBORWriter *writer, NSDate *date);
 
 NS_ASSUME_NONNULL_END
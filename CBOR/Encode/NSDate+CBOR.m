@@ -36,6 +36,15 @@ static inline bool CBORIsInteger(float value) {
     return intValue == value;
 }
 
+BOOL CBORWriteDate(CBORWriter *writer, NSDate *date) {
+    NSTimeInterval interval = [date timeIntervalSince1970];
+    CBORWriterAppendHeader(writer, CBORMajorTypeTag, 0, CBORTagTypeEpochBasedDateTime, CBORLengthTypeMaxValue);
+    if (CBORIsInteger(interval)) {
+        return CBORWriterAppendHeader(writer, CBORMajorTypeUnsigned, CBORUnknownMinorType, (CBORUInt64)interval, CBORLengthTypeMaxValue);
+    }
+    return CBORNumberWriteFloat(writer, CBORMajorTypeAdditional, CBORAdditionalTypeDouble, interval);
+}
+
 @implementation NSDate (CBOR)
 
 - (nullable CBORObject *)cborObject {
@@ -70,7 +70,7 @@
         CBORObject *cborValue = context(obj, CBORUnknownMajorType, CBORUnknownMinorType);
         if (!cborValue) return;
         
-        ret[cborKey] = cborValue;
+        CBORMapSetEntry(ret, cborKey, cborValue, CBORMapDuplicateKeyPolicyLastWins);
     }];
     
     return ret;
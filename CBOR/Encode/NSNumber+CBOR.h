@@ -24,6 +24,7 @@
 //
 
 #import "CBOREncodable.h"
+#import "CBORWriter.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -32,4 +33,8 @@ NS_ASSUME_NONNULL_BEGIN
 
 @end
 
+/// 数字直接写入，编码与`-[NSNumber cborObject]`一致
+/// - Returns: 无法识别数值类型时不写入并返回NO
+FOUNDATION_EXPORT BOOL CBORWriteNumber(CBORWriter *writer, NSNumber *number);
+
 NS_ASSUME_NONNULL_END
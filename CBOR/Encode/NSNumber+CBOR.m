@@ -27,6 +27,7 @@
 #import "CBORNumber.h"
 #import "CBORSimple.h"
 #import "CBORTag.h"
+#import <objc/runtime.h>
 
 /// NSNumber内值编码类型
 typedef NS_ENUM(NSUInteger, CBORNumberEncodingType) {
@@ -58,36 +59,57 @@ typedef NS_ENUM(NSUInteger, CBORNumberEncodingType) {
     CBORNumberEncodingTypeDouble,
 };
 
-/// 读取NSNumber内的值类型
-static CBORNumberEncodingType CBORNumberEncodingTypeWithNumber(NSNumber *number) {
-    NSString *typeString = [NSString stringWithFormat:@"%s", [number objCType]];
+/// 读取NSNumber内的值类型：按类型编码字符判断，不生成中间字符串
+///
+/// `long`与`long long`、`unsigned long`与`unsigned long long`在64位下编码相同，均按长整型处理
+static inline CBORNumberEncodingType CBORNumberEncodingTypeWithNumber(NSNumber *number) {
+    const char *type = [number objCType];
+    if (!type || type[0] == '\0' || type[1] != '\0') { return CBORNumberEncodingTypeUnknown; }
     
-    static NSDictionary *typeMap;
-    static dispatch_once_t onceToken;
-    dispatch_once(&onceToken, ^{
-        typeMap = @{
-            [NSString stringWithFormat:@"%s", @encode(char)]: @(CBORNumberEncodingTypeCharOrBool),
-            [NSString stringWithFormat:@"%s", @encode(unsigned char)]: @(CBORNumberEncodingTypeUnsignedChar),
-            
-            [NSString stringWithFormat:@"%s", @encode(short)]: @(CBORNumberEncodingTypeShort),
-            [NSString stringWithFormat:@"%s", @encode(unsigned short)]: @(CBORNumberEncodingTypeUnsignedShort),
-            
-            [NSString stringWithFormat:@"%s", @encode(int)]: @(CBORNumberEncodingTypeInt),
-            [NSString stringWithFormat:@"%s", @encode(unsigned int)]: @(CBORNumberEncodingTypeUnsignedInt),
-            
-            [NSString stringWithFormat:@"%s", @encode(long)]: @(CBORNumberEncodingTypeLong),
-            [NSString stringWithFormat:@"%s", @encode(unsigned long)]: @(CBORNumberEncodingTypeUnsignedLong),
-            
-            [NSString stringWithFormat:@"%s", @encode(float)]: @(CBORNumberEncodingTypeFloat),
-            [NSString stringWithFormat:@"%s", @encode(double)]: @(CBORNumberEncodingTypeDouble),
-            
-        };
-    });
-    
-    NSNumber *type = typeMap[typeString];
-    if (type) { return [type unsignedLongValue]; }
-    
-    return CBORNumberEncodingTypeUnknown;
+    switch (type[0]) {
+        case _C_CHR: return CBORNumberEncodingTypeCharOrBool;
+        case _C_UCHR: return CBORNumberEncodingTypeUnsignedChar;
+        case _C_SHT: return CBORNumberEncodingTypeShort;
+        case _C_USHT: return CBORNumberEncodingTypeUnsignedShort;
+        case _C_INT: return CBORNumberEncodingTypeInt;
+        case _C_UINT: return CBORNumberEncodingTypeUnsignedInt;
+        case _C_LNG:
+        case _C_LNG_LNG: return CBORNumberEncodingTypeLong;
+        case _C_ULNG:
+        case _C_ULNG_LNG: return CBORNumberEncodingTypeUnsignedLong;
+        case _C_FLT: return CBORNumberEncodingTypeFloat;
+        case _C_DBL: return CBORNumberEncodingTypeDouble;
+        default: return CBORNumberEncodingTypeUnknown;
+    }
+}
+
+BOOL CBORWriteNumber(CBORWriter *writer, NSNumber *number) {
+    switch (CBORNumberEncodingTypeWithNumber(number)) {
+        case CBORNumberEncodingTypeUnknown:
+            return NO;
+        case CBORNumberEncodingTypeFloat:
+        case CBORNumberEncodingTypeDouble: {
+            double value = [number doubleValue];
+            return CBORNumberWriteFloat(writer, CBORMajorTypeAdditional, check_floating_type(value), value);
+        }
+        case CBORNumberEncodingTypeCharOrBool: {
+            CBORByte byte = CBORMajorTypeAdditional | ([number boolValue] ? CBORAdditionalTypeTrue : CBORAdditionalTypeFalse);
+            CBORWriterAppendBytes(writer, &byte, sizeof(byte));
+            return YES;
+        }
+        case CBORNumberEncodingTypeUnsignedChar:
+        case CBORNumberEncodingTypeUnsignedShort:
+        case CBORNumberEncodingTypeUnsignedInt:
+        case CBORNumberEncodingTypeUnsignedLong:
+            return CBORWriterAppendHeader(writer, CBORMajorTypeUnsigned, CBORUnknownMinorType, [number unsignedLongLongValue], CBORLengthTypeMaxValue);
+        default: {
+            SInt64 value = [number longLongValue];
+            if (value >= 0) {
+                return CBORWriterAppendHeader(writer, CBORMajorTypeUnsigned, CBORUnknownMinorType, (UInt64)value, CBORLengthTypeMaxValue);
+            }
+            return CBORWriterAppendHeader(writer, CBORMajorTypeNegative, CBORUnknownMinorType, ~(UInt64)value, CBORLengthTypeMaxValue);
+        }
+    }
 }
 
 
@@ -106,21 +128,21 @@ static CBORNumberEncodingType CBORNumberEncodingTypeWithNumber(NSNumber *number)
         case CBORMajorTypeUnsigned: {
             // 正整数
             UInt64 value = [self unsignedLongLongValue];
-            return [[CBORNumber alloc] initWithMajor:majorType
-                                               minor:minor
-                                       unsignedValue:value];
+            return [CBORNumber numberWithMajor:majorType
+                                         minor:minor
+                                 unsignedValue:value];
         case CBORMajorTypeNegative: {
             UInt64 value = [self unsignedLongLongValue];
             
             if ([self longLongValue] >= 0) {
                 // 正整数
-                return [[CBORNumber alloc] initWithMajor:CBORMajorTypeUnsigned
-                                           unsignedValue:value];
+                return [CBORNumber numberWithMajor:CBORMajorTypeUnsigned
+                                     unsignedValue:value];
             } else {
                 // 负整数
                 value = ~value;
-                return [[CBORNumber alloc] initWithMajor:CBORMajorTypeNegative
-                                           unsignedValue:value];
+                return [CBORNumber numberWithMajor:CBORMajorTypeNegative
+                                     unsignedValue:value];
             }
         }
         case CBORMajorTypeAdditional: {
@@ -130,8 +152,7 @@ static CBORNumberEncodingType CBORNumberEncodingTypeWithNumber(NSNumber *number)
                 case CBORAdditionalTypeTrue:
                 case CBORAdditionalTypeFalse:
                     // 布尔
-                    return [[CBORSimple alloc] initWithMajor:majorType
-                                                       minor:[self boolValue] ? CBORAdditionalTypeTrue: CBORAdditionalTypeFalse];
+                    return [self boolValue] ? [CBORSimple cborYES] : [CBORSimple cborNO];
                 case CBORAdditionalTypeHalf:
                 case CBORAdditionalTypeFloat:
                     return [[CBORNumber alloc] initWithMajor:majorType
@@ -183,31 +204,30 @@ static CBORNumberEncodingType CBORNumberEncodingTypeWithNumber(NSNumber *number)
             return [[CBORNumber alloc] initWithMajor:CBORMajorTypeAdditional
                                           floatValue:[self doubleValue]];
         case CBORNumberEncodingTypeCharOrBool:
-            return [[CBORSimple alloc] initWithMajor:CBORMajorTypeAdditional
-                                               minor:[self boolValue] ? CBORAdditionalTypeTrue: CBORAdditionalTypeFalse];
+            return [self boolValue] ? [CBORSimple cborYES] : [CBORSimple cborNO];
         case CBORNumberEncodingTypeUnsignedChar:
         case CBORNumberEncodingTypeUnsignedShort:
         case CBORNumberEncodingTypeUnsignedInt:
         case CBORNumberEncodingTypeUnsignedLong: {
             // 正整数
             UInt64 value = [self unsignedLongLongValue];
-            return [[CBORNumber alloc] initWithMajor:CBORMajorTypeUnsigned
-                                               minor:minor
-                                       unsignedValue:value];
+            return [CBORNumber numberWithMajor:CBORMajorTypeUnsigned
+                                         minor:minor
+                                 unsignedValue:value];
         }
         default: {
             UInt64 value = [self unsignedLongLongValue];
             if ([self longLongValue] >= 0) {
                 // 正整数
-                return [[CBORNumber alloc] initWithMajor:CBORMajorTypeUnsigned
-                                                   minor:minor
-                                           unsignedValue:value];
+                return [CBORNumber numberWithMajor:CBORMajorTypeUnsigned
+                                             minor:minor
+                                     unsignedValue:value];
             } else {
                 // 负整数
                 value = ~value;
-                return [[CBORNumber alloc] initWithMajor:CBORMajorTypeNegative
-                                                   minor:minor
-                                           unsignedValue:value];
+                return [CBORNumber numberWithMajor:CBORMajorTypeNegative
+                                             minor:minor
+                                     unsignedValue:value];
             }
         }
         
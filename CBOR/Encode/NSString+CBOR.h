@@ -24,6 +24,7 @@
 //
 
 #import "CBOREncodable.h"
+#import "CBORWriter.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -39,4 +40,8 @@ NS_ASSUME_NONNULL_BEGIN
 
 @end
 
+/// 字符串直接写入，编码与`-[NSString cborObject]`一致，UTF-8字节直接写入缓冲区
+/// - Returns: 无法转为UTF-8时不写入并返回NO
+FOUNDATION_EXPORT BOOL CBORWriteString(CBORWriter *writer, NSString *string);
+
 NS_ASSUME_NONNULL_END
@@ -27,6 +27,41 @@
 #import "CBORArray.h"
 #import "CBORTag.h"
 
+BOOL CBORWriteString(CBORWriter *writer, NSString *string) {
+    CFStringRef cfString = (__bridge CFStringRef)string;
+    NSUInteger length = [string length];
+    
+    // 内部存储为ASCII时直接取用，不含空字符时字符数即字节数
+    const char *cString = CFStringGetCStringPtr(cfString, kCFStringEncodingUTF8);
+    if (cString && strlen(cString) == length) {
+        return CBORWriterAppendString(writer, CBORMajorTypeString, CBORUnknownMinorType, cString, length);
+    }
+    
+    // 字符串引用需先取得完整内容才能查表
+    if (writer->strings) {
+        NSData *data = [string dataUsingEncoding:NSUTF8StringEncoding];
+        if (!data) { return NO; }
+        return CBORWriterAppendString(writer, CBORMajorTypeString, CBORUnknownMinorType, [data bytes], [data length]);
+    }
+    
+    // 先计算UTF-8字节数写入头部，再转码到缓冲区
+    NSUInteger byteLength = [string lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+    if (!byteLength && length) { return NO; }
+    if (!CBORWriterAppendHeader(writer, CBORMajorTypeString, CBORUnknownMinorType, byteLength, CBORLengthTypeMaxValue)) { return NO; }
+    
+    UInt8 *bytes = CBORWriterReserve(writer, byteLength);
+    if (bytes) {
+        [string getBytes:bytes
+               maxLength:byteLength
+              usedLength:NULL
+                encoding:NSUTF8StringEncoding
+                 options:0
+                   range:NSMakeRange(0, length)
+          remainingRange:NULL];
+    }
+    return YES;
+}
+
 @implementation NSString (CBOR)
 
 - (nullable CBORObject *)cborObject {
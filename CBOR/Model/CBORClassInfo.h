@@ -230,6 +230,8 @@ typedef NS_OPTIONS(NSUInteger, CBOREncodingType) {
     NSString *_mappedToKey;      ///< the key mapped to
     NSArray *_mappedToKeyPath;   ///< the key path mapped to (nil if the name is not key path)
     NSArray *_mappedToKeyArray;  ///< the key(NSString) or keyPath(NSArray) array (nil if not mapped to multiple keys)
+    /// 映射的整数键（`+modelCustomPropertyIntegerKeys`），nil为使用字符串键
+    NSNumber *_integerKey;
     /// 属性信息
     CBORClassPropertyInfo *_info;
     /// 映射信息
@@ -244,6 +246,32 @@ typedef NS_OPTIONS(NSUInteger, CBOREncodingType) {
 }
 @end
 
+/// 模型编码计划的一步：一个键值对，或键路径展开的嵌套字典
+///
+/// 嵌套字典的子步骤按先序紧随其后，`span`为含自身在内的子树步数
+typedef struct {
+    /// 属性信息，嵌套字典为nil
+    __unsafe_unretained CBORModelPropertyMeta *_Nullable property;
+    /// 可直接读取C数值写入的标量类型（`CBOREncodingTypeMask`内），非标量为0
+    CBOREncodingType scalar;
+    /// 预编码的键在`_encodeKeys`中的偏移
+    NSUInteger keyOffset;
+    /// 预编码的键字节数
+    NSUInteger keyLength;
+    /// 预编码的键中头部字节数，启用字符串引用时只取其后的内容
+    NSUInteger keyHeaderLength;
+    /// 预编码的键是否是字符串，整数键不参与字符串引用
+    BOOL stringKey;
+    /// 嵌套字典的直接键值对数量
+    NSUInteger count;
+    /// 含自身在内的子树步数
+    NSUInteger span;
+} CBORModelEncodeStep;
+
+/// 直接查表的整数键范围：-24~23，即单字节编码的整数
+#define CBORModelIntegerKeyTableMin (-24)
+#define CBORModelIntegerKeyTableSize 48
+
 /// 模型类信息
 @interface CBORModelMeta : NSObject {
     @package
@@ -257,8 +285,22 @@ typedef NS_OPTIONS(NSUInteger, CBOREncodingType) {
     NSArray *_keyPathPropertyMetas;
     /// 属性映射多Key `[CBORModelPropertyMeta]`
     NSArray *_multiKeysPropertyMetas;
+    /// 键路径与多键映射的首个键，单次遍历解码时需保留这些键的原生值
+    NSSet *_keyPathRootKeys;
     /// `_mapper`数量
     NSUInteger _keyMappedCount;
+    /// Key:整数键`NSNumber`, Value:`CBORModelPropertyMeta`；无整数键时为nil
+    NSDictionary *_integerMapper;
+    /// 单字节整数键直接查表，下标为键减去`CBORModelIntegerKeyTableMin`
+    __unsafe_unretained CBORModelPropertyMeta *_integerKeyTable[CBORModelIntegerKeyTableSize];
+    /// 编码计划（先序展开），键路径存在冲突无法预先确定嵌套结构时为NULL
+    CBORModelEncodeStep *_encodeSteps;
+    /// 编码计划步数
+    NSUInteger _encodeStepCount;
+    /// 顶层键值对数量
+    NSUInteger _encodeCount;
+    /// 所有预编码的键字节
+    NSData *_encodeKeys;
     /// 模型类类型
     CBOREncodingNSType _nsType;
     
@@ -272,4 +314,13 @@ typedef NS_OPTIONS(NSUInteger, CBOREncodingType) {
 
 @end
 
+/// 按整数键查找属性信息，单字节范围内直接查表
+static inline CBORModelPropertyMeta * _Nullable CBORModelMetaPropertyForIntegerKey(CBORModelMeta *meta, SInt64 key) {
+    if (!meta->_integerMapper) return nil;
+    if (key >= CBORModelIntegerKeyTableMin && key < CBORModelIntegerKeyTableMin + CBORModelIntegerKeyTableSize) {
+        return meta->_integerKeyTable[key - CBORModelIntegerKeyTableMin];
+    }
+    return meta->_integerMapper[@(key)];
+}
+
 NS_ASSUME_NONNULL_END
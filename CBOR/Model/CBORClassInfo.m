@@ -27,6 +27,9 @@
 #import <objc/runtime.h>
 #import <objc/message.h>
 #import "CBORModel.h"
+#import "CBORObject.h"
+#import "NSString+CBOR.h"
+#import "NSNumber+CBOR.h"
 
 /// 通过类型编码获取定义的编码类型
 static inline CBOREncodingType CBOREncodingGetType(const char *typeEncoding) {
@@ -538,6 +541,80 @@ static inline BOOL CBOREncodingTypeIsCNumber(CBOREncodingType type) {
 
 
 
+/// 编码计划的节点：键值对，或键路径展开的嵌套字典
+@interface CBORModelEncodeNode : NSObject {
+    @package
+    /// 字符串键或整数键
+    id _key;
+    /// 键值对的属性信息
+    CBORModelPropertyMeta *_property;
+    /// 嵌套字典的子节点
+    NSMutableArray<CBORModelEncodeNode *> *_children;
+}
+@end
+
+@implementation CBORModelEncodeNode
+@end
+
+/// 将属性按映射的键或键路径加入编码计划的嵌套结构
+/// - Returns: 同一位置的键重复（键值对或嵌套字典）时，写入结果取决于运行时哪些值为空，无法预先确定结构，返回NO
+static BOOL CBORModelEncodeNodeAdd(NSMutableArray<CBORModelEncodeNode *> *nodes, CBORModelPropertyMeta *propertyMeta) {
+    // 整数键替代键路径，总是顶层键值对
+    NSArray *path = propertyMeta->_integerKey ? @[propertyMeta->_integerKey] : (propertyMeta->_mappedToKeyPath ?: @[propertyMeta->_mappedToKey]);
+    
+    for (NSUInteger i = 0, max = path.count; i < max; i++) {
+        id key = path[i];
+        CBORModelEncodeNode *existing = nil;
+        for (CBORModelEncodeNode *node in nodes) {
+            if ([node->_key isEqual:key]) { existing = node; break; }
+        }
+        
+        if (i + 1 == max) {
+            if (existing) return NO;
+            
+            CBORModelEncodeNode *node = [CBORModelEncodeNode new];
+            node->_key = key;
+            node->_property = propertyMeta;
+            [nodes addObject:node];
+            return YES;
+        }
+        
+        if (existing && !existing->_children) return NO;
+        if (!existing) {
+            existing = [CBORModelEncodeNode new];
+            existing->_key = key;
+            existing->_children = [NSMutableArray new];
+            [nodes addObject:existing];
+        }
+        nodes = existing->_children;
+    }
+    return YES;
+}
+
+/// 将嵌套结构按先序展开为编码计划，并预编码所有键
+static BOOL CBORModelEncodeNodeFlatten(NSArray<CBORModelEncodeNode *> *nodes, CBORModelEncodeStep *steps, NSUInteger *index, NSMutableData *keys) {
+    for (CBORModelEncodeNode *node in nodes) {
+        NSData *keyData = [[node->_key cborObject] cborData];
+        if (!keyData) return NO;
+        
+        NSUInteger start = (*index)++;
+        CBORModelPropertyMeta *propertyMeta = node->_property;
+        CBORModelEncodeStep *step = &steps[start];
+        step->property = propertyMeta;
+        step->scalar = (propertyMeta && propertyMeta->_isCNumber && !propertyMeta->_isCustomCBORType) ? (propertyMeta->_type & CBOREncodingTypeMask) : 0;
+        step->keyOffset = keys.length;
+        step->keyLength = keyData.length;
+        step->stringKey = [node->_key isKindOfClass:[NSString class]];
+        step->keyHeaderLength = step->stringKey ? keyData.length - [node->_key lengthOfBytesUsingEncoding:NSUTF8StringEncoding] : 0;
+        step->count = node->_children.count;
+        [keys appendData:keyData];
+        
+        if (node->_children && !CBORModelEncodeNodeFlatten(node->_children, steps, index, keys)) return NO;
+        steps[start].span = *index - start;
+    }
+    return YES;
+}
+
 @implementation CBORModelMeta
 - (instancetype)initWithClass:(Class)cls {
     CBORClassInfo *classInfo = [CBORClassInfo classInfoWithClass:cls];
@@ -733,6 +810,61 @@ static inline BOOL CBOREncodingTypeIsCNumber(CBOREncodingType type) {
     if (keyPathPropertyMetas) _keyPathPropertyMetas = keyPathPropertyMetas;
     if (multiKeysPropertyMetas) _multiKeysPropertyMetas = multiKeysPropertyMetas;
     
+    NSMutableSet *keyPathRootKeys = [NSMutableSet new];
+    for (CBORModelPropertyMeta *propertyMeta in keyPathPropertyMetas) {
+        [keyPathRootKeys addObject:propertyMeta->_mappedToKeyPath.firstObject];
+    }
+    for (CBORModelPropertyMeta *propertyMeta in multiKeysPropertyMetas) {
+        for (id oneKey in propertyMeta->_mappedToKeyArray) {
+            [keyPathRootKeys addObject:[oneKey isKindOfClass:[NSArray class]] ? [oneKey firstObject] : oneKey];
+        }
+    }
+    if (keyPathRootKeys.count) _keyPathRootKeys = keyPathRootKeys;
+    
+    // 整数键：重复的键只保留先处理的属性
+    if ([cls respondsToSelector:@selector(modelCustomPropertyIntegerKeys)]) {
+        NSDictionary *customKeys = [(id <CBORModel>)cls modelCustomPropertyIntegerKeys];
+        NSMutableDictionary *integerMapper = [NSMutableDictionary new];
+        for (CBORModelPropertyMeta *propertyMeta in _allPropertyMetas) {
+            NSNumber *key = customKeys[propertyMeta->_name];
+            if (![key isKindOfClass:[NSNumber class]] || CFNumberIsFloatType((CFNumberRef)key)) continue;
+            
+            key = @(key.longLongValue);
+            if (integerMapper[key]) continue;
+            propertyMeta->_integerKey = key;
+            integerMapper[key] = propertyMeta;
+            
+            SInt64 value = key.longLongValue;
+            if (value >= CBORModelIntegerKeyTableMin && value < CBORModelIntegerKeyTableMin + CBORModelIntegerKeyTableSize) {
+                _integerKeyTable[value - CBORModelIntegerKeyTableMin] = propertyMeta;
+            }
+        }
+        if (integerMapper.count) _integerMapper = integerMapper;
+    }
+    
+    // 编码计划：键预先编码，键路径预先确定嵌套结构
+    NSMutableArray<CBORModelEncodeNode *> *encodeNodes = [NSMutableArray new];
+    NSUInteger maxStepCount = 0;
+    BOOL planable = YES;
+    for (CBORModelPropertyMeta *propertyMeta in _allPropertyMetas) {
+        if (!propertyMeta->_getter) continue;
+        if (!CBORModelEncodeNodeAdd(encodeNodes, propertyMeta)) { planable = NO; break; }
+        maxStepCount += (propertyMeta->_mappedToKeyPath && !propertyMeta->_integerKey) ? propertyMeta->_mappedToKeyPath.count : 1;
+    }
+    if (planable && maxStepCount) {
+        NSMutableData *encodeKeys = [NSMutableData new];
+        NSUInteger stepCount = 0;
+        _encodeSteps = calloc(maxStepCount, sizeof(CBORModelEncodeStep));
+        if (_encodeSteps && CBORModelEncodeNodeFlatten(encodeNodes, _encodeSteps, &stepCount, encodeKeys)) {
+            _encodeStepCount = stepCount;
+            _encodeCount = encodeNodes.count;
+            _encodeKeys = encodeKeys;
+        } else {
+            free(_encodeSteps);
+            _encodeSteps = NULL;
+        }
+    }
+    
     _classInfo = classInfo;
     _keyMappedCount = _allPropertyMetas.count;
     _nsType = CBORClassGetNSType(cls);
@@ -744,6 +876,10 @@ static inline BOOL CBOREncodingTypeIsCNumber(CBOREncodingType type) {
     return self;
 }
 
+- (void)dealloc {
+    free(_encodeSteps);
+}
+
 /// Returns the cached model class meta
 + (instancetype)metaWithClass:(Class)cls {
     if (!cls) return nil;
@@ -0,0 +1,51 @@
+// refer: https://github.com/DanielHusx/CBOR
+//
+// MIT License
+//
+// Copyright (c) 2024 Daniel
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "CBORDecodeHeader.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 数据直接解码为模型：单次遍历数据，按模型属性映射逐个解码键值对，
+/// 不构建中间字典；未映射的值仅校验后跳过，嵌套模型与模型容器直接在数据上递归构建
+///
+/// 只直接遍历不在扩展类型内的键值对与数组：扩展类型的值（含字符串引用命名空间tag 256）交由原生对象解码，
+/// 命名空间内的引用（tag 25）在其中按字符串表解析，因此遍历到的数据不会引用外层字符串表
+@interface CBORModelDecoder : NSObject
+
+/// 解码模型，结果与先解码为原生对象再`+cbor_modelWithJSON:`一致
+/// - Parameters:
+///   - aClass: 模型类（非NSArray/NSDictionary）
+///   - data: CBOR数据
+/// - Returns: 键值对返回模型，数组返回模型数组，失败返回nil
++ (nullable id)decodeClass:(Class)aClass data:(NSData *)data;
+
+/// 从数据流当前位置解码模型，复用调用方的帧栈与流的驻留表（未设置时按需创建）
+/// - Parameter stack: 帧栈，返回时已清空，已分配的帧保留供下次解码
++ (nullable id)decodeClass:(Class)aClass stream:(CBORStream *)stream stack:(CBORDecodeStack *)stack;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,429 @@
+// refer: https://github.com/DanielHusx/CBOR
+//
+// MIT License
+//
+// Copyright (c) 2024 Daniel
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import "CBORModelDecoder.h"
+#import "CBORDecodeHeader.h"
+#import "CBORInternTable.h"
+#import "CBORClassInfo.h"
+#import "NSObject+CBORModel.h"
+#import <objc/message.h>
+
+extern void CBORModelSetValueForProperty(__unsafe_unretained id model,
+                                         __unsafe_unretained id value,
+                                         __unsafe_unretained CBORModelPropertyMeta *meta);
+extern void CBORModelSetWithMappedKeys(__unsafe_unretained id model,
+                                       __unsafe_unretained CBORModelMeta *modelMeta,
+                                       __unsafe_unretained NSDictionary *dictionary);
+
+/// 模型解码上下文
+typedef struct {
+    __unsafe_unretained CBORStream *stream;
+    __unsafe_unretained CBORInternTable *interns;
+    CBORCursor *cursor;
+    const CBORInitialByte *table;
+    /// 原生对象解码与跳过共用的解码帧栈
+    CBORDecodeStack *stack;
+    /// 当前模型嵌套深度（已进入的容器数量）
+    NSUInteger depth;
+} CBORModelDecodeContext;
+
+/// 下一个元素的解码类别
+static inline CBORDecodeKind CBORModelDecodePeekKind(const CBORModelDecodeContext *context) {
+    CBORCursor *cursor = context->cursor;
+    if (cursor->index >= cursor->length) { return CBORDecodeKindInvalid; }
+    return context->table[cursor->bytes[cursor->index]].kind;
+}
+
+/// 当前深度下解码子元素的限制；终止符只能结束不定长容器，已达深度上限时子元素不允许再是容器
+static inline BOOL CBORModelDecodeLimits(const CBORModelDecodeContext *context, CBORDecodeLimits *limits) {
+    CBORDecodeKind kind = CBORModelDecodePeekKind(context);
+    if (kind == CBORDecodeKindBreak) { return NO; }
+    
+    *limits = CBORDecodeLimitsDefault;
+    limits->maxDepth -= context->depth;
+    if (limits->maxDepth) { return YES; }
+    
+    if (kind == CBORDecodeKindArray || kind == CBORDecodeKindMap || kind == CBORDecodeKindTag || CBORDecodeKindIsIndefinite(kind)) { return NO; }
+    limits->maxDepth = 1;
+    return YES;
+}
+
+/// 跳过一个元素
+static BOOL CBORModelDecodeSkip(CBORModelDecodeContext *context) {
+    CBORDecodeLimits limits;
+    if (!CBORModelDecodeLimits(context, &limits)) { return NO; }
+    return CBORDecodeSkipAtCursor(context->cursor, limits, context->stack);
+}
+
+/// 解码一个元素为原生对象；数据合法但无法表示（如非法UTF8字符串）时`value`为nil并返回YES
+static BOOL CBORModelDecodeValue(CBORModelDecodeContext *context, id *value) {
+    CBORDecodeLimits limits;
+    if (!CBORModelDecodeLimits(context, &limits)) { return NO; }
+    
+    NSUInteger start = context->cursor->index;
+    *value = CBORDecodeObjectAtCursor(context->stream, limits, context->stack);
+    if (*value) { return YES; }
+    
+    // 区分非法数据与无法表示的元素
+    CBORDecodeStackReset(context->stack);
+    context->cursor->index = start;
+    return CBORDecodeSkipAtCursor(context->cursor, limits, context->stack);
+}
+
+/// 解码键值对的键；定长字符串直接驻留，不经过通用解码
+static BOOL CBORModelDecodeKey(CBORModelDecodeContext *context, id *key) {
+    if (CBORModelDecodePeekKind(context) != CBORDecodeKindString) {
+        if (!CBORModelDecodeValue(context, key)) { return NO; }
+        if (*key && ![*key conformsToProtocol:@protocol(NSCopying)]) { *key = [*key description]; }
+        return YES;
+    }
+    
+    NSUInteger items = 0;
+    CBORDecodeStack empty = { NULL, 0, 0 };
+    CBORDecodeHeader header;
+    const UInt8 *bytes = NULL;
+    if (!CBORDecodeReadHeader(context->cursor, context->table, &empty, CBORDecodeLimitsDefault, &items, &header)) { return NO; }
+    if (!CBORCursorReadBytes(context->cursor, header.argument, &bytes)) { return NO; }
+    
+    *key = [context->interns stringWithUTF8Bytes:bytes length:header.argument];
+    return YES;
+}
+
+/// 解码整数键并按`+modelCustomPropertyIntegerKeys`查表，不构建键对象；未映射或超出SInt64范围时`propertyMeta`为nil
+static BOOL CBORModelDecodeIntegerKey(CBORModelDecodeContext *context, CBORModelMeta *meta, CBORModelPropertyMeta **propertyMeta) {
+    NSUInteger items = 0;
+    CBORDecodeStack empty = { NULL, 0, 0 };
+    CBORDecodeHeader header;
+    if (!CBORDecodeReadHeader(context->cursor, context->table, &empty, CBORDecodeLimitsDefault, &items, &header)) { return NO; }
+    
+    *propertyMeta = nil;
+    if (header.argument > INT64_MAX) { return YES; }
+    SInt64 key = header.entry.kind == CBORDecodeKindNegative ? -1 - (SInt64)header.argument : (SInt64)header.argument;
+    *propertyMeta = CBORModelMetaPropertyForIntegerKey(meta, key);
+    return YES;
+}
+
+/// 进入容器：读取头部，输出定长容器的元素数量（不定长为NSUIntegerMax）
+static BOOL CBORModelDecodeEnter(CBORModelDecodeContext *context, UInt64 *count, BOOL *indefinite) {
+    if (context->depth >= CBORDecodeLimitsDefault.maxDepth) { return NO; }
+    
+    NSUInteger items = 0;
+    CBORDecodeStack empty = { NULL, 0, 0 };
+    CBORDecodeHeader header;
+    if (!CBORDecodeReadHeader(context->cursor, context->table, &empty, CBORDecodeLimitsDefault, &items, &header)) { return NO; }
+    
+    *indefinite = CBORDecodeKindIsIndefinite(header.entry.kind);
+    *count = *indefinite ? NSUIntegerMax : header.argument;
+    // 每个元素至少一个字节，数量超过剩余数据时必然非法
+    if (!*indefinite && *count > CBORCursorRemaining(context->cursor)) { return NO; }
+    
+    context->depth++;
+    return YES;
+}
+
+/// 是否还有下一个子元素；不定长容器遇到终止符时跳过终止符
+static inline BOOL CBORModelDecodeHasNext(CBORModelDecodeContext *context, UInt64 *remaining, BOOL indefinite) {
+    if (indefinite) {
+        if (!CBORCursorPeekBreak(context->cursor)) { return YES; }
+        context->cursor->index++;
+        return NO;
+    }
+    if (!*remaining) { return NO; }
+    (*remaining)--;
+    return YES;
+}
+
+static BOOL CBORModelDecodeFill(CBORModelDecodeContext *context, NSObject *model, BOOL *set);
+
+/// 解码键值对为模型（含`+modelCustomClassForDictionary:`选择的类），`model`为nil时数据合法但未能构建
+static BOOL CBORModelDecodeModel(CBORModelDecodeContext *context, Class cls, NSObject **model) {
+    CBORModelMeta *meta = [CBORModelMeta metaWithClass:cls];
+    // 需要完整字典才能选择类
+    if (meta->_hasCustomClassFromDictionary) {
+        NSDictionary *dictionary = nil;
+        if (!CBORModelDecodeValue(context, &dictionary)) { return NO; }
+        *model = dictionary ? [cls cbor_modelWithDictionary:dictionary] : nil;
+        return YES;
+    }
+    
+    NSObject *one = [cls new];
+    BOOL set = NO;
+    if (!CBORModelDecodeFill(context, one, &set)) { return NO; }
+    *model = set ? one : nil;
+    return YES;
+}
+
+/// 解码数组为模型数组，与`-cbor_modelSetWithDictionary:`对`genericCls`容器属性的处理一致
+static BOOL CBORModelDecodeModelArray(CBORModelDecodeContext *context, Class genericCls, NSMutableArray *array) {
+    UInt64 remaining = 0;
+    BOOL indefinite = NO;
+    if (!CBORModelDecodeEnter(context, &remaining, &indefinite)) { return NO; }
+    
+    // 原生字典本身满足通用类时保留字典
+    BOOL keepsDictionary = [NSMutableDictionary isSubclassOfClass:genericCls];
+    while (CBORModelDecodeHasNext(context, &remaining, indefinite)) {
+        CBORDecodeKind kind = CBORModelDecodePeekKind(context);
+        if (!keepsDictionary && (kind == CBORDecodeKindMap || kind == CBORDecodeKindIndefiniteMap)) {
+            NSObject *one = [genericCls new];
+            BOOL set = NO;
+            if (!CBORModelDecodeFill(context, one, &set)) { return NO; }
+            [array addObject:one];
+            continue;
+        }
+        
+        // 与原生数组一致：无法表示的元素使整体解码失败
+        id value = nil;
+        if (!CBORModelDecodeValue(context, &value) || !value) { return NO; }
+        if ([value isKindOfClass:genericCls]) {
+            [array addObject:value];
+        } else if ([value isKindOfClass:[NSDictionary class]]) {
+            // 扩展类型包裹的键值对（如字符串引用命名空间）解码后再转模型
+            NSObject *one = [genericCls new];
+            [one cbor_modelSetWithDictionary:value];
+            [array addObject:one];
+        }
+    }
+    context->depth--;
+    return YES;
+}
+
+/// 解码键值对为模型字典，只保留值为键值对的条目
+static BOOL CBORModelDecodeModelDictionary(CBORModelDecodeContext *context, Class genericCls, NSMutableDictionary *dictionary) {
+    UInt64 remaining = 0;
+    BOOL indefinite = NO;
+    if (!CBORModelDecodeEnter(context, &remaining, &indefinite)) { return NO; }
+    
+    while (CBORModelDecodeHasNext(context, &remaining, indefinite)) {
+        id key = nil;
+        if (!CBORModelDecodeKey(context, &key)) { return NO; }
+        
+        CBORDecodeKind kind = CBORModelDecodePeekKind(context);
+        if (!key || (kind != CBORDecodeKindMap && kind != CBORDecodeKindIndefiniteMap && kind != CBORDecodeKindTag)) {
+            if (!CBORModelDecodeSkip(context)) { return NO; }
+            continue;
+        }
+        
+        // 扩展类型包裹的键值对（如字符串引用命名空间）解码后再转模型
+        if (kind == CBORDecodeKindTag) {
+            id value = nil;
+            if (!CBORModelDecodeValue(context, &value)) { return NO; }
+            if (![value isKindOfClass:[NSDictionary class]]) { continue; }
+            
+            NSObject *one = [genericCls new];
+            [one cbor_modelSetWithDictionary:value];
+            dictionary[key] = one;
+            continue;
+        }
+        
+        NSObject *one = [genericCls new];
+        BOOL set = NO;
+        if (!CBORModelDecodeFill(context, one, &set)) { return NO; }
+        dictionary[key] = one;
+    }
+    context->depth--;
+    return YES;
+}
+
+/// 解码单个映射属性的值：嵌套模型与模型容器直接在数据上构建，其余解码为原生对象后按原有规则赋值
+static BOOL CBORModelDecodeProperty(CBORModelDecodeContext *context, NSObject *model, CBORModelPropertyMeta *meta) {
+    CBORDecodeKind kind = CBORModelDecodePeekKind(context);
+    BOOL isMap = kind == CBORDecodeKindMap || kind == CBORDecodeKindIndefiniteMap;
+    BOOL isArray = kind == CBORDecodeKindArray || kind == CBORDecodeKindIndefiniteArray;
+    
+    if (!meta->_hasCustomClassFromDictionary && !meta->_isCNumber) {
+        // 嵌套模型：已有实例时原地更新
+        Class cls = meta->_genericCls ?: meta->_cls;
+        if (!meta->_nsType && (meta->_type & CBOREncodingTypeMask) == CBOREncodingTypeObject
+            && isMap && cls && ![NSMutableDictionary isSubclassOfClass:cls]) {
+            NSObject *one = meta->_getter ? ((id (*)(id, SEL))(void *) objc_msgSend)((id)model, meta->_getter) : nil;
+            BOOL created = !one;
+            if (created) { one = [cls new]; }
+            
+            BOOL set = NO;
+            if (!CBORModelDecodeFill(context, one, &set)) { return NO; }
+            if (created) { ((void (*)(id, SEL, id))(void *) objc_msgSend)((id)model, meta->_setter, (id)one); }
+            return YES;
+        }
+        
+        // 模型数组
+        if (meta->_genericCls && isArray
+            && (meta->_nsType == CBOREncodingTypeNSArray || meta->_nsType == CBOREncodingTypeNSMutableArray)) {
+            NSMutableArray *array = [NSMutableArray new];
+            if (!CBORModelDecodeModelArray(context, meta->_genericCls, array)) { return NO; }
+            ((void (*)(id, SEL, id))(void *) objc_msgSend)((id)model, meta->_setter, array);
+            return YES;
+        }
+        
+        // 模型字典
+        if (meta->_genericCls && isMap
+            && (meta->_nsType == CBOREncodingTypeNSDictionary || meta->_nsType == CBOREncodingTypeNSMutableDictionary)) {
+            NSMutableDictionary *dictionary = [NSMutableDictionary new];
+            if (!CBORModelDecodeModelDictionary(context, meta->_genericCls, dictionary)) { return NO; }
+            ((void (*)(id, SEL, id))(void *) objc_msgSend)((id)model, meta->_setter, dictionary);
+            return YES;
+        }
+    }
+    
+    id value = nil;
+    if (!CBORModelDecodeValue(context, &value)) { return NO; }
+    if (value) { CBORModelSetValueForProperty(model, value, meta); }
+    return YES;
+}
+
+/// 解码键值对并设置到模型，`set`与`-cbor_modelSetWithDictionary:`的返回值一致
+static BOOL CBORModelDecodeFill(CBORModelDecodeContext *context, NSObject *model, BOOL *set) {
+    CBORModelMeta *meta = [CBORModelMeta metaWithClass:object_getClass(model)];
+    // 自定义转换需要完整字典
+    if (!meta->_keyMappedCount || meta->_hasCustomWillTransformFromDictionary || meta->_hasCustomTransformFromDictionary) {
+        NSDictionary *dictionary = nil;
+        if (!CBORModelDecodeValue(context, &dictionary)) { return NO; }
+        *set = dictionary && [model cbor_modelSetWithDictionary:dictionary];
+        return YES;
+    }
+    
+    UInt64 remaining = 0;
+    BOOL indefinite = NO;
+    if (!CBORModelDecodeEnter(context, &remaining, &indefinite)) { return NO; }
+    
+    // 键路径与多键映射所需的值
+    NSMutableDictionary *mapped = nil;
+    while (CBORModelDecodeHasNext(context, &remaining, indefinite)) {
+        // 整数键直接按表分发
+        CBORDecodeKind kind = CBORModelDecodePeekKind(context);
+        if (meta->_integerMapper && (kind == CBORDecodeKindUnsigned || kind == CBORDecodeKindNegative)) {
+            CBORModelPropertyMeta *propertyMeta = nil;
+            if (!CBORModelDecodeIntegerKey(context, meta, &propertyMeta)) { return NO; }
+            if (!(propertyMeta ? CBORModelDecodeProperty(context, model, propertyMeta) : CBORModelDecodeSkip(context))) { return NO; }
+            continue;
+        }
+        
+        id key = nil;
+        if (!CBORModelDecodeKey(context, &key)) { return NO; }
+        
+        CBORModelPropertyMeta *propertyMeta = key ? meta->_mapper[key] : nil;
+        BOOL isRootKey = key && [meta->_keyPathRootKeys containsObject:key];
+        if (!propertyMeta && !isRootKey) {
+            if (!CBORModelDecodeSkip(context)) { return NO; }
+            continue;
+        }
+        if (propertyMeta && !propertyMeta->_next && !isRootKey) {
+            if (!CBORModelDecodeProperty(context, model, propertyMeta)) { return NO; }
+            continue;
+        }
+        
+        id value = nil;
+        if (!CBORModelDecodeValue(context, &value)) { return NO; }
+        if (!value) { continue; }
+        
+        for (; propertyMeta; propertyMeta = propertyMeta->_next) {
+            CBORModelSetValueForProperty(model, value, propertyMeta);
+        }
+        if (isRootKey) {
+            if (!mapped) { mapped = [NSMutableDictionary new]; }
+            mapped[key] = value;
+        }
+    }
+    context->depth--;
+    
+    if (mapped) { CBORModelSetWithMappedKeys(model, meta, mapped); }
+    *set = YES;
+    return YES;
+}
+
+
+@implementation CBORModelDecoder
+
++ (id)decodeClass:(Class)aClass data:(NSData *)data {
+    if (!aClass || ![data length]) { return nil; }
+    
+    CBORStream *stream = [[CBORStream alloc] initWithData:data];
+    stream.internTable = [CBORInternTable new];
+    CBORDecodeStack stack = { NULL, 0, 0 };
+    id ret = [self decodeClass:aClass stream:stream stack:&stack];
+    CBORDecodeStackDispose(&stack);
+    
+    return ret;
+}
+
++ (id)decodeClass:(Class)aClass stream:(CBORStream *)stream stack:(CBORDecodeStack *)stack {
+    if (!aClass || [stream isAtEnd]) { return nil; }
+    
+    CBORInternTable *interns = stream.internTable;
+    if (!interns) {
+        interns = [CBORInternTable new];
+        stream.internTable = interns;
+    }
+    CBORModelDecodeContext context = { stream, interns, [stream cursor], CBORInitialByteTable(), stack, 0 };
+    
+    id ret = nil;
+    BOOL valid = NO;
+    switch (CBORModelDecodePeekKind(&context)) {
+        case CBORDecodeKindMap:
+        case CBORDecodeKindIndefiniteMap: {
+            NSObject *model = nil;
+            valid = CBORModelDecodeModel(&context, aClass, &model);
+            ret = model;
+        } break;
+            
+        case CBORDecodeKindArray:
+        case CBORDecodeKindIndefiniteArray: {
+            // 与`+cbor_modelArrayWithClass:json:`一致：跳过非键值对元素与构建失败的模型
+            UInt64 remaining = 0;
+            BOOL indefinite = NO;
+            NSMutableArray *models = [NSMutableArray new];
+            if (!CBORModelDecodeEnter(&context, &remaining, &indefinite)) { break; }
+            
+            valid = YES;
+            while (valid && CBORModelDecodeHasNext(&context, &remaining, indefinite)) {
+                CBORDecodeKind kind = CBORModelDecodePeekKind(&context);
+                if (kind == CBORDecodeKindMap || kind == CBORDecodeKindIndefiniteMap) {
+                    NSObject *model = nil;
+                    valid = CBORModelDecodeModel(&context, aClass, &model);
+                    if (model) { [models addObject:model]; }
+                } else {
+                    id value = nil;
+                    valid = CBORModelDecodeValue(&context, &value) && value;
+                }
+            }
+            ret = models;
+        } break;
+            
+        default: {
+            // 扩展类型（含任意头部宽度的字符串引用命名空间tag 256）整体解码为原生对象，引用在其中解析
+            id value = nil;
+            valid = CBORModelDecodeValue(&context, &value);
+            if ([value isKindOfClass:[NSArray class]]) {
+                ret = [NSArray cbor_modelArrayWithClass:aClass json:value];
+            } else {
+                ret = value ? [aClass cbor_modelWithJSON:value] : nil;
+            }
+        } break;
+    }
+    CBORDecodeStackReset(stack);
+    
+    return valid ? ret : nil;
+}
+
+@end
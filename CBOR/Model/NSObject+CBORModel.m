@@ -409,9 +409,9 @@ static force_inline void CBORModelSetNumberToProperty(__unsafe_unretained id mod
  @param meta  Should not be nil, and meta->_setter should not be nil.
  */
 /// 设置模型对象属性值
-static void CBORModelSetValueForProperty(__unsafe_unretained id model,
-                                     __unsafe_unretained id value,
-                                     __unsafe_unretained CBORModelPropertyMeta *meta) {
+void CBORModelSetValueForProperty(__unsafe_unretained id model,
+                              __unsafe_unretained id value,
+                              __unsafe_unretained CBORModelPropertyMeta *meta) {
     if (meta->_isCNumber) {
         NSNumber *num = CBORNSNumberCreateFromID(value);
         CBORModelSetNumberToProperty(model, num, meta);
@@ -747,6 +747,14 @@ static void CBORModelSetWithDictionaryFunction(const void *_key, const void *_va
     __unsafe_unretained CBORModelMeta *meta = (__bridge CBORModelMeta *)(context->modelMeta);
     __unsafe_unretained CBORModelPropertyMeta *propertyMeta = [meta->_mapper objectForKey:(__bridge id)(_key)];
     __unsafe_unretained id model = (__bridge id)(context->model);
+    // 整数键只映射单个属性
+    if (!propertyMeta && meta->_integerMapper && [(__bridge id)(_key) isKindOfClass:[NSNumber class]]) {
+        propertyMeta = [meta->_integerMapper objectForKey:(__bridge id)(_key)];
+        if (propertyMeta && propertyMeta->_setter) {
+            CBORModelSetValueForProperty(model, (__bridge __unsafe_unretained id)_value, propertyMeta);
+        }
+        return;
+    }
     while (propertyMeta) {
         if (propertyMeta->_setter) {
             CBORModelSetValueForProperty(model, (__bridge __unsafe_unretained id)_value, propertyMeta);
@@ -767,9 +775,12 @@ static void CBORModelSetWithPropertyMetaArrayFunction(const void *_propertyMeta,
     __unsafe_unretained NSDictionary *dictionary = (__bridge NSDictionary *)(context->dictionary);
     __unsafe_unretained CBORModelPropertyMeta *propertyMeta = (__bridge CBORModelPropertyMeta *)(_propertyMeta);
     if (!propertyMeta->_setter) return;
-    id value = nil;
+    // 整数键优先，缺失时兼容字符串键
+    id value = propertyMeta->_integerKey ? [dictionary objectForKey:propertyMeta->_integerKey] : nil;
     
-    if (propertyMeta->_mappedToKeyArray) {
+    if (value) {
+        // 已取得整数键的值
+    } else if (propertyMeta->_mappedToKeyArray) {
         value = CBORValueForMultiKeys(dictionary, propertyMeta->_mappedToKeyArray);
     } else if (propertyMeta->_mappedToKeyPath) {
         value = CBORValueForKeyPath(dictionary, propertyMeta->_mappedToKeyPath);
@@ -783,6 +794,29 @@ static void CBORModelSetWithPropertyMetaArrayFunction(const void *_propertyMeta,
     }
 }
 
+/// 按键路径与多键映射设置模型属性（单次遍历解码时使用，字典仅含映射所需的首个键）
+void CBORModelSetWithMappedKeys(__unsafe_unretained id model,
+                                __unsafe_unretained CBORModelMeta *modelMeta,
+                                __unsafe_unretained NSDictionary *dictionary) {
+    CBORModelSetContext context = {0};
+    context.modelMeta = (__bridge void *)(modelMeta);
+    context.model = (__bridge void *)(model);
+    context.dictionary = (__bridge void *)(dictionary);
+    
+    if (modelMeta->_keyPathPropertyMetas) {
+        CFArrayApplyFunction((CFArrayRef)modelMeta->_keyPathPropertyMetas,
+                             CFRangeMake(0, CFArrayGetCount((CFArrayRef)modelMeta->_keyPathPropertyMetas)),
+                             CBORModelSetWithPropertyMetaArrayFunction,
+                             &context);
+    }
+    if (modelMeta->_multiKeysPropertyMetas) {
+        CFArrayApplyFunction((CFArrayRef)modelMeta->_multiKeysPropertyMetas,
+                             CFRangeMake(0, CFArrayGetCount((CFArrayRef)modelMeta->_multiKeysPropertyMetas)),
+                             CBORModelSetWithPropertyMetaArrayFunction,
+                             &context);
+    }
+}
+
 /**
  Returns a valid JSON object (NSArray/NSDictionary/NSString/NSNumber/NSNull), 
  or nil if an error occurs.
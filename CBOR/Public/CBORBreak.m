@@ -9,7 +9,7 @@
 @implementation CBORBreak
 
 - (CBORObject *)cborObject {
-    return [[CBORSimple alloc] initWithMajor:CBORMajorTypeAdditional minor:CBORAdditionalTypeBreak];
+    return [CBORSimple cborBreak];
 }
 
 - (CBORObject *)cborObjectWithMajor:(CBORMajorType)major minor:(CBORUInt64)minor {
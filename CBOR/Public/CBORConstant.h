@@ -181,8 +181,10 @@ typedef NS_ENUM(CBORUInt64, CBORTagType) {
     CBORTagTypeExpectedConversionToBase16Encoding       = 23,
     /// 编码数据格式
     CBORTagTypeEncodedCBORDataItem                      = 24,
+    /// 字符串引用：内容为字符串表中的下标，指向此前出现过的字符串
+    CBORTagTypeStringReference                          = 25,
 
-    // 25...31 unassigned
+    // 26...31 unassigned
     /// 统一资源标识符
     CBORTagTypeURI                  = 32,
     /// Base64地址编码
@@ -196,11 +198,100 @@ typedef NS_ENUM(CBORUInt64, CBORTagType) {
     /// UUID
     CBORTagTypeUUID                 = 37,
 
-    // 38...55798 unassigned
+    // 38...63 unassigned
+    /// 类型化数组（RFC 8746），内容为字节数组，元素按标记的字节序连续排列
+    CBORTagTypeTypedArrayUInt8          = 64,
+    CBORTagTypeTypedArrayUInt16BE       = 65,
+    CBORTagTypeTypedArrayUInt32BE       = 66,
+    CBORTagTypeTypedArrayUInt64BE       = 67,
+    /// 钳位无符号8位整数
+    CBORTagTypeTypedArrayUInt8Clamped   = 68,
+    CBORTagTypeTypedArrayUInt16LE       = 69,
+    CBORTagTypeTypedArrayUInt32LE       = 70,
+    CBORTagTypeTypedArrayUInt64LE       = 71,
+    CBORTagTypeTypedArraySInt8          = 72,
+    CBORTagTypeTypedArraySInt16BE       = 73,
+    CBORTagTypeTypedArraySInt32BE       = 74,
+    CBORTagTypeTypedArraySInt64BE       = 75,
+    // 76 reserved
+    CBORTagTypeTypedArraySInt16LE       = 77,
+    CBORTagTypeTypedArraySInt32LE       = 78,
+    CBORTagTypeTypedArraySInt64LE       = 79,
+    CBORTagTypeTypedArrayFloat16BE      = 80,
+    CBORTagTypeTypedArrayFloat32BE      = 81,
+    CBORTagTypeTypedArrayFloat64BE      = 82,
+    CBORTagTypeTypedArrayFloat128BE     = 83,
+    CBORTagTypeTypedArrayFloat16LE      = 84,
+    CBORTagTypeTypedArrayFloat32LE      = 85,
+    CBORTagTypeTypedArrayFloat64LE      = 86,
+    CBORTagTypeTypedArrayFloat128LE     = 87,
+
+    // 88...55798 unassigned
     /// 自1970-01-01开始计算天数差（整数）
     CBORTagTypeDaysSinceEpochDate   = 100,
+    /// 字符串引用命名空间：内容中足够长的定长字符串按出现顺序编入字符串表，可由`CBORTagTypeStringReference`引用
+    CBORTagTypeStringReferenceNamespace = 256,
     
     /// 自我描述
     CBORTagTypeSelfDescribeCBOR     = 55799,
 };
 
+
+/// 解码状态
+typedef NS_ENUM(NSInteger, CBORDecodeStatus) {
+    /// 解码完成，无待处理数据
+    CBORDecodeStatusOK              = 0,
+    /// 数据不完整，需要更多数据
+    CBORDecodeStatusNeedMoreData    = 1,
+    /// 数据格式错误
+    CBORDecodeStatusMalformed       = 2,
+};
+
+/// 解码限制（0表示不限制），用于尽早拒绝恶意数据
+typedef struct {
+    /// 最大嵌套深度（数组/键值对/扩展类型/不定长字节数组与字符串）
+    NSUInteger maxDepth;
+    /// 最大元素数量
+    NSUInteger maxItems;
+    /// 最大数据字节数
+    NSUInteger maxBytes;
+} CBORDecodeLimits;
+
+static inline CBORDecodeLimits CBORDecodeLimitsMake(NSUInteger maxDepth, NSUInteger maxItems, NSUInteger maxBytes) {
+    CBORDecodeLimits limits = { maxDepth, maxItems, maxBytes };
+    return limits;
+}
+
+/// 默认解码限制：仅限制嵌套深度
+static const CBORDecodeLimits CBORDecodeLimitsDefault = { 1024, 0, 0 };
+
+/// 解码选项
+typedef NS_OPTIONS(NSUInteger, CBORDecodeOptions) {
+    CBORDecodeOptionsNone = 0,
+    /// 字符串直接引用数据源字节不拷贝，字符串存活期间数据源不会释放（iOS 13/macOS 10.15以下仍拷贝）
+    CBORDecodeOptionsNoCopyStrings = 1 << 0,
+};
+
+/// 编码选项
+typedef NS_OPTIONS(NSUInteger, CBOREncodeOptions) {
+    CBOREncodeOptionsNone = 0,
+    /// 元素类型一致的数值数组编码为类型化数组（RFC 8746）
+    CBOREncodeOptionsTypedArrays = 1 << 0,
+    /// 重复的字符串只写入一次，之后写为字符串引用（tag 25），整体包裹在引用命名空间（tag 256）中
+    CBOREncodeOptionsStringReferences = 1 << 1,
+    /// 先计量精确长度，输出缓冲区只分配一次；计量需完整编码一遍（模型的getter也会调用两次），
+    /// 仅在输出内存需严格控制时使用，默认单次写入可增长的缓冲区
+    CBOREncodeOptionsExactCapacity = 1 << 2,
+};
+
+/// 流式编码状态
+typedef NS_ENUM(NSInteger, CBOREncodeStatus) {
+    /// 写入成功（数据可能仍在缓冲区中）
+    CBOREncodeStatusOK              = 0,
+    /// 输出端暂不可写：缓冲区已满时本次写入未执行，输出端可写后需`-flush`再重试
+    CBOREncodeStatusWouldBlock      = 1,
+    /// 输出端写入失败，编码器不可再使用
+    CBOREncodeStatusError           = 2,
+    /// 对象无法编码或调用顺序非法（如结束未开始的容器），本次写入未执行
+    CBOREncodeStatusInvalid         = 3,
+};
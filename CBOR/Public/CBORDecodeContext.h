@@ -0,0 +1,62 @@
+// refer: https://github.com/DanielHusx/CBOR
+//
+// MIT License
+//
+// Copyright (c) 2024 Daniel
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#import <Foundation/Foundation.h>
+#import "CBORConstant.h"
+#import "CBORInternTable.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 可复用的解码上下文
+///
+/// 数据流、解码帧栈与驻留表在多次解码间保留，稳定状态下解码同类数据除结果对象外不再分配内存；
+/// 驻留表跨调用复用，反复出现的键值对的键返回同一实例。
+///
+/// - Attentions: 非线程安全；`+currentContext`返回当前线程独享的实例
+@interface CBORDecodeContext : NSObject
+
+/// 当前线程的解码上下文，线程结束时释放
++ (instancetype)currentContext;
+
+/// 解码限制，默认`CBORDecodeLimitsDefault`
+@property (nonatomic, assign) CBORDecodeLimits limits;
+/// 键值对的键所用的驻留表，可与其他上下文共享
+@property (nonatomic, strong) CBORInternTable *internTable;
+
+/// 初始化，使用独立的驻留表
+- (instancetype)init;
+/// 指定驻留表初始化
+- (instancetype)initWithInternTable:(CBORInternTable *)internTable NS_DESIGNATED_INITIALIZER;
+
+/// 解码数据，结果与`+[CBORParser decodeData:limits:]`一致
+- (nullable id)decodeData:(NSData *)data;
+/// 解码数据为模型，结果与`+[CBORParser decodeClass:fromData:]`一致
+- (nullable id)decodeClass:(Class)aClass fromData:(NSData *)data;
+
+/// 释放帧栈并清空驻留表
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,110 @@
+// refer: https://github.com/DanielHusx/CBOR
+//
+// MIT License
+//
+// Copyright (c) 2024 Daniel
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#import "CBORDecodeContext.h"
+#import "CBORDecodeHeader.h"
+#import "CBORModelDecoder.h"
+#import "CBORParser.h"
+
+/// 线程字典中当前线程解码上下文的键
+static NSString * const CBORDecodeContextThreadKey = @"CBORDecodeContext";
+
+@implementation CBORDecodeContext {
+    /// 保留的数据流
+    CBORStream *_stream;
+    /// 保留的解码帧栈
+    CBORDecodeStack _stack;
+    /// 解码中：嵌套调用（如模型自定义转换中再次解码）时不能复用数据流与帧栈
+    BOOL _busy;
+}
+
++ (instancetype)currentContext {
+    NSMutableDictionary *dictionary = [[NSThread currentThread] threadDictionary];
+    CBORDecodeContext *context = dictionary[CBORDecodeContextThreadKey];
+    if (!context) {
+        context = [self new];
+        dictionary[CBORDecodeContextThreadKey] = context;
+    }
+    return context;
+}
+
+- (instancetype)init {
+    return [self initWithInternTable:[CBORInternTable new]];
+}
+
+- (instancetype)initWithInternTable:(CBORInternTable *)internTable {
+    self = [super init];
+    if (self) {
+        _limits = CBORDecodeLimitsDefault;
+        _internTable = internTable;
+        _stream = [[CBORStream alloc] initWithData:[NSData data]];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    CBORDecodeStackDispose(&_stack);
+}
+
+- (id)decodeData:(NSData *)data {
+    if (![data length]) { return nil; }
+    if (_busy) { return [CBORParser decodeData:data limits:_limits]; }
+    if (_limits.maxBytes && [data length] > _limits.maxBytes) { return nil; }
+    
+    _busy = YES;
+    [_stream resetWithData:data];
+    _stream.internTable = _internTable;
+    id ret = CBORDecodeObjectAtCursor(_stream, _limits, &_stack);
+    // 解码失败时帧栈仍持有未完成的容器
+    CBORDecodeStackReset(&_stack);
+    // 不再持有数据源
+    [_stream resetWithData:[NSData data]];
+    _busy = NO;
+    
+    return ret;
+}
+
+- (id)decodeClass:(Class)aClass fromData:(NSData *)data {
+    // 数组与字典需整体解码，与`CBORParser`一致
+    if (_busy || [aClass isSubclassOfClass:[NSArray class]] || [aClass isSubclassOfClass:[NSDictionary class]]) {
+        return [CBORParser decodeClass:aClass fromData:data];
+    }
+    if (!aClass || ![data length]) { return nil; }
+    
+    _busy = YES;
+    [_stream resetWithData:data];
+    _stream.internTable = _internTable;
+    id ret = [CBORModelDecoder decodeClass:aClass stream:_stream stack:&_stack];
+    [_stream resetWithData:[NSData data]];
+    _busy = NO;
+    
+    return ret;
+}
+
+- (void)reset {
+    CBORDecodeStackDispose(&_stack);
+    [_internTable removeAllStrings];
+}
+
+@end
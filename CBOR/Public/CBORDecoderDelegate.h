@@ -0,0 +1,92 @@
+// refer: https://github.com/DanielHusx/CBOR
+//
+// MIT License
+//
+// Copyright (c) 2024 Daniel
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "CBORConstant.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 不定长数组/键值对的元素数量
+static const UInt64 CBORIndefiniteCount = UINT64_MAX;
+
+/// 事件回调后的处理方式
+typedef NS_ENUM(NSInteger, CBORDecodeAction) {
+    /// 继续解码
+    CBORDecodeActionContinue    = 0,
+    /// 跳过当前容器（数组/键值对/扩展类型/不定长字节数组与字符串）的全部子元素，且不回调其结束事件；
+    /// 对非容器事件等同于继续
+    CBORDecodeActionSkip        = 1,
+    /// 立即停止解码
+    CBORDecodeActionStop        = 2,
+};
+
+/// 事件驱动解码代理
+///
+/// 解码过程中按数据顺序回调事件，不构建任何对象；所有方法均为可选，未实现的事件直接忽略。
+/// 字节数组与字符串的指针直接指向输入数据，仅在回调内有效。
+@protocol CBORDecoderDelegate <NSObject>
+
+@optional
+/// 数组开始
+/// - Parameter count: 元素数量，不定长时为`CBORIndefiniteCount`
+- (CBORDecodeAction)decoderDidBeginArray:(UInt64)count;
+/// 数组结束
+- (CBORDecodeAction)decoderDidEndArray;
+
+/// 键值对开始，之后按 键、值、键、值... 顺序回调
+/// - Parameter count: 键值对数量，不定长时为`CBORIndefiniteCount`
+- (CBORDecodeAction)decoderDidBeginMap:(UInt64)count;
+/// 键值对结束
+- (CBORDecodeAction)decoderDidEndMap;
+
+/// 非负整数
+- (CBORDecodeAction)decoderDidReadUnsigned:(UInt64)value;
+/// 负整数
+/// - Parameter value: 原始值，实际值为 -1 - value
+- (CBORDecodeAction)decoderDidReadNegative:(UInt64)value;
+/// 浮点数（半精度/单精度/双精度）
+- (CBORDecodeAction)decoderDidReadFloat:(Float64)value;
+/// 简单值，包含`false/true/null/undefined`
+- (CBORDecodeAction)decoderDidReadSimple:(UInt8)value;
+/// 扩展标记，随后回调被标记的元素
+- (CBORDecodeAction)decoderDidReadTag:(CBORTagType)tag;
+
+/// 字节数组（不定长字节数组的每个分片单独回调）
+- (CBORDecodeAction)decoderDidReadBytes:(const UInt8 *)bytes length:(NSUInteger)length;
+/// UTF8字符串（不定长字符串的每个分片单独回调），未校验UTF8编码
+- (CBORDecodeAction)decoderDidReadString:(const UInt8 *)bytes length:(NSUInteger)length;
+
+/// 不定长字节数组开始，随后回调各分片
+- (CBORDecodeAction)decoderDidBeginChunkedBytes;
+/// 不定长字节数组结束
+- (CBORDecodeAction)decoderDidEndChunkedBytes;
+/// 不定长字符串开始，随后回调各分片
+- (CBORDecodeAction)decoderDidBeginChunkedString;
+/// 不定长字符串结束
+- (CBORDecodeAction)decoderDidEndChunkedString;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,129 @@
+// refer: https://github.com/DanielHusx/CBOR
+//
+// MIT License
+//
+// Copyright (c) 2024 Daniel
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "CBORConstant.h"
+
+NS_ASSUME_NONNULL_BEGIN
+@class CBORObject, CBORValue;
+
+/// 文档元素类型
+typedef NS_ENUM(UInt8, CBORDocumentType) {
+    /// 非负整数
+    CBORDocumentTypeUnsigned    = 0,
+    /// 负整数
+    CBORDocumentTypeNegative    = 1,
+    /// 字节数组
+    CBORDocumentTypeBytes       = 2,
+    /// UTF8字符串
+    CBORDocumentTypeString      = 3,
+    /// 数组
+    CBORDocumentTypeArray       = 4,
+    /// 键值对
+    CBORDocumentTypeMap         = 5,
+    /// 扩展类型
+    CBORDocumentTypeTag         = 6,
+    /// 浮点数
+    CBORDocumentTypeFloat       = 7,
+    /// 简单值（含false/true/null/undefined）
+    CBORDocumentTypeSimple      = 8,
+};
+
+/// 扁平文档
+///
+/// 解码结果写入一块连续的定长条目数组（前序排列，容器记录子树条目数以便跳过），
+/// 字节数组与字符串仅记录其在数据源中的位置，解码过程不创建任何对象。
+/// 通过`CBORValue`按需访问，并可将任意子树转为原生对象或CBOR对象。
+@interface CBORDocument : NSObject
+
+/// 解码数据，数据非法时返回nil
++ (nullable instancetype)documentWithData:(NSData *)data;
++ (nullable instancetype)documentWithData:(NSData *)data limits:(CBORDecodeLimits)limits;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+/// 数据源
+@property (nonatomic, copy, readonly) NSData *source;
+/// 条目数量
+@property (nonatomic, assign, readonly) NSUInteger count;
+/// 根元素（每次返回新的轻量封装）
+@property (nonatomic, readonly) CBORValue *root;
+
+@end
+
+
+/// 文档元素（文档与条目位置的轻量封装，持有文档）
+@interface CBORValue : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+/// 所属文档
+@property (nonatomic, strong, readonly) CBORDocument *document;
+/// 类型
+@property (nonatomic, assign, readonly) CBORDocumentType type;
+/// 是否是不定长编码
+@property (nonatomic, assign, readonly, getter=isIndefinite) BOOL indefinite;
+/// 数组元素数量、键值对数量或不定长字节数组/字符串的分片数量；其他类型为0
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/// 非负整数或简单值
+@property (nonatomic, assign, readonly) UInt64 unsignedValue;
+/// 整数（负整数超出范围时截断）
+@property (nonatomic, assign, readonly) SInt64 integerValue;
+/// 浮点数，整数也会转换
+@property (nonatomic, assign, readonly) Float64 floatValue;
+/// 是否是`true`
+@property (nonatomic, assign, readonly) BOOL boolValue;
+/// 是否是`null`
+@property (nonatomic, assign, readonly) BOOL isNull;
+/// 扩展标记
+@property (nonatomic, assign, readonly) CBORTagType tag;
+
+/// UTF8字符串，非字符串或编码非法时返回nil
+@property (nonatomic, copy, readonly, nullable) NSString *stringValue;
+/// 字节数组；定长时与数据源共享内存，不拷贝
+@property (nonatomic, copy, readonly, nullable) NSData *dataValue;
+
+/// 数组元素
+- (nullable CBORValue *)objectAtIndexedSubscript:(NSUInteger)index;
+/// 键值对中按键查找值（重复键与完整解码一致取最后一个），字符串键直接比较字节
+- (nullable CBORValue *)objectForKeyedSubscript:(id)key;
+/// 键值对的第index个键
+- (nullable CBORValue *)keyAtIndex:(NSUInteger)index;
+/// 键值对的第index个值
+- (nullable CBORValue *)valueAtIndex:(NSUInteger)index;
+/// 扩展类型的内容
+- (nullable CBORValue *)taggedValue;
+
+/// 子树转为原生对象，与`+[CBORParser decodeData:]`结果一致
+- (nullable id)nsObject;
+/// 子树转为CBOR对象
+- (nullable CBORObject *)cborObject;
+
+@end
+
+NS_ASSUME_NONNULL_END
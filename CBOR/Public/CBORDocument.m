@@ -0,0 +1,510 @@
+// refer: https://github.com/DanielHusx/CBOR
+//
+// MIT License
+//
+// Copyright (c) 2024 Daniel
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import "CBORDocument.h"
+#import "CBORDecoder.h"
+#import "CBORDecodeHeader.h"
+#import "CBORNumber.h"
+#import "CBORUTF8.h"
+
+/// 文档条目（24字节）
+typedef struct {
+    /// 整数值/简单值/浮点数原始位/扩展标记/字符串长度/元素数量（不定长字节数组与字符串为分片数量）
+    UInt64 value;
+    /// 头部在数据源中的位置
+    UInt64 offset;
+    /// 子树条目数量（含自身），用于跳过兄弟元素
+    UInt32 span;
+    /// 类型
+    CBORDocumentType type;
+    /// 次要类型，用于区分浮点数精度
+    UInt8 minor;
+    /// 头部长度，内容起始位置为 offset + headerLength
+    UInt8 headerLength;
+    /// 是否是不定长
+    UInt8 indefinite;
+} CBORDocumentEntry;
+
+/// 条目数组
+typedef struct {
+    CBORDocumentEntry *entries;
+    NSUInteger count;
+    NSUInteger capacity;
+} CBORDocumentTape;
+
+static BOOL CBORDocumentTapeAppend(CBORDocumentTape *tape, CBORDocumentEntry entry) {
+    // 子树条目数量使用32位记录
+    if (tape->count >= UINT32_MAX) { return NO; }
+    
+    if (tape->count == tape->capacity) {
+        NSUInteger capacity = tape->capacity ? tape->capacity * 2 : 64;
+        CBORDocumentEntry *entries = realloc(tape->entries, capacity * sizeof(CBORDocumentEntry));
+        if (!entries) { return NO; }
+        tape->entries = entries;
+        tape->capacity = capacity;
+    }
+    
+    tape->entries[tape->count++] = entry;
+    return YES;
+}
+
+/// 数据写入条目数组（循环解码），与其他解码方式共用头部解析
+static BOOL CBORDocumentFill(CBORCursor *cursor, CBORDecodeLimits limits, CBORDecodeStack *stack, CBORDocumentTape *tape) {
+    const CBORInitialByte *table = CBORInitialByteTable();
+    NSUInteger items = 0;
+    
+    do {
+        NSUInteger offset = cursor->index;
+        CBORDecodeHeader header;
+        if (!CBORDecodeReadHeader(cursor, table, stack, limits, &items, &header)) { return NO; }
+        
+        CBORDecodeKind kind = header.entry.kind;
+        CBORUInt64 argument = header.argument;
+        // 终止符结束当前容器
+        BOOL pop = kind == CBORDecodeKindBreak && stack->depth;
+        
+        if (pop) {
+            // 只能结束不定长容器，且键值对不能终止于键与值之间
+            CBORDecodeFrame *top = &stack->frames[stack->depth - 1];
+            if (!CBORDecodeKindIsIndefinite(top->kind)) { return NO; }
+            if (top->kind == CBORDecodeKindIndefiniteMap && (top->remaining & 1)) { return NO; }
+        } else {
+            CBORDocumentEntry entry = { argument, offset, 1, CBORDocumentTypeUnsigned, header.minor, (UInt8)(cursor->index - offset), NO };
+            // 容器入栈时的子元素数量（定长为剩余数量，不定长为已读数量）
+            UInt64 remaining = 0;
+            BOOL isContainer = NO;
+            
+            switch (kind) {
+                case CBORDecodeKindUnsigned:
+                    entry.type = CBORDocumentTypeUnsigned;
+                    break;
+                case CBORDecodeKindNegative:
+                    entry.type = CBORDocumentTypeNegative;
+                    break;
+                    
+                    // 仅记录位置，不拷贝内容
+                case CBORDecodeKindBytes:
+                case CBORDecodeKindString:
+                    if (!CBORCursorReadBytes(cursor, argument, NULL)) { return NO; }
+                    entry.type = kind == CBORDecodeKindBytes ? CBORDocumentTypeBytes : CBORDocumentTypeString;
+                    break;
+                    
+                case CBORDecodeKindIndefiniteBytes:
+                case CBORDecodeKindIndefiniteString:
+                case CBORDecodeKindIndefiniteArray:
+                case CBORDecodeKindIndefiniteMap:
+                    switch (kind) {
+                        case CBORDecodeKindIndefiniteBytes: entry.type = CBORDocumentTypeBytes; break;
+                        case CBORDecodeKindIndefiniteString: entry.type = CBORDocumentTypeString; break;
+                        case CBORDecodeKindIndefiniteArray: entry.type = CBORDocumentTypeArray; break;
+                        default: entry.type = CBORDocumentTypeMap; break;
+                    }
+                    // 数量在终止时回填
+                    entry.value = 0;
+                    entry.indefinite = YES;
+                    isContainer = YES;
+                    break;
+                    
+                case CBORDecodeKindArray:
+                    // 每个子元素至少占用1字节，声明数量超出剩余数据时提前拒绝
+                    if (argument > CBORCursorRemaining(cursor)) { return NO; }
+                    entry.type = CBORDocumentTypeArray;
+                    remaining = argument;
+                    isContainer = argument != 0;
+                    break;
+                case CBORDecodeKindMap:
+                    if (argument > CBORCursorRemaining(cursor) / 2) { return NO; }
+                    entry.type = CBORDocumentTypeMap;
+                    remaining = argument * 2;
+                    isContainer = argument != 0;
+                    break;
+                case CBORDecodeKindTag:
+                    entry.type = CBORDocumentTypeTag;
+                    remaining = 1;
+                    isContainer = YES;
+                    break;
+                    
+                case CBORDecodeKindHalf:
+                case CBORDecodeKindFloat:
+                case CBORDecodeKindDouble:
+                    entry.type = CBORDocumentTypeFloat;
+                    break;
+                    
+                case CBORDecodeKindSimpleValue:
+                    if (!CBORIsSimpleValue(argument)) { return NO; }
+                    entry.type = CBORDocumentTypeSimple;
+                    break;
+                    // 简单类型，顶层终止符同样按简单类型记录
+                case CBORDecodeKindSimple:
+                case CBORDecodeKindBreak:
+                    entry.type = CBORDocumentTypeSimple;
+                    break;
+                    
+                default:
+                    return NO;
+            }
+            
+            if (!CBORDocumentTapeAppend(tape, entry)) { return NO; }
+            
+            if (isContainer) {
+                CBORDecodeFrame frame = { kind, NULL, NULL, remaining, 0, tape->count - 1 };
+                if (!CBORDecodeStackPush(stack, limits, frame)) { return NO; }
+                continue;
+            }
+        }
+        
+        // 元素完成，逐层回填容器的子树条目数量
+        do {
+            if (pop) {
+                CBORDecodeFrame *top = &stack->frames[stack->depth - 1];
+                CBORDocumentEntry *container = &tape->entries[top->index];
+                container->span = (UInt32)(tape->count - top->index);
+                if (CBORDecodeKindIsIndefinite(top->kind)) {
+                    container->value = top->kind == CBORDecodeKindIndefiniteMap ? top->remaining / 2 : top->remaining;
+                }
+                stack->depth--;
+            }
+            if (!stack->depth) { return YES; }
+            
+            CBORDecodeFrame *top = &stack->frames[stack->depth - 1];
+            if (CBORDecodeKindIsIndefinite(top->kind)) {
+                top->remaining++;
+                pop = NO;
+            } else {
+                pop = !--top->remaining;
+            }
+        } while (pop);
+    } while (YES);
+}
+
+
+@interface CBORDocument ()
+
+- (const CBORDocumentEntry *)entries;
+
+@end
+
+@interface CBORValue ()
+
+- (instancetype)initWithDocument:(CBORDocument *)document index:(NSUInteger)index;
+
+@end
+
+
+@implementation CBORDocument {
+    /// 条目数组
+    CBORDocumentEntry *_entries;
+}
+
++ (instancetype)documentWithData:(NSData *)data {
+    return [self documentWithData:data limits:CBORDecodeLimitsDefault];
+}
+
++ (instancetype)documentWithData:(NSData *)data limits:(CBORDecodeLimits)limits {
+    if (limits.maxBytes && [data length] > limits.maxBytes) { return nil; }
+    
+    NSData *source = [data copy];
+    CBORCursor cursor = { [source bytes], [source length], 0 };
+    CBORDecodeStack stack = { NULL, 0, 0 };
+    CBORDocumentTape tape = { NULL, 0, 0 };
+    
+    BOOL ret = CBORDocumentFill(&cursor, limits, &stack, &tape);
+    CBORDecodeStackDispose(&stack);
+    if (!ret) {
+        free(tape.entries);
+        return nil;
+    }
+    
+    return [[self alloc] initWithSource:source entries:tape.entries count:tape.count];
+}
+
+- (instancetype)initWithSource:(NSData *)source entries:(CBORDocumentEntry *)entries count:(NSUInteger)count {
+    self = [super init];
+    if (self) {
+        _source = source;
+        _entries = entries;
+        _count = count;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    free(_entries);
+}
+
+- (const CBORDocumentEntry *)entries {
+    return _entries;
+}
+
+- (CBORValue *)root {
+    return [[CBORValue alloc] initWithDocument:self index:0];
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"[CBORDocument] count: %lu; source: %lu bytes", (unsigned long)_count, (unsigned long)[_source length]];
+}
+
+@end
+
+
+@implementation CBORValue {
+    /// 条目，生命周期与文档一致
+    const CBORDocumentEntry *_entry;
+    /// 条目位置
+    NSUInteger _index;
+}
+
+- (instancetype)initWithDocument:(CBORDocument *)document index:(NSUInteger)index {
+    self = [super init];
+    if (self) {
+        _document = document;
+        _index = index;
+        _entry = [document entries] + index;
+    }
+    return self;
+}
+
+- (CBORDocumentType)type {
+    return _entry->type;
+}
+
+- (BOOL)isIndefinite {
+    return _entry->indefinite;
+}
+
+- (NSUInteger)count {
+    switch (_entry->type) {
+        case CBORDocumentTypeArray:
+        case CBORDocumentTypeMap:
+            return (NSUInteger)_entry->value;
+        case CBORDocumentTypeBytes:
+        case CBORDocumentTypeString:
+            return _entry->indefinite ? (NSUInteger)_entry->value : 0;
+        default:
+            return 0;
+    }
+}
+
+
+// MARK: - 数值
+- (UInt64)unsignedValue {
+    switch (_entry->type) {
+        case CBORDocumentTypeUnsigned:
+        case CBORDocumentTypeSimple:
+            return _entry->value;
+        default:
+            return 0;
+    }
+}
+
+- (SInt64)integerValue {
+    switch (_entry->type) {
+        case CBORDocumentTypeUnsigned: return (SInt64)_entry->value;
+        case CBORDocumentTypeNegative: return (SInt64)(-(_entry->value + 1));
+        case CBORDocumentTypeFloat: return (SInt64)[self floatValue];
+        default: return 0;
+    }
+}
+
+- (Float64)floatValue {
+    switch (_entry->type) {
+        case CBORDocumentTypeUnsigned: return (Float64)_entry->value;
+        case CBORDocumentTypeNegative: return -1.0 - (Float64)_entry->value;
+        case CBORDocumentTypeFloat: {
+            switch (_entry->minor) {
+                case CBORAdditionalTypeHalf:
+                    return uint16_to_float((uint16_t)_entry->value);
+                case CBORAdditionalTypeFloat: {
+                    UInt32 raw = (UInt32)_entry->value;
+                    Float32 value = 0;
+                    memcpy(&value, &raw, sizeof(value));
+                    return value;
+                }
+                default: {
+                    Float64 value = 0;
+                    memcpy(&value, &_entry->value, sizeof(value));
+                    return value;
+                }
+            }
+        }
+        default: return 0;
+    }
+}
+
+- (BOOL)boolValue {
+    return _entry->type == CBORDocumentTypeSimple && _entry->value == CBORAdditionalTypeTrue;
+}
+
+- (BOOL)isNull {
+    return _entry->type == CBORDocumentTypeSimple && _entry->value == CBORAdditionalTypeNull;
+}
+
+- (CBORTagType)tag {
+    return _entry->type == CBORDocumentTypeTag ? _entry->value : 0;
+}
+
+
+// MARK: - 字节数组 & 字符串
+- (NSString *)stringValue {
+    if (_entry->type != CBORDocumentTypeString) { return nil; }
+    if (!_entry->indefinite) { return [self stringWithEntry:_entry]; }
+    
+    NSMutableString *ret = [NSMutableString string];
+    const CBORDocumentEntry *chunk = _entry + 1;
+    for (NSUInteger index = 0; index < _entry->value; index++, chunk++) {
+        NSString *string = [self stringWithEntry:chunk];
+        if (!string) { return nil; }
+        
+        [ret appendString:string];
+    }
+    return ret;
+}
+
+- (NSData *)dataValue {
+    if (_entry->type != CBORDocumentTypeBytes) { return nil; }
+    if (!_entry->indefinite) { return [self dataWithEntry:_entry]; }
+    
+    NSMutableData *ret = [NSMutableData data];
+    const CBORDocumentEntry *chunk = _entry + 1;
+    for (NSUInteger index = 0; index < _entry->value; index++, chunk++) {
+        [ret appendBytes:[self contentBytesWithEntry:chunk] length:(NSUInteger)chunk->value];
+    }
+    return ret;
+}
+
+
+// MARK: - 子元素
+- (CBORValue *)objectAtIndexedSubscript:(NSUInteger)index {
+    if (_entry->type != CBORDocumentTypeArray || index >= _entry->value) { return nil; }
+    return [self childAtIndex:index];
+}
+
+- (CBORValue *)objectForKeyedSubscript:(id)key {
+    if (_entry->type != CBORDocumentTypeMap || !key) { return nil; }
+    
+    const char *utf8 = NULL;
+    NSUInteger utf8Length = 0;
+    if ([key isKindOfClass:[NSString class]]) {
+        utf8 = [(NSString *)key UTF8String];
+        utf8Length = [(NSString *)key lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+    }
+    
+    // 与完整解码一致，重复键取最后一个匹配的键
+    const CBORDocumentEntry *entries = [_document entries];
+    NSUInteger keyIndex = _index + 1;
+    NSUInteger found = NSNotFound;
+    for (UInt64 pair = 0; pair < _entry->value; pair++) {
+        const CBORDocumentEntry *entry = entries + keyIndex;
+        NSUInteger valueIndex = keyIndex + entry->span;
+        
+        BOOL match = NO;
+        if (utf8 && entry->type == CBORDocumentTypeString && !entry->indefinite) {
+            // 字符串键直接比较字节
+            match = entry->value == utf8Length && memcmp([self contentBytesWithEntry:entry], utf8, utf8Length) == 0;
+        } else if (!utf8 || entry->type == CBORDocumentTypeString) {
+            match = [[[[CBORValue alloc] initWithDocument:_document index:keyIndex] nsObject] isEqual:key];
+        }
+        if (match) { found = valueIndex; }
+        
+        keyIndex = valueIndex + entries[valueIndex].span;
+    }
+    return found == NSNotFound ? nil : [[CBORValue alloc] initWithDocument:_document index:found];
+}
+
+- (CBORValue *)keyAtIndex:(NSUInteger)index {
+    if (_entry->type != CBORDocumentTypeMap || index >= _entry->value) { return nil; }
+    return [self childAtIndex:index * 2];
+}
+
+- (CBORValue *)valueAtIndex:(NSUInteger)index {
+    if (_entry->type != CBORDocumentTypeMap || index >= _entry->value) { return nil; }
+    return [self childAtIndex:index * 2 + 1];
+}
+
+- (CBORValue *)taggedValue {
+    if (_entry->type != CBORDocumentTypeTag) { return nil; }
+    return [self childAtIndex:0];
+}
+
+
+// MARK: - 转化
+- (id)nsObject {
+    // 文档已校验，子树按需解码不再限制
+    return [CBORDecoder decodeObjectWithData:[self subtreeData] limits:CBORDecodeLimitsMake(0, 0, 0)];
+}
+
+- (CBORObject *)cborObject {
+    return [CBORDecoder decodeData:[self subtreeData] limits:CBORDecodeLimitsMake(0, 0, 0)];
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"[CBORValue] type: %hhu, index: %lu; nsObject: %@", _entry->type, (unsigned long)_index, [self nsObject]];
+}
+
+
+// MARK: - Private
+/// 第index个子元素，按子树条目数量跳过兄弟元素
+- (CBORValue *)childAtIndex:(NSUInteger)index {
+    const CBORDocumentEntry *entries = [_document entries];
+    NSUInteger child = _index + 1;
+    for (NSUInteger skip = 0; skip < index; skip++) {
+        child += entries[child].span;
+    }
+    return [[CBORValue alloc] initWithDocument:_document index:child];
+}
+
+- (const UInt8 *)contentBytesWithEntry:(const CBORDocumentEntry *)entry {
+    return (const UInt8 *)[_document.source bytes] + entry->offset + entry->headerLength;
+}
+
+- (NSString *)stringWithEntry:(const CBORDocumentEntry *)entry {
+    return CBORUTF8String([self contentBytesWithEntry:entry], (NSUInteger)entry->value, NO);
+}
+
+- (NSData *)dataWithEntry:(const CBORDocumentEntry *)entry {
+    return [self viewWithBytes:[self contentBytesWithEntry:entry] length:(NSUInteger)entry->value];
+}
+
+/// 子树数据（自子树起始位置至数据源末尾，解码只读取首个元素）
+- (NSData *)subtreeData {
+    NSData *source = _document.source;
+    return [self viewWithBytes:(const UInt8 *)[source bytes] + _entry->offset
+                        length:[source length] - (NSUInteger)_entry->offset];
+}
+
+/// 共享数据源内存的数据视图
+- (NSData *)viewWithBytes:(const UInt8 *)bytes length:(NSUInteger)length {
+    if (!length) { return [NSData data]; }
+    
+    // 视图持有数据源，数据源释放前视图始终有效
+    NSData *source = _document.source;
+    return [[NSData alloc] initWithBytesNoCopy:(void *)bytes
+                                        length:length
+                                   deallocator:^(void *viewBytes, NSUInteger viewLength) {
+        (void)source;
+    }];
+}
+
+@end
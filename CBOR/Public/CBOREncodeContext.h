@@ -0,0 +1,63 @@
+// refer: https://github.com/DanielHusx/CBOR
+//
+// MIT License
+//
+// Copyright (c) 2024 Daniel
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#import <Foundation/Foundation.h>
+#import "CBORConstant.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 可复用的编码上下文
+///
+/// 输出缓冲区在多次编码间保留：对象直接写入缓冲区后拷贝为结果数据，
+/// 稳定状态下编码大小相近的消息除结果数据外不再分配内存（`+[CBORParser encodeObject:]`每次从空缓冲区开始增长）。
+///
+/// - Attentions: 非线程安全；`+currentContext`返回当前线程独享的实例
+@interface CBOREncodeContext : NSObject
+
+/// 当前线程的编码上下文，线程结束时释放
++ (instancetype)currentContext;
+
+/// 编码选项
+@property (nonatomic, assign) CBOREncodeOptions options;
+/// 编码结束后保留的最大缓冲区容量，超过时释放缓冲区，避免偶发的大数据长期占用内存；默认1MB
+@property (nonatomic, assign) NSUInteger maximumRetainedCapacity;
+/// 当前保留的缓冲区容量
+@property (nonatomic, assign, readonly) NSUInteger bufferCapacity;
+
+/// 初始化，首次编码时分配缓冲区
+- (instancetype)init;
+/// 指定初始缓冲区容量初始化
+- (instancetype)initWithCapacity:(NSUInteger)capacity NS_DESIGNATED_INITIALIZER;
+
+/// 编码对象，结果与`+[CBORParser encodeObject:options:]`一致
+- (nullable NSData *)encodeObject:(id)obj;
+/// 按指定类型编码对象；参考`+[CBORParser encodeObject:major:minor:]`
+- (nullable NSData *)encodeObject:(id)obj major:(CBORMajorType)major minor:(CBORMinorType)minor;
+
+/// 释放缓冲区
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,96 @@
+// refer: https://github.com/DanielHusx/CBOR
+//
+// MIT License
+//
+// Copyright (c) 2024 Daniel
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#import "CBOREncodeContext.h"
+#import "CBOREncoder.h"
+#import "CBORWriter.h"
+
+/// 默认保留的最大缓冲区容量
+#define CBOREncodeContextDefaultRetainedCapacity (1024 * 1024)
+
+/// 线程字典中当前线程编码上下文的键
+static NSString * const CBOREncodeContextThreadKey = @"CBOREncodeContext";
+
+@implementation CBOREncodeContext {
+    /// 保留的写入器
+    CBORWriter _writer;
+    /// 编码中：嵌套调用（如模型自定义转换中再次编码）时不能复用缓冲区
+    BOOL _busy;
+}
+
++ (instancetype)currentContext {
+    NSMutableDictionary *dictionary = [[NSThread currentThread] threadDictionary];
+    CBOREncodeContext *context = dictionary[CBOREncodeContextThreadKey];
+    if (!context) {
+        context = [self new];
+        dictionary[CBOREncodeContextThreadKey] = context;
+    }
+    return context;
+}
+
+- (instancetype)init {
+    return [self initWithCapacity:0];
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity {
+    self = [super init];
+    if (self) {
+        CBORWriterInit(&_writer, capacity);
+        _maximumRetainedCapacity = MAX(CBOREncodeContextDefaultRetainedCapacity, capacity);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    CBORWriterDispose(&_writer);
+}
+
+- (NSUInteger)bufferCapacity {
+    return _writer.capacity;
+}
+
+- (NSData *)encodeObject:(id)obj {
+    return [self encodeObject:obj major:CBORUnknownMajorType minor:CBORUnknownMinorType];
+}
+
+- (NSData *)encodeObject:(id)obj major:(CBORMajorType)major minor:(CBORMinorType)minor {
+    if (!obj) { return nil; }
+    if (_busy) { return [CBOREncoder encodeDataWithObject:obj major:major minor:minor options:_options]; }
+    
+    _busy = YES;
+    CBORWriterReset(&_writer);
+    BOOL written = [CBOREncoder writeObject:obj major:major minor:minor options:_options toWriter:&_writer];
+    NSData *ret = (written && !_writer.failed) ? [NSData dataWithBytes:_writer.bytes length:_writer.length] : nil;
+    if (_writer.capacity > _maximumRetainedCapacity) { CBORWriterDispose(&_writer); }
+    _busy = NO;
+    
+    return ret;
+}
+
+- (void)reset {
+    CBORWriterDispose(&_writer);
+    CBORWriterReset(&_writer);
+}
+
+@end
@@ -0,0 +1,73 @@
+// refer: https://github.com/DanielHusx/CBOR
+//
+// MIT License
+//
+// Copyright (c) 2024 Daniel
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "CBORConstant.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 增量解码器（推模式）
+///
+/// 适用于分块到达的数据（例如网络套接字）：每次收到数据调用`-feed:`，
+/// 解码器保留未完成元素的扫描状态，不会从头重复解析；
+/// 每当一个顶层元素的最后一个字节到达时立即通过`itemHandler`回调解码结果。
+///
+/// - Attentions: 非线程安全；请勿在`itemHandler`中再次调用`-feed:`或`-reset`
+@interface CBORIncrementalDecoder : NSObject
+
+/// 顶层元素解码完成回调，参数为原生对象`NSData, NSNumber, NSString, NSArray, NSDictionary, NSNull...`
+@property (nonatomic, copy, nullable) void (^itemHandler)(id object);
+
+/// 最近一次`-feed:`后的状态
+/// - `CBORDecodeStatusOK`: 已输入的数据均已解码
+/// - `CBORDecodeStatusNeedMoreData`: 存在未完成的元素，等待后续数据
+/// - `CBORDecodeStatusMalformed`: 数据格式错误，需`-reset`后才能继续使用
+@property (nonatomic, assign, readonly) CBORDecodeStatus status;
+
+/// 已回调的顶层元素数量
+@property (nonatomic, assign, readonly) NSUInteger decodedCount;
+
+/// 解码限制，分别作用于每个顶层元素
+@property (nonatomic, assign, readonly) CBORDecodeLimits limits;
+
+/// 初始化，使用默认解码限制`CBORDecodeLimitsDefault`
+- (instancetype)initWithItemHandler:(nullable void (^)(id object))itemHandler;
+
+/// 初始化
+/// - Parameter limits: 解码限制；扫描时声明的长度/数量、已缓存的字节数或嵌套深度一旦超出即返回`CBORDecodeStatusMalformed`，
+///   不等待数据到达；未限制字节数时，声明超长的字节数组/字符串会持续缓存
+- (instancetype)initWithItemHandler:(nullable void (^)(id object))itemHandler limits:(CBORDecodeLimits)limits;
+
+/// 输入数据
+/// - Parameter data: 任意长度的后续数据
+/// - Returns: 输入后的解码状态
+- (CBORDecodeStatus)feed:(NSData *)data;
+
+/// 清空缓存与扫描状态
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,314 @@
+// refer: https://github.com/DanielHusx/CBOR
+//
+// MIT License
+//
+// Copyright (c) 2024 Daniel
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import "CBORIncrementalDecoder.h"
+#import "CBORParser.h"
+#import "CBORUtils.h"
+
+/// 单次扫描结果
+typedef NS_ENUM(NSUInteger, CBORScanResult) {
+    /// 继续扫描
+    CBORScanResultContinue,
+    /// 顶层元素完整
+    CBORScanResultComplete,
+    /// 需要更多数据
+    CBORScanResultNeedMoreData,
+    /// 数据格式错误
+    CBORScanResultMalformed,
+};
+
+/// 扫描帧（未完成的容器）
+typedef struct {
+    /// 主要类型
+    CBORMajorType major;
+    /// 是否不定长
+    BOOL indefinite;
+    /// 定长：剩余子元素数量（键值对的键与值分别计数）；不定长：已读取子元素数量
+    UInt64 count;
+} CBORScanFrame;
+
+/// 头部后续字节长度
+/// - Returns: 0/1/2/4/8；保留值(28~30)返回-1
+static inline NSInteger CBORScanArgumentLength(CBORByte minor) {
+    if (minor <= CBORLengthTypeMaxValue) return 0;
+    if (minor <= CBORLengthTypeMaxDefined) return 1 << (minor - CBORLengthTypeUInt8);
+    if (minor == CBORAdditionalTypeIndefinite) return 0;
+    return -1;
+}
+
+@implementation CBORIncrementalDecoder {
+    /// 未解码的数据缓存
+    NSMutableData *_buffer;
+    /// 当前顶层元素在缓存中的起始位置
+    NSUInteger _itemStart;
+    /// 扫描位置
+    NSUInteger _scanIndex;
+    
+    /// 头部（首字节 + 最多8字节参数）
+    CBORByte _header[9];
+    /// 已读取的头部长度
+    NSUInteger _headerLength;
+    /// 头部总长度
+    NSUInteger _headerNeeded;
+    /// 字节数组/字符串剩余待跳过长度
+    UInt64 _payloadRemaining;
+    
+    /// 扫描帧栈
+    CBORScanFrame *_frames;
+    NSUInteger _depth;
+    NSUInteger _capacity;
+    
+    /// 当前顶层元素已读取的元素数量（不含终止符）
+    NSUInteger _items;
+}
+
+- (instancetype)init {
+    return [self initWithItemHandler:nil];
+}
+
+- (instancetype)initWithItemHandler:(void (^)(id))itemHandler {
+    return [self initWithItemHandler:itemHandler limits:CBORDecodeLimitsDefault];
+}
+
+- (instancetype)initWithItemHandler:(void (^)(id))itemHandler limits:(CBORDecodeLimits)limits {
+    self = [super init];
+    if (self) {
+        _itemHandler = [itemHandler copy];
+        _limits = limits;
+        _buffer = [NSMutableData data];
+        _status = CBORDecodeStatusOK;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    free(_frames);
+}
+
+- (void)reset {
+    [_buffer setLength:0];
+    _itemStart = 0;
+    _scanIndex = 0;
+    _headerLength = 0;
+    _headerNeeded = 0;
+    _payloadRemaining = 0;
+    _depth = 0;
+    _items = 0;
+    _status = CBORDecodeStatusOK;
+}
+
+- (CBORDecodeStatus)feed:(NSData *)data {
+    if (_status == CBORDecodeStatusMalformed) { return _status; }
+    if ([data length]) { [_buffer appendData:data]; }
+    
+    const UInt8 *bytes = [_buffer bytes];
+    NSUInteger length = [_buffer length];
+    
+    // 仅扫描新到达的数据，扫描状态跨调用保留
+    while (_scanIndex < length) {
+        CBORScanResult result = [self scanBytes:bytes length:length];
+        if (result == CBORScanResultMalformed) { return [self malformed]; }
+        if (result != CBORScanResultComplete) { break; }
+        
+        NSData *item = [NSData dataWithBytes:bytes + _itemStart length:_scanIndex - _itemStart];
+        _itemStart = _scanIndex;
+        _items = 0;
+        
+        id object = [CBORParser decodeData:item limits:_limits];
+        if (!object) { return [self malformed]; }
+        
+        _decodedCount++;
+        if (_itemHandler) { _itemHandler(object); }
+    }
+    
+    // 丢弃已解码的数据，每次输入仅移动一次
+    if (_itemStart) {
+        [_buffer replaceBytesInRange:NSMakeRange(0, _itemStart) withBytes:NULL length:0];
+        _scanIndex -= _itemStart;
+        _itemStart = 0;
+    }
+    
+    _status = _scanIndex ? CBORDecodeStatusNeedMoreData : CBORDecodeStatusOK;
+    return _status;
+}
+
+
+// MARK: - Private
+- (CBORDecodeStatus)malformed {
+    _status = CBORDecodeStatusMalformed;
+    return _status;
+}
+
+/// 扫描至顶层元素结束或数据耗尽
+- (CBORScanResult)scanBytes:(const UInt8 *)bytes length:(NSUInteger)length {
+    while (_scanIndex < length) {
+        // 跳过字节数组/字符串内容
+        if (_payloadRemaining) {
+            UInt64 skip = MIN((UInt64)(length - _scanIndex), _payloadRemaining);
+            _scanIndex += (NSUInteger)skip;
+            _payloadRemaining -= skip;
+            if (_payloadRemaining) { return CBORScanResultNeedMoreData; }
+            
+            if ([self completeItem]) { return CBORScanResultComplete; }
+            continue;
+        }
+        
+        // 读取首字节
+        if (!_headerLength) {
+            CBORByte initial = bytes[_scanIndex++];
+            NSInteger argumentLength = CBORScanArgumentLength(CBORTypeMinor(initial));
+            if (argumentLength < 0) { return CBORScanResultMalformed; }
+            
+            _header[0] = initial;
+            _headerLength = 1;
+            _headerNeeded = 1 + argumentLength;
+        }
+        
+        // 读取参数（可能跨多次输入）
+        while (_headerLength < _headerNeeded && _scanIndex < length) {
+            _header[_headerLength++] = bytes[_scanIndex++];
+        }
+        if (_headerLength < _headerNeeded) { return CBORScanResultNeedMoreData; }
+        
+        _headerLength = 0;
+        CBORScanResult result = [self processHeader];
+        if (result != CBORScanResultContinue) { return result; }
+    }
+    return CBORScanResultNeedMoreData;
+}
+
+/// 处理完整的头部
+- (CBORScanResult)processHeader {
+    CBORMajorType major = CBORTypeMajor(_header[0]);
+    CBORByte minor = CBORTypeMinor(_header[0]);
+    BOOL indefinite = minor == CBORAdditionalTypeIndefinite;
+    
+    UInt64 argument = minor <= CBORLengthTypeMaxValue ? minor : 0;
+    for (NSUInteger index = 1; index < _headerNeeded; index++) {
+        argument = (argument << 8) | _header[index];
+    }
+    
+    BOOL isBreak = major == CBORMajorTypeAdditional && indefinite;
+    
+    // 超出限制时立即拒绝，不再缓存后续数据
+    UInt64 consumed = _scanIndex - _itemStart;
+    if (_limits.maxBytes && consumed > _limits.maxBytes) { return CBORScanResultMalformed; }
+    if (!isBreak && _limits.maxItems && ++_items > _limits.maxItems) { return CBORScanResultMalformed; }
+    
+    // 不定长字节数组/字符串的子元素必须是同类型的定长元素
+    if (_depth && !isBreak) {
+        CBORScanFrame *top = &_frames[_depth - 1];
+        if (top->indefinite
+            && (top->major == CBORMajorTypeBytes || top->major == CBORMajorTypeString)
+            && (top->major != major || indefinite)) {
+            return CBORScanResultMalformed;
+        }
+    }
+    
+    switch (major) {
+        case CBORMajorTypeUnsigned:
+        case CBORMajorTypeNegative:
+            if (indefinite) { return CBORScanResultMalformed; }
+            break;
+        case CBORMajorTypeBytes:
+        case CBORMajorTypeString:
+            if (indefinite) { return [self pushFrame:major indefinite:YES count:0]; }
+            if (_limits.maxBytes && argument > _limits.maxBytes - consumed) { return CBORScanResultMalformed; }
+            if (argument) {
+                _payloadRemaining = argument;
+                return CBORScanResultContinue;
+            }
+            break;
+        case CBORMajorTypeArray:
+            if (indefinite) { return [self pushFrame:major indefinite:YES count:0]; }
+            if (![self acceptCount:argument consumed:consumed]) { return CBORScanResultMalformed; }
+            if (argument) { return [self pushFrame:major indefinite:NO count:argument]; }
+            break;
+        case CBORMajorTypeMap:
+            if (indefinite) { return [self pushFrame:major indefinite:YES count:0]; }
+            if (argument > UINT64_MAX / 2) { return CBORScanResultMalformed; }
+            if (![self acceptCount:argument * 2 consumed:consumed]) { return CBORScanResultMalformed; }
+            if (argument) { return [self pushFrame:major indefinite:NO count:argument * 2]; }
+            break;
+        case CBORMajorTypeTag:
+            if (indefinite) { return CBORScanResultMalformed; }
+            return [self pushFrame:major indefinite:NO count:1];
+        case CBORMajorTypeAdditional: {
+            if (!isBreak) { break; }
+            // 单独的终止符不是数据项
+            if (!_depth) { return CBORScanResultMalformed; }
+            
+            // 终止符只能结束不定长容器，且键值对不能终止于键与值之间
+            CBORScanFrame *top = &_frames[_depth - 1];
+            if (!top->indefinite) { return CBORScanResultMalformed; }
+            if (top->major == CBORMajorTypeMap && (top->count & 1)) { return CBORScanResultMalformed; }
+            _depth--;
+        } break;
+        default:
+            return CBORScanResultMalformed;
+    }
+    
+    return [self completeItem] ? CBORScanResultComplete : CBORScanResultContinue;
+}
+
+/// 定长容器声明的子元素数量是否可能满足限制：每个子元素至少占用1字节、计为1个元素
+- (BOOL)acceptCount:(UInt64)count consumed:(UInt64)consumed {
+    if (_limits.maxBytes && count > _limits.maxBytes - consumed) { return NO; }
+    if (_limits.maxItems && count > _limits.maxItems - _items) { return NO; }
+    return YES;
+}
+
+/// 压入扫描帧
+- (CBORScanResult)pushFrame:(CBORMajorType)major indefinite:(BOOL)indefinite count:(UInt64)count {
+    if (_limits.maxDepth && _depth >= _limits.maxDepth) { return CBORScanResultMalformed; }
+    if (_depth == _capacity) {
+        NSUInteger capacity = _capacity ? _capacity * 2 : 16;
+        CBORScanFrame *frames = realloc(_frames, capacity * sizeof(CBORScanFrame));
+        if (!frames) { return CBORScanResultMalformed; }
+        _frames = frames;
+        _capacity = capacity;
+    }
+    _frames[_depth++] = (CBORScanFrame){ major, indefinite, count };
+    return CBORScanResultContinue;
+}
+
+/// 一个元素读取完毕，向上更新容器
+/// - Returns: 顶层元素是否完整
+- (BOOL)completeItem {
+    while (_depth) {
+        CBORScanFrame *top = &_frames[_depth - 1];
+        if (top->indefinite) {
+            top->count++;
+            return NO;
+        }
+        if (--top->count) { return NO; }
+        
+        // 定长容器已完整，其自身作为父容器的子元素
+        _depth--;
+    }
+    return YES;
+}
+
+@end
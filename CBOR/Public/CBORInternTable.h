@@ -0,0 +1,59 @@
+// refer: https://github.com/DanielHusx/CBOR
+//
+// MIT License
+//
+// Copyright (c) 2024 Daniel
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 字符串驻留表：按UTF8原始字节散列，重复出现的字符串返回同一个不可变实例
+///
+/// 解码时默认每次解码使用独立的驻留表缓存键值对的键；同类数据反复解码时可传入共享实例，
+/// 驻留表线程安全，条目数达到容量后不再新增。
+@interface CBORInternTable : NSObject
+
+/// 默认容量4096
+- (instancetype)init;
+/// 指定容量初始化
+/// - Parameter capacity: 最大条目数
+- (instancetype)initWithCapacity:(NSUInteger)capacity NS_DESIGNATED_INITIALIZER;
+
+/// 最大条目数
+@property (nonatomic, assign, readonly) NSUInteger capacity;
+/// 当前条目数
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/// 驻留字符串
+/// - Parameters:
+///   - bytes: UTF8字节
+///   - length: 字节长度，超过64字节的字符串不驻留
+/// - Returns: 已驻留时返回同一实例；UTF8编码非法时返回nil
+- (nullable NSString *)stringWithUTF8Bytes:(const void *)bytes length:(NSUInteger)length;
+
+/// 清空驻留表
+- (void)removeAllStrings;
+
+@end
+
+NS_ASSUME_NONNULL_END
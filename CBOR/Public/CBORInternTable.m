@@ -0,0 +1,175 @@
+// refer: https://github.com/DanielHusx/CBOR
+//
+// MIT License
+//
+// Copyright (c) 2024 Daniel
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import "CBORInternTable.h"
+#import "CBORUTF8.h"
+#import <os/lock.h>
+
+/// 驻留字符串的最大字节长度
+static const NSUInteger CBORInternMaxLength = 64;
+/// 初始槽位数
+static const NSUInteger CBORInternInitialSlots = 64;
+
+/// 驻留槽位：保存原始字节用于比较，字符串以CF引用持有
+typedef struct {
+    UInt32 hash;
+    UInt32 length;
+    UInt8 *bytes;
+    CFTypeRef string;
+} CBORInternSlot;
+
+/// FNV-1a散列
+static inline UInt32 CBORInternHash(const UInt8 *bytes, NSUInteger length) {
+    UInt32 hash = 2166136261u;
+    for (NSUInteger i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/// 线性探测查找：返回匹配槽位或首个空槽位
+static inline CBORInternSlot *CBORInternProbe(CBORInternSlot *slots, NSUInteger mask, UInt32 hash, const UInt8 *bytes, NSUInteger length) {
+    NSUInteger index = hash & mask;
+    while (slots[index].string) {
+        CBORInternSlot *slot = &slots[index];
+        if (slot->hash == hash && slot->length == length && !memcmp(slot->bytes, bytes, length)) { return slot; }
+        index = (index + 1) & mask;
+    }
+    return &slots[index];
+}
+
+@implementation CBORInternTable {
+    os_unfair_lock _lock;
+    CBORInternSlot *_slots;
+    NSUInteger _mask;
+}
+
+- (instancetype)init {
+    return [self initWithCapacity:4096];
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity {
+    self = [super init];
+    if (self) {
+        _lock = OS_UNFAIR_LOCK_INIT;
+        _capacity = capacity;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [self clearSlots];
+}
+
+- (NSUInteger)count {
+    os_unfair_lock_lock(&_lock);
+    NSUInteger count = _count;
+    os_unfair_lock_unlock(&_lock);
+    return count;
+}
+
+- (NSString *)stringWithUTF8Bytes:(const void *)bytes length:(NSUInteger)length {
+    if (length > CBORInternMaxLength || !_capacity) {
+        return CBORUTF8String(bytes, length, NO);
+    }
+    
+    UInt32 hash = CBORInternHash(bytes, length);
+    os_unfair_lock_lock(&_lock);
+    CBORInternSlot *slot = _slots ? CBORInternProbe(_slots, _mask, hash, bytes, length) : NULL;
+    if (slot && slot->string) {
+        NSString *string = (__bridge NSString *)slot->string;
+        os_unfair_lock_unlock(&_lock);
+        return string;
+    }
+    os_unfair_lock_unlock(&_lock);
+    
+    NSString *string = CBORUTF8String(bytes, length, NO);
+    if (!string) { return nil; }
+    
+    os_unfair_lock_lock(&_lock);
+    if (_count < _capacity && [self reserveSlots]) {
+        // 解锁期间可能已被其他线程驻留
+        slot = CBORInternProbe(_slots, _mask, hash, bytes, length);
+        if (slot->string) {
+            string = (__bridge NSString *)slot->string;
+        } else if ((slot->bytes = malloc(length ?: 1))) {
+            memcpy(slot->bytes, bytes, length);
+            slot->hash = hash;
+            slot->length = (UInt32)length;
+            slot->string = CFBridgingRetain(string);
+            _count++;
+        }
+    }
+    os_unfair_lock_unlock(&_lock);
+    
+    return string;
+}
+
+- (void)removeAllStrings {
+    os_unfair_lock_lock(&_lock);
+    [self clearSlots];
+    os_unfair_lock_unlock(&_lock);
+}
+
+// MARK: - Private
+/// 保证新增一个条目后负载不超过1/2，需在加锁时调用
+- (BOOL)reserveSlots {
+    NSUInteger slotCount = _slots ? _mask + 1 : 0;
+    if ((_count + 1) * 2 <= slotCount) { return YES; }
+    
+    NSUInteger newCount = slotCount ? slotCount * 2 : CBORInternInitialSlots;
+    CBORInternSlot *slots = calloc(newCount, sizeof(CBORInternSlot));
+    if (!slots) { return NO; }
+    
+    for (NSUInteger i = 0; i < slotCount; i++) {
+        if (!_slots[i].string) { continue; }
+        NSUInteger index = _slots[i].hash & (newCount - 1);
+        while (slots[index].string) { index = (index + 1) & (newCount - 1); }
+        slots[index] = _slots[i];
+    }
+    
+    free(_slots);
+    _slots = slots;
+    _mask = newCount - 1;
+    return YES;
+}
+
+/// 释放所有条目，需在加锁时调用
+- (void)clearSlots {
+    if (!_slots) { return; }
+    
+    for (NSUInteger i = 0; i <= _mask; i++) {
+        if (!_slots[i].string) { continue; }
+        free(_slots[i].bytes);
+        CFRelease(_slots[i].string);
+    }
+    free(_slots);
+    _slots = NULL;
+    _mask = 0;
+    _count = 0;
+}
+
+@end
@@ -41,6 +41,11 @@ NS_ASSUME_NONNULL_BEGIN
 /// 自定义属性替换对应JSON的Key列表，例如： `@{@"desc"  : @"ext.desc", @"bookID": @[@"id", @"ID", @"book_id"]};`
 + (nullable NSDictionary<NSString *, id> *)modelCustomPropertyMapper;
 
+/// 自定义属性编码为整数键（COSE/CWT风格），例如：`@{@"alg" : @1, @"kid" : @4, @"iv" : @5};`
+///
+/// 编码时整数键替代映射的Key或KeyPath，-24~23内的键只占1个字节；解码时按整数直接查表，同时兼容原有的字符串键
++ (nullable NSDictionary<NSString *, NSNumber *> *)modelCustomPropertyIntegerKeys;
+
 /// 定义属性指定的对象类，例如： `@{@"borders" : YYBorder.class, @"attachments" : @"YYAttachment" };`
 + (nullable NSDictionary<NSString *, id> *)modelContainerPropertyGenericClass;
 
@@ -25,6 +25,9 @@
 
 #import <Foundation/Foundation.h>
 #import "CBORConstant.h"
+#import "CBORDecoderDelegate.h"
+#import "CBORInternTable.h"
+#import "CBORTypedArray.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -45,6 +48,26 @@ NS_ASSUME_NONNULL_BEGIN
 + (nullable NSData *)encodeObject:(id)obj
                             major:(CBORMajorType)major
                             minor:(CBORMinorType)minor;
+/// 按编码选项编码对象
+/// - Parameters:
+///   - obj: 模型对象
+///   - options: 编码选项，如`CBOREncodeOptionsTypedArrays`将数值数组编码为类型化数组
++ (nullable NSData *)encodeObject:(id)obj options:(CBOREncodeOptions)options;
+/// 批量编码为定长数组，输出与`+encodeObject:`编码同一数组完全一致
+/// - Parameters:
+///   - objects: 元素列表，如大量模型对象
+///   - parallel: 为YES且元素较多时分块由多个线程编码，再按顺序拼接
+/// - Returns: 任一元素无法编码时返回nil
++ (nullable NSData *)encodeObjects:(NSArray *)objects parallel:(BOOL)parallel;
+/// 批量编码为CBOR序列（RFC 8742），每个元素一条记录，与逐条`+encodeObject:`拼接一致
+/// - Returns: 任一元素无法编码时返回nil
++ (nullable NSData *)encodeSequenceOfObjects:(NSArray *)objects parallel:(BOOL)parallel;
+/// 编码后的字节数，不分配输出内存，可用于预先分配或限制数据大小
+/// - Parameter obj: 模型对象
+/// - Returns: 与`+encodeObject:`输出的长度一致，无法编码时返回0
++ (NSUInteger)encodedLengthOfObject:(id)obj;
+/// 按编码选项计算编码后的字节数
++ (NSUInteger)encodedLengthOfObject:(id)obj options:(CBOREncodeOptions)options;
 
 
 // MARK: - Decode
@@ -52,7 +75,48 @@ NS_ASSUME_NONNULL_BEGIN
 /// - Parameter data: CBOR数据（大端）
 /// - Returns: 解析后的原生对象`NSData, NSDate, NSNumber, NSString, NSArray, NSDictionary, NSNull...`
 + (nullable id)decodeData:(NSData *)data;
-/// 解码字典数据
+/// 解码数据（限制解码规模）
+/// - Parameters:
+///   - data: CBOR数据（大端）
+///   - limits: 嵌套深度、元素数量与数据长度限制，超出时返回nil
++ (nullable id)decodeData:(NSData *)data limits:(CBORDecodeLimits)limits;
+/// 解码数据，键值对的键通过共享驻留表复用（同类数据反复解码时使用）
+/// - Parameters:
+///   - data: CBOR数据（大端）
+///   - internTable: 驻留表，可在多次、多线程解码间共享
++ (nullable id)decodeData:(NSData *)data internTable:(CBORInternTable *)internTable;
+/// 解码文件：以内存映射方式读取，字节数组返回共享映射内存的数据视图，常驻内存只随实际访问的数据增长
+/// - Note: 始终映射，解码结果释放前文件不可被修改或截断
+/// - Parameters:
+///   - path: 文件路径
+///   - options: 解码选项，`CBORDecodeOptionsNoCopyStrings`时字符串同样不拷贝
+/// - Returns: 与`+decodeData:`结果一致，文件无法读取时返回nil
++ (nullable id)decodeContentsOfFile:(NSString *)path options:(CBORDecodeOptions)options;
+/// 并行解码：顶层为大数组时扫描元素边界，分配到多个线程解码后按顺序组装；其他数据按顺序解码
+/// - Parameter data: CBOR数据（大端）
+/// - Returns: 与`+decodeData:`结果一致
++ (nullable id)decodeDataConcurrently:(NSData *)data;
+/// 批量解码相互独立的数据，分配到多个线程
+/// - Parameter batch: CBOR数据列表
+/// - Returns: 与输入顺序一致的解码结果，解码失败的位置为`NSNull`
++ (NSArray *)decodeDataBatch:(NSArray<NSData *> *)batch;
+/// 事件驱动解码，仅需部分字段或对大数据做统计时使用，不构建任何对象
+/// - Parameters:
+///   - data: CBOR数据（大端）
+///   - delegate: 事件代理，可提前停止或跳过子元素
+/// - Returns: 数据结构合法或被代理停止时返回YES；不校验字符串的UTF8编码，单独的终止符（`0xff`）不合法
++ (BOOL)decodeData:(NSData *)data delegate:(id<CBORDecoderDelegate>)delegate;
++ (BOOL)decodeData:(NSData *)data delegate:(id<CBORDecoderDelegate>)delegate limits:(CBORDecodeLimits)limits;
+/// 按路径解码单个元素，仅构建目标元素，其余元素按长度前缀扫描跳过
+///
+///     [CBORParser valueAtPath:@[@"meta", @"items", @3, @"id"] inData:data];
+///
+/// - Parameters:
+///   - path: 路径，`NSNumber`作为数组下标，其他对象作为键值对的键（重复键与完整解码一致取最后一个）；扩展类型对路径透明
+///   - data: CBOR数据（大端）
+/// - Returns: 目标元素的原生对象，路径不存在或数据非法时返回nil
++ (nullable id)valueAtPath:(NSArray *)path inData:(NSData *)data;
+/// 解码字典数据，模型直接从数据单次遍历构建（不构建中间字典），结果与先解码再`+cbor_modelWithJSON:`一致
 /// - Parameters:
 ///   - aClass: 解析成指定类实例对象
 ///   - data: CBOR数据（大端），必须是字典类型数据，否则结果将返回nil
@@ -29,6 +29,7 @@
 #import "CBORObject.h"
 #import "CBORMap.h"
 #import "NSObject+CBORModel.h"
+#import "CBORModelDecoder.h"
 
 @implementation CBORParser
 
@@ -47,23 +48,103 @@
 }
 
 + (NSData *)encodeObject:(id)obj major:(CBORMajorType)major minor:(CBORMinorType)minor {
-    CBORObject *cbor = [CBOREncoder encodeObject:obj
-                                           major:major
-                                           minor:minor];
-    
-    return [cbor cborData];
+    // 直接写入同一块内存，不经过CBOR对象树
+    return [CBOREncoder encodeDataWithObject:obj
+                                       major:major
+                                       minor:minor
+                                     options:CBOREncodeOptionsNone];
+}
+
++ (NSData *)encodeObject:(id)obj options:(CBOREncodeOptions)options {
+    return [CBOREncoder encodeDataWithObject:obj
+                                       major:CBORUnknownMajorType
+                                       minor:CBORUnknownMinorType
+                                     options:options];
+}
+
++ (NSData *)encodeObjects:(NSArray *)objects parallel:(BOOL)parallel {
+    return [CBOREncoder encodeDataWithObjects:objects sequence:NO parallel:parallel];
+}
+
++ (NSData *)encodeSequenceOfObjects:(NSArray *)objects parallel:(BOOL)parallel {
+    return [CBOREncoder encodeDataWithObjects:objects sequence:YES parallel:parallel];
+}
+
++ (NSUInteger)encodedLengthOfObject:(id)obj {
+    return [self encodedLengthOfObject:obj options:CBOREncodeOptionsNone];
+}
+
++ (NSUInteger)encodedLengthOfObject:(id)obj options:(CBOREncodeOptions)options {
+    return [CBOREncoder encodedLengthOfObject:obj
+                                        major:CBORUnknownMajorType
+                                        minor:CBORUnknownMinorType
+                                      options:options];
 }
 
 
 // MARK: - Decode
 + (nullable id)decodeData:(NSData *)data {
-    CBORObject *cbor = [CBORDecoder decodeData:data];
-    if (!cbor) { return nil; }
+    return [self decodeData:data limits:CBORDecodeLimitsDefault];
+}
+
++ (nullable id)decodeData:(NSData *)data limits:(CBORDecodeLimits)limits {
+    // 调用方无需中间CBOR对象，直接解码为原生对象
+    return [CBORDecoder decodeObjectWithData:data limits:limits];
+}
+
++ (nullable id)decodeData:(NSData *)data internTable:(CBORInternTable *)internTable {
+    return [CBORDecoder decodeObjectWithData:data limits:CBORDecodeLimitsDefault internTable:internTable];
+}
+
++ (nullable id)decodeContentsOfFile:(NSString *)path options:(CBORDecodeOptions)options {
+    return [CBORDecoder decodeObjectWithContentsOfFile:path options:options limits:CBORDecodeLimitsDefault];
+}
+
++ (nullable id)decodeDataConcurrently:(NSData *)data {
+    return [CBORDecoder decodeObjectConcurrentlyWithData:data limits:CBORDecodeLimitsDefault];
+}
+
++ (NSArray *)decodeDataBatch:(NSArray<NSData *> *)batch {
+    NSArray *payloads = [batch copy];
+    NSUInteger count = [payloads count];
+    if (!count) { return @[]; }
+    
+    CFTypeRef *results = calloc(count, sizeof(CFTypeRef));
+    if (!results) { return @[]; }
+    
+    // dispatch_apply由空闲线程按需领取下标，数据大小不均时自动均衡负载
+    dispatch_apply(count, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t index) {
+        id object = [self decodeData:payloads[index]];
+        if (object) { results[index] = CFBridgingRetain(object); }
+    });
+    
+    NSMutableArray *ret = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger index = 0; index < count; index++) {
+        [ret addObject:results[index] ? CFBridgingRelease(results[index]) : [NSNull null]];
+    }
+    free(results);
     
-    return [cbor nsObject];
+    return ret;
+}
+
++ (BOOL)decodeData:(NSData *)data delegate:(id<CBORDecoderDelegate>)delegate {
+    return [self decodeData:data delegate:delegate limits:CBORDecodeLimitsDefault];
+}
+
++ (BOOL)decodeData:(NSData *)data delegate:(id<CBORDecoderDelegate>)delegate limits:(CBORDecodeLimits)limits {
+    return [CBORDecoder decodeData:data delegate:delegate limits:limits];
+}
+
++ (nullable id)valueAtPath:(NSArray *)path inData:(NSData *)data {
+    return [CBORDecoder decodeObjectAtPath:path data:data limits:CBORDecodeLimitsDefault];
 }
 
 + (nullable id)decodeClass:(Class)aClass fromData:(NSData *)data {
+    // 模型直接从数据单次遍历构建，不经过中间字典；字符串引用命名空间由模型解码整体交给原生对象解码
+    if (![aClass isSubclassOfClass:[NSArray class]] && ![aClass isSubclassOfClass:[NSDictionary class]]) {
+        return [CBORModelDecoder decodeClass:aClass data:data];
+    }
+    
     id obj = [self decodeData:data];
     if (!obj) { return nil; }
     
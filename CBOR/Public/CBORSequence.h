@@ -0,0 +1,89 @@
+// refer: https://github.com/DanielHusx/CBOR
+//
+// MIT License
+//
+// Copyright (c) 2024 Daniel
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "CBORConstant.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// CBOR序列读取器（RFC 8742）
+///
+/// 序列由若干条首尾相接的CBOR记录组成，读取器每次解码一条记录，
+/// 文件以内存映射方式读取，内存占用与文件大小无关。
+/// 记录非法时跳过该记录：记录结构完整时跳至其末尾，否则从其下一个字节重新同步。
+@interface CBORSequenceReader : NSObject
+
+/// 读取数据
+- (instancetype)initWithData:(NSData *)data;
+/// 读取文件，文件无法打开时返回nil
+- (nullable instancetype)initWithContentsOfFile:(NSString *)path;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+/// 数据源
+@property (nonatomic, copy, readonly) NSData *data;
+/// 下一条记录的起始位置
+@property (nonatomic, assign, readonly) NSUInteger offset;
+/// 是否已读取完毕
+@property (nonatomic, assign, readonly, getter=isAtEnd) BOOL atEnd;
+
+/// 读取下一条记录
+/// - Parameters:
+///   - object: 解码结果
+///   - recordOffset: 该记录在数据中的起始位置
+/// - Returns: `CBORDecodeStatusOK`读取成功；`CBORDecodeStatusMalformed`记录非法，已跳过；
+///            `CBORDecodeStatusNeedMoreData`已无更多记录
+- (CBORDecodeStatus)readObject:(id _Nullable * _Nullable)object
+                        offset:(NSUInteger * _Nullable)recordOffset;
+
+/// 下一条合法记录，跳过非法记录，读取完毕返回nil
+- (nullable id)nextObject;
+
+@end
+
+
+/// CBOR序列写入器（RFC 8742），直接在末尾追加记录，无需重写已有数据
+@interface CBORSequenceWriter : NSObject
+
+/// 追加到数据
+- (instancetype)initWithMutableData:(NSMutableData *)data;
+/// 追加到文件，文件不存在时创建，无法打开时返回nil
+- (nullable instancetype)initWithFile:(NSString *)path;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+/// 编码并追加一条记录
+/// - Returns: 编码或写入失败时返回NO
+- (BOOL)appendObject:(id)object;
+/// 追加一条已编码的记录
+- (BOOL)appendEncodedData:(NSData *)data;
+/// 关闭文件，之后追加均失败
+- (void)close;
+
+@end
+
+NS_ASSUME_NONNULL_END
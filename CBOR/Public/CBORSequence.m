@@ -0,0 +1,153 @@
+// refer: https://github.com/DanielHusx/CBOR
+//
+// MIT License
+//
+// Copyright (c) 2024 Daniel
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import "CBORSequence.h"
+#import "CBORParser.h"
+#import "CBORDecoder.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+@implementation CBORSequenceReader
+
+- (instancetype)initWithData:(NSData *)data {
+    self = [super init];
+    if (self) {
+        _data = [data copy];
+    }
+    return self;
+}
+
+- (instancetype)initWithContentsOfFile:(NSString *)path {
+    // 内存映射，按需换页
+    NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedAlways error:nil];
+    if (!data) { return nil; }
+    
+    return [self initWithData:data];
+}
+
+- (BOOL)isAtEnd {
+    return _offset >= [_data length];
+}
+
+- (CBORDecodeStatus)readObject:(id _Nullable *)object offset:(NSUInteger *)recordOffset {
+    if (object) { *object = nil; }
+    if ([self isAtEnd]) { return CBORDecodeStatusNeedMoreData; }
+    
+    if (recordOffset) { *recordOffset = _offset; }
+    
+    NSUInteger offset = _offset;
+    CBORDecodeStatus status = [CBORDecoder decodeObject:object
+                                                   data:_data
+                                                 offset:&offset
+                                                 limits:CBORDecodeLimitsDefault];
+    _offset = offset;
+    return status;
+}
+
+- (id)nextObject {
+    id object = nil;
+    CBORDecodeStatus status;
+    do {
+        status = [self readObject:&object offset:NULL];
+    } while (status == CBORDecodeStatusMalformed);
+    
+    return object;
+}
+
+@end
+
+
+@implementation CBORSequenceWriter {
+    /// 追加的数据
+    NSMutableData *_data;
+    /// 文件描述符，-1表示未打开
+    int _fd;
+}
+
+- (instancetype)initWithMutableData:(NSMutableData *)data {
+    self = [super init];
+    if (self) {
+        _data = data;
+        _fd = -1;
+    }
+    return self;
+}
+
+- (instancetype)initWithFile:(NSString *)path {
+    int fd = open([path fileSystemRepresentation], O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) { return nil; }
+    
+    self = [super init];
+    if (self) {
+        _fd = fd;
+    } else {
+        close(fd);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [self close];
+}
+
+- (BOOL)appendObject:(id)object {
+    NSData *data = [CBORParser encodeObject:object];
+    if (![data length]) { return NO; }
+    
+    return [self appendEncodedData:data];
+}
+
+- (BOOL)appendEncodedData:(NSData *)data {
+    if (_data) {
+        [_data appendData:data];
+        return YES;
+    }
+    if (_fd < 0) { return NO; }
+    
+    // 追加模式下每次写入均位于文件末尾
+    const UInt8 *bytes = [data bytes];
+    NSUInteger remaining = [data length];
+    while (remaining) {
+        ssize_t written = write(_fd, bytes, remaining);
+        if (written < 0) {
+            if (errno == EINTR) { continue; }
+            return NO;
+        }
+        bytes += written;
+        remaining -= (NSUInteger)written;
+    }
+    return YES;
+}
+
+- (void)close {
+    _data = nil;
+    if (_fd >= 0) {
+        close(_fd);
+        _fd = -1;
+    }
+}
+
+@end
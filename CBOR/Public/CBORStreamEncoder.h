@@ -0,0 +1,91 @@
+// refer: https://github.com/DanielHusx/CBOR
+//
+// MIT License
+//
+// Copyright (c) 2024 Daniel
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "CBORConstant.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 输出端：返回本次接受的字节数；0表示暂不可写（背压），负数表示写入失败
+typedef NSInteger (^CBORStreamEncoderSink)(const UInt8 *bytes, NSUInteger length);
+
+/// 流式编码器
+///
+/// 编码结果经固定容量的缓冲区写入输出流、文件描述符或自定义输出端，不持有完整的编码数据；
+/// 配合不定长数组、键值对与分段字节数组/字符串，可以常量内存逐条编码延迟产生的记录。
+/// 缓冲区最多暂存容量加一个元素的数据：超出容量时先尝试输出，输出端仍不可写则返回`CBOREncodeStatusWouldBlock`。
+///
+/// - Attentions: 非线程安全；文件描述符与输出流由调用方打开与关闭
+@interface CBORStreamEncoder : NSObject
+
+/// 编码选项
+@property (nonatomic, assign) CBOREncodeOptions options;
+/// 缓冲区容量
+@property (nonatomic, assign, readonly) NSUInteger bufferCapacity;
+/// 缓冲区中尚未输出的字节数
+@property (nonatomic, assign, readonly) NSUInteger pendingLength;
+/// 已输出的字节数
+@property (nonatomic, assign, readonly) UInt64 bytesWritten;
+/// 当前未结束的不定长容器数量
+@property (nonatomic, assign, readonly) NSUInteger depth;
+
+- (instancetype)init NS_UNAVAILABLE;
+/// 写入输出流（需已打开；非阻塞流无可用空间时视为背压）
+- (instancetype)initWithOutputStream:(NSOutputStream *)stream;
+/// 写入文件描述符（非阻塞描述符`EAGAIN`时视为背压）
+- (instancetype)initWithFileDescriptor:(int)fileDescriptor;
+/// 写入自定义输出端，默认缓冲区容量64KB
+- (instancetype)initWithSink:(CBORStreamEncoderSink)sink;
+/// 写入自定义输出端
+/// - Parameters:
+///   - sink: 输出端
+///   - bufferCapacity: 缓冲区容量
+- (instancetype)initWithSink:(CBORStreamEncoderSink)sink bufferCapacity:(NSUInteger)bufferCapacity NS_DESIGNATED_INITIALIZER;
+
+/// 编码对象，分段字节数组/字符串中只接受同类型的`NSData`/`NSString`分段
+- (CBOREncodeStatus)encodeObject:(id)object;
+/// 按指定类型编码对象；参考`+[CBORParser encodeObject:major:minor:]`
+- (CBOREncodeStatus)encodeObject:(id)object major:(CBORMajorType)major minor:(CBORMinorType)minor;
+
+/// 开始不定长数组
+- (CBOREncodeStatus)beginArray;
+/// 开始不定长键值对
+- (CBOREncodeStatus)beginMap;
+/// 开始分段字节数组
+- (CBOREncodeStatus)beginByteString;
+/// 开始分段字符串
+- (CBOREncodeStatus)beginTextString;
+/// 结束最近开始的不定长容器；键值对不能结束于键与值之间
+- (CBOREncodeStatus)end;
+
+/// 尽可能输出缓冲区数据
+/// - Returns: 全部输出返回`CBOREncodeStatusOK`，仍有剩余返回`CBOREncodeStatusWouldBlock`
+- (CBOREncodeStatus)flush;
+/// 结束编码：所有容器需已结束，并输出缓冲区数据
+- (CBOREncodeStatus)finish;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,242 @@
+// refer: https://github.com/DanielHusx/CBOR
+//
+// MIT License
+//
+// Copyright (c) 2024 Daniel
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import "CBORStreamEncoder.h"
+#import "CBOREncoder.h"
+#import "CBORWriter.h"
+#import <unistd.h>
+
+/// 默认缓冲区容量
+#define CBORStreamEncoderDefaultCapacity (64 * 1024)
+
+/// 不定长容器帧
+typedef struct {
+    /// 主要类型
+    CBORMajorType major;
+    /// 已写入的子元素数量（键值对的键与值分别计数）
+    UInt64 count;
+} CBORStreamEncoderFrame;
+
+@implementation CBORStreamEncoder {
+    /// 输出端
+    CBORStreamEncoderSink _sink;
+    /// 待输出数据
+    CBORWriter _writer;
+    /// 缓冲区中已输出的位置
+    NSUInteger _sent;
+    /// 输出端写入失败
+    BOOL _failed;
+    
+    /// 不定长容器帧栈
+    CBORStreamEncoderFrame *_frames;
+    NSUInteger _frameCapacity;
+}
+
+- (instancetype)initWithOutputStream:(NSOutputStream *)stream {
+    return [self initWithSink:^NSInteger(const UInt8 *bytes, NSUInteger length) {
+        if ([stream streamStatus] == NSStreamStatusError) { return -1; }
+        if (![stream hasSpaceAvailable]) { return 0; }
+        
+        NSInteger written = [stream write:bytes maxLength:length];
+        return written < 0 ? -1 : written;
+    }];
+}
+
+- (instancetype)initWithFileDescriptor:(int)fileDescriptor {
+    return [self initWithSink:^NSInteger(const UInt8 *bytes, NSUInteger length) {
+        do {
+            ssize_t written = write(fileDescriptor, bytes, length);
+            if (written >= 0) { return written; }
+        } while (errno == EINTR);
+        
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+    }];
+}
+
+- (instancetype)initWithSink:(CBORStreamEncoderSink)sink {
+    return [self initWithSink:sink bufferCapacity:CBORStreamEncoderDefaultCapacity];
+}
+
+- (instancetype)initWithSink:(CBORStreamEncoderSink)sink bufferCapacity:(NSUInteger)bufferCapacity {
+    self = [super init];
+    if (self) {
+        _sink = [sink copy];
+        _bufferCapacity = MAX(bufferCapacity, CBORWriterMaxHeaderLength);
+        CBORWriterInit(&_writer, _bufferCapacity);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    CBORWriterDispose(&_writer);
+    free(_frames);
+}
+
+- (NSUInteger)pendingLength {
+    return _writer.length - _sent;
+}
+
+
+// MARK: - 元素
+- (CBOREncodeStatus)encodeObject:(id)object {
+    return [self encodeObject:object major:CBORUnknownMajorType minor:CBORUnknownMinorType];
+}
+
+- (CBOREncodeStatus)encodeObject:(id)object major:(CBORMajorType)major minor:(CBORMinorType)minor {
+    if (!object) { return CBOREncodeStatusInvalid; }
+    
+    // 分段字节数组/字符串的分段只能是同类型的定长数据
+    CBORStreamEncoderFrame *top = _depth ? &_frames[_depth - 1] : NULL;
+    if (top && top->major == CBORMajorTypeBytes && (!CBORMajorTypeIsUnknown(major) || ![object isKindOfClass:[NSData class]])) { return CBOREncodeStatusInvalid; }
+    if (top && top->major == CBORMajorTypeString && (!CBORMajorTypeIsUnknown(major) || ![object isKindOfClass:[NSString class]])) { return CBOREncodeStatusInvalid; }
+    
+    CBOREncodeStatus status = [self prepareWrite];
+    if (status != CBOREncodeStatusOK) { return status; }
+    
+    // 分段不能包裹在字符串引用命名空间中，也不能写为引用
+    BOOL chunk = top && (top->major == CBORMajorTypeBytes || top->major == CBORMajorTypeString);
+    CBOREncodeOptions options = chunk ? (_options & ~CBOREncodeOptionsStringReferences) : _options;
+    if (![CBOREncoder writeObject:object major:major minor:minor options:options toWriter:&_writer]) { return CBOREncodeStatusInvalid; }
+    if (top) { top->count++; }
+    
+    return [self didWrite];
+}
+
+
+// MARK: - 不定长容器
+- (CBOREncodeStatus)beginArray {
+    return [self beginIndefinite:CBORMajorTypeArray];
+}
+
+- (CBOREncodeStatus)beginMap {
+    return [self beginIndefinite:CBORMajorTypeMap];
+}
+
+- (CBOREncodeStatus)beginByteString {
+    return [self beginIndefinite:CBORMajorTypeBytes];
+}
+
+- (CBOREncodeStatus)beginTextString {
+    return [self beginIndefinite:CBORMajorTypeString];
+}
+
+- (CBOREncodeStatus)beginIndefinite:(CBORMajorType)major {
+    // 分段中不能嵌套
+    CBORStreamEncoderFrame *top = _depth ? &_frames[_depth - 1] : NULL;
+    if (top && (top->major == CBORMajorTypeBytes || top->major == CBORMajorTypeString)) { return CBOREncodeStatusInvalid; }
+    
+    CBOREncodeStatus status = [self prepareWrite];
+    if (status != CBOREncodeStatusOK) { return status; }
+    
+    if (_depth == _frameCapacity) {
+        NSUInteger capacity = _frameCapacity ? _frameCapacity * 2 : 8;
+        CBORStreamEncoderFrame *frames = realloc(_frames, capacity * sizeof(CBORStreamEncoderFrame));
+        if (!frames) { return CBOREncodeStatusError; }
+        
+        _frames = frames;
+        _frameCapacity = capacity;
+    }
+    _frames[_depth++] = (CBORStreamEncoderFrame){ major, 0 };
+    
+    CBORByte byte = major | CBORAdditionalTypeIndefinite;
+    CBORWriterAppendBytes(&_writer, &byte, sizeof(byte));
+    return [self didWrite];
+}
+
+- (CBOREncodeStatus)end {
+    if (!_depth) { return CBOREncodeStatusInvalid; }
+    // 键值对不能结束于键与值之间
+    if (_frames[_depth - 1].major == CBORMajorTypeMap && (_frames[_depth - 1].count & 1)) { return CBOREncodeStatusInvalid; }
+    
+    CBOREncodeStatus status = [self prepareWrite];
+    if (status != CBOREncodeStatusOK) { return status; }
+    
+    _depth--;
+    if (_depth) { _frames[_depth - 1].count++; }
+    
+    CBORByte byte = CBORMajorTypeAdditional | CBORAdditionalTypeBreak;
+    CBORWriterAppendBytes(&_writer, &byte, sizeof(byte));
+    return [self didWrite];
+}
+
+
+// MARK: - 输出
+- (CBOREncodeStatus)flush {
+    if (_failed || _writer.failed) { return CBOREncodeStatusError; }
+    
+    while (_sent < _writer.length) {
+        NSUInteger remaining = _writer.length - _sent;
+        NSInteger written = _sink(_writer.bytes + _sent, remaining);
+        if (written < 0) {
+            _failed = YES;
+            return CBOREncodeStatusError;
+        }
+        if (written == 0) { break; }
+        
+        written = MIN((NSUInteger)written, remaining);
+        _sent += written;
+        _bytesWritten += written;
+    }
+    
+    if (_sent == _writer.length) {
+        CBORWriterTruncate(&_writer, 0);
+        _sent = 0;
+        return CBOREncodeStatusOK;
+    }
+    
+    // 已输出部分超过一半时前移剩余数据，缓冲区不随输出持续增长
+    if (_sent > _writer.length / 2) {
+        memmove(_writer.bytes, _writer.bytes + _sent, _writer.length - _sent);
+        CBORWriterTruncate(&_writer, _writer.length - _sent);
+        _sent = 0;
+    }
+    return CBOREncodeStatusWouldBlock;
+}
+
+- (CBOREncodeStatus)finish {
+    if (_depth) { return CBOREncodeStatusInvalid; }
+    return [self flush];
+}
+
+
+// MARK: - Private
+/// 写入前：缓冲区已满时先尝试输出，仍无法输出则拒绝本次写入
+- (CBOREncodeStatus)prepareWrite {
+    if (_failed || _writer.failed) { return CBOREncodeStatusError; }
+    if (self.pendingLength < _bufferCapacity) { return CBOREncodeStatusOK; }
+    
+    CBOREncodeStatus status = [self flush];
+    if (status == CBOREncodeStatusError) { return status; }
+    return self.pendingLength < _bufferCapacity ? CBOREncodeStatusOK : CBOREncodeStatusWouldBlock;
+}
+
+/// 写入后：超出容量时尝试输出，暂不可写不影响本次写入结果
+- (CBOREncodeStatus)didWrite {
+    if (_writer.failed) { return CBOREncodeStatusError; }
+    if (self.pendingLength >= _bufferCapacity && [self flush] == CBOREncodeStatusError) { return CBOREncodeStatusError; }
+    return CBOREncodeStatusOK;
+}
+
+@end
@@ -0,0 +1,95 @@
+// refer: https://github.com/DanielHusx/CBOR
+//
+// MIT License
+//
+// Copyright (c) 2024 Daniel
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+#import "CBORConstant.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// 类型化数组元素类型
+typedef NS_ENUM(UInt8, CBORTypedArrayType) {
+    CBORTypedArrayTypeUInt8         = 0,
+    /// 钳位无符号8位整数（超出范围的值取边界值）
+    CBORTypedArrayTypeUInt8Clamped  = 1,
+    CBORTypedArrayTypeUInt16        = 2,
+    CBORTypedArrayTypeUInt32        = 3,
+    CBORTypedArrayTypeUInt64        = 4,
+    CBORTypedArrayTypeSInt8         = 5,
+    CBORTypedArrayTypeSInt16        = 6,
+    CBORTypedArrayTypeSInt32        = 7,
+    CBORTypedArrayTypeSInt64        = 8,
+    /// 半精度
+    CBORTypedArrayTypeFloat16       = 9,
+    CBORTypedArrayTypeFloat32       = 10,
+    CBORTypedArrayTypeFloat64       = 11,
+};
+
+/// 类型化数组（RFC 8746）
+///
+/// 元素以本机字节序连续存放，解码时与本机字节序一致的数据直接引用数据源，
+/// 否则批量转换字节序（NEON/SSSE3向量指令）。编码时使用本机字节序对应的标记。
+@interface CBORTypedArray : NSObject <NSCopying>
+
+/// 本机字节序的元素数据
+/// - Returns: 数据长度不是元素长度的整数倍时返回nil
++ (nullable instancetype)typedArrayWithData:(NSData *)data type:(CBORTypedArrayType)type;
+/// 数值数组转换为指定类型
++ (nullable instancetype)typedArrayWithNumbers:(NSArray<NSNumber *> *)numbers type:(CBORTypedArrayType)type;
+/// 数值数组按元素类型自动转换
+/// - Returns: 数组为空、含布尔值或元素类型不一致时返回nil
++ (nullable instancetype)typedArrayWithNumbers:(NSArray<NSNumber *> *)numbers;
+/// 解析扩展类型内容
+/// - Parameters:
+///   - tag: 类型化数组标记（64~87）
+///   - data: 字节数组内容，按标记的字节序排列
+/// - Returns: 不支持的标记（保留值与128位浮点数）或长度非法时返回nil
++ (nullable instancetype)typedArrayWithTag:(CBORTagType)tag data:(NSData *)data;
+/// 是否是类型化数组标记
++ (BOOL)isTypedArrayTag:(CBORTagType)tag;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+/// 元素类型
+@property (nonatomic, assign, readonly) CBORTypedArrayType type;
+/// 本机字节序的元素数据
+@property (nonatomic, copy, readonly) NSData *data;
+/// 元素数量
+@property (nonatomic, assign, readonly) NSUInteger count;
+/// 元素字节长度
+@property (nonatomic, assign, readonly) NSUInteger elementSize;
+/// 编码使用的标记（本机字节序）
+@property (nonatomic, assign, readonly) CBORTagType tag;
+
+/// 指定位置的元素：整数与`-[CBORObject nsObject]`一致按64位返回，浮点数按双精度返回
+- (NSNumber *)numberAtIndex:(NSUInteger)index;
+/// 全部元素
+- (NSArray<NSNumber *> *)numbers;
+/// 单精度数据：半精度元素批量转换，单精度元素直接返回，其他类型返回nil
+- (nullable NSData *)float32Data;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,480 @@
+// refer: https://github.com/DanielHusx/CBOR
+//
+// MIT License
+//
+// Copyright (c) 2024 Daniel
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import "CBORTypedArray.h"
+#import "CBORDecodeHeader.h"
+#import "CBOREncodable.h"
+#import "CBORNumber.h"
+#import "CBORArray.h"
+#import "CBORTag.h"
+#if defined(__x86_64__)
+#import <immintrin.h>
+#import <sys/sysctl.h>
+#elif defined(__arm64__) || defined(__aarch64__)
+#import <arm_neon.h>
+#endif
+
+/// 元素值
+typedef union {
+    UInt8 u8;
+    SInt8 s8;
+    UInt16 u16;
+    SInt16 s16;
+    UInt32 u32;
+    SInt32 s32;
+    UInt64 u64;
+    SInt64 s64;
+    Float32 f32;
+    Float64 f64;
+} CBORTypedArrayValue;
+
+static inline BOOL CBORTypedArrayHostIsLittleEndian(void) {
+    return CFByteOrderGetCurrent() == CFByteOrderLittleEndian;
+}
+
+static inline NSUInteger CBORTypedArrayElementSize(CBORTypedArrayType type) {
+    switch (type) {
+        case CBORTypedArrayTypeUInt8:
+        case CBORTypedArrayTypeUInt8Clamped:
+        case CBORTypedArrayTypeSInt8:
+            return 1;
+        case CBORTypedArrayTypeUInt16:
+        case CBORTypedArrayTypeSInt16:
+        case CBORTypedArrayTypeFloat16:
+            return 2;
+        case CBORTypedArrayTypeUInt32:
+        case CBORTypedArrayTypeSInt32:
+        case CBORTypedArrayTypeFloat32:
+            return 4;
+        case CBORTypedArrayTypeUInt64:
+        case CBORTypedArrayTypeSInt64:
+        case CBORTypedArrayTypeFloat64:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+/// 元素类型与字节序对应的标记
+static CBORTagType CBORTypedArrayTagWithType(CBORTypedArrayType type, BOOL littleEndian) {
+    CBORTagType tag = 0;
+    switch (type) {
+        case CBORTypedArrayTypeUInt8: return CBORTagTypeTypedArrayUInt8;
+        case CBORTypedArrayTypeUInt8Clamped: return CBORTagTypeTypedArrayUInt8Clamped;
+        case CBORTypedArrayTypeSInt8: return CBORTagTypeTypedArraySInt8;
+        case CBORTypedArrayTypeUInt16: tag = CBORTagTypeTypedArrayUInt16BE; break;
+        case CBORTypedArrayTypeUInt32: tag = CBORTagTypeTypedArrayUInt32BE; break;
+        case CBORTypedArrayTypeUInt64: tag = CBORTagTypeTypedArrayUInt64BE; break;
+        case CBORTypedArrayTypeSInt16: tag = CBORTagTypeTypedArraySInt16BE; break;
+        case CBORTypedArrayTypeSInt32: tag = CBORTagTypeTypedArraySInt32BE; break;
+        case CBORTypedArrayTypeSInt64: tag = CBORTagTypeTypedArraySInt64BE; break;
+        case CBORTypedArrayTypeFloat16: tag = CBORTagTypeTypedArrayFloat16BE; break;
+        case CBORTypedArrayTypeFloat32: tag = CBORTagTypeTypedArrayFloat32BE; break;
+        case CBORTypedArrayTypeFloat64: tag = CBORTagTypeTypedArrayFloat64BE; break;
+    }
+    // 小端标记为大端标记加4
+    return littleEndian ? tag + 4 : tag;
+}
+
+/// 解析标记：`0b010_f_s_e_ll`（浮点、有符号、小端、长度）
+static BOOL CBORTypedArrayTypeWithTag(CBORTagType tag, CBORTypedArrayType *type, BOOL *littleEndian) {
+    if (tag < CBORTagTypeTypedArrayUInt8 || tag > CBORTagTypeTypedArrayFloat128LE) { return NO; }
+    
+    static const CBORTypedArrayType unsignedTypes[] = { CBORTypedArrayTypeUInt8, CBORTypedArrayTypeUInt16, CBORTypedArrayTypeUInt32, CBORTypedArrayTypeUInt64 };
+    static const CBORTypedArrayType signedTypes[] = { CBORTypedArrayTypeSInt8, CBORTypedArrayTypeSInt16, CBORTypedArrayTypeSInt32, CBORTypedArrayTypeSInt64 };
+    static const CBORTypedArrayType floatTypes[] = { CBORTypedArrayTypeFloat16, CBORTypedArrayTypeFloat32, CBORTypedArrayTypeFloat64 };
+    
+    UInt8 bits = (UInt8)(tag - CBORTagTypeTypedArrayUInt8);
+    BOOL isFloat = (bits & 0x10) != 0;
+    BOOL isSigned = (bits & 0x08) != 0;
+    BOOL little = (bits & 0x04) != 0;
+    UInt8 length = bits & 0x03;
+    
+    CBORTypedArrayType value;
+    if (isFloat) {
+        // 不支持128位浮点数
+        if (length == 3) { return NO; }
+        value = floatTypes[length];
+    } else if (!length) {
+        // 8位整数无字节序之分，该位表示钳位；有符号时为保留值
+        if (isSigned && little) { return NO; }
+        value = isSigned ? CBORTypedArrayTypeSInt8 : (little ? CBORTypedArrayTypeUInt8Clamped : CBORTypedArrayTypeUInt8);
+    } else {
+        value = isSigned ? signedTypes[length] : unsignedTypes[length];
+    }
+    
+    if (type) { *type = value; }
+    if (littleEndian) { *littleEndian = little; }
+    return YES;
+}
+
+
+// MARK: - 字节序转换
+typedef void (*CBORTypedArraySwapKernel)(UInt8 *dst, const UInt8 *src, NSUInteger length, NSUInteger elementSize);
+
+static void CBORTypedArraySwapScalar(UInt8 *dst, const UInt8 *src, NSUInteger length, NSUInteger elementSize) {
+    for (NSUInteger index = 0; index + elementSize <= length; index += elementSize) {
+        CBORTypedArrayValue value;
+        memcpy(&value, src + index, elementSize);
+        switch (elementSize) {
+            case 2: value.u16 = CFSwapInt16(value.u16); break;
+            case 4: value.u32 = CFSwapInt32(value.u32); break;
+            case 8: value.u64 = CFSwapInt64(value.u64); break;
+            default: break;
+        }
+        memcpy(dst + index, &value, elementSize);
+    }
+}
+
+#if defined(__x86_64__)
+/// SSSE3：每次转换16字节
+__attribute__((target("ssse3")))
+static void CBORTypedArraySwapSSSE3(UInt8 *dst, const UInt8 *src, NSUInteger length, NSUInteger elementSize) {
+    __m128i mask;
+    switch (elementSize) {
+        case 2: mask = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14); break;
+        case 4: mask = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12); break;
+        default: mask = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8); break;
+    }
+    
+    NSUInteger index = 0;
+    for (; index + 16 <= length; index += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *)(src + index));
+        _mm_storeu_si128((__m128i *)(dst + index), _mm_shuffle_epi8(block, mask));
+    }
+    CBORTypedArraySwapScalar(dst + index, src + index, length - index, elementSize);
+}
+#elif defined(__arm64__) || defined(__aarch64__)
+/// NEON：每次转换16字节
+static void CBORTypedArraySwapNEON(UInt8 *dst, const UInt8 *src, NSUInteger length, NSUInteger elementSize) {
+    NSUInteger index = 0;
+    switch (elementSize) {
+        case 2:
+            for (; index + 16 <= length; index += 16) { vst1q_u8(dst + index, vrev16q_u8(vld1q_u8(src + index))); }
+            break;
+        case 4:
+            for (; index + 16 <= length; index += 16) { vst1q_u8(dst + index, vrev32q_u8(vld1q_u8(src + index))); }
+            break;
+        default:
+            for (; index + 16 <= length; index += 16) { vst1q_u8(dst + index, vrev64q_u8(vld1q_u8(src + index))); }
+            break;
+    }
+    CBORTypedArraySwapScalar(dst + index, src + index, length - index, elementSize);
+}
+#endif
+
+/// 按处理器能力选择内核，仅选择一次
+static CBORTypedArraySwapKernel CBORTypedArraySwapKernelSelect(void) {
+    static CBORTypedArraySwapKernel kernel = CBORTypedArraySwapScalar;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+#if defined(__x86_64__)
+        int ssse3 = 0;
+        size_t size = sizeof(ssse3);
+        if (!sysctlbyname("hw.optional.supplementalsse3", &ssse3, &size, NULL, 0) && ssse3) {
+            kernel = CBORTypedArraySwapSSSE3;
+        }
+#elif defined(__arm64__) || defined(__aarch64__)
+        kernel = CBORTypedArraySwapNEON;
+#endif
+    });
+    return kernel;
+}
+
+/// 半精度批量转单精度
+static void CBORTypedArrayWidenHalf(Float32 *dst, const UInt8 *src, NSUInteger count) {
+    NSUInteger index = 0;
+#if defined(__arm64__) || defined(__aarch64__)
+    for (; index + 4 <= count; index += 4) {
+        uint16x4_t halves = vreinterpret_u16_u8(vld1_u8(src + index * 2));
+        vst1q_f32(dst + index, vcvt_f32_f16(vreinterpret_f16_u16(halves)));
+    }
+#endif
+    for (; index < count; index++) {
+        UInt16 half;
+        memcpy(&half, src + index * 2, sizeof(half));
+        dst[index] = uint16_to_float(half);
+    }
+}
+
+
+@interface CBORTypedArray () <CBOREncodable>
+
+@end
+
+@implementation CBORTypedArray
+
+- (instancetype)initWithType:(CBORTypedArrayType)type data:(NSData *)data {
+    self = [super init];
+    if (self) {
+        _type = type;
+        _data = [data copy];
+        _elementSize = CBORTypedArrayElementSize(type);
+        _count = [_data length] / _elementSize;
+    }
+    return self;
+}
+
++ (instancetype)typedArrayWithData:(NSData *)data type:(CBORTypedArrayType)type {
+    NSUInteger elementSize = CBORTypedArrayElementSize(type);
+    if (!elementSize || [data length] % elementSize) { return nil; }
+    
+    return [[self alloc] initWithType:type data:data];
+}
+
++ (instancetype)typedArrayWithNumbers:(NSArray<NSNumber *> *)numbers type:(CBORTypedArrayType)type {
+    NSUInteger elementSize = CBORTypedArrayElementSize(type);
+    if (!elementSize) { return nil; }
+    
+    NSMutableData *data = [NSMutableData dataWithLength:[numbers count] * elementSize];
+    UInt8 *bytes = [data mutableBytes];
+    NSUInteger index = 0;
+    for (NSNumber *number in numbers) {
+        if (![number isKindOfClass:[NSNumber class]]) { return nil; }
+        
+        CBORTypedArrayValue value;
+        switch (type) {
+            case CBORTypedArrayTypeUInt8: value.u8 = (UInt8)[number unsignedLongLongValue]; break;
+            case CBORTypedArrayTypeUInt8Clamped: {
+                // 钳位后就近取整
+                double v = [number doubleValue];
+                value.u8 = isnan(v) || v <= 0 ? 0 : (v >= 255 ? 255 : (UInt8)lrint(v));
+            } break;
+            case CBORTypedArrayTypeUInt16: value.u16 = (UInt16)[number unsignedLongLongValue]; break;
+            case CBORTypedArrayTypeUInt32: value.u32 = (UInt32)[number unsignedLongLongValue]; break;
+            case CBORTypedArrayTypeUInt64: value.u64 = [number unsignedLongLongValue]; break;
+            case CBORTypedArrayTypeSInt8: value.s8 = (SInt8)[number longLongValue]; break;
+            case CBORTypedArrayTypeSInt16: value.s16 = (SInt16)[number longLongValue]; break;
+            case CBORTypedArrayTypeSInt32: value.s32 = (SInt32)[number longLongValue]; break;
+            case CBORTypedArrayTypeSInt64: value.s64 = [number longLongValue]; break;
+            case CBORTypedArrayTypeFloat16: value.u16 = float_to_uint16([number floatValue]); break;
+            case CBORTypedArrayTypeFloat32: value.f32 = [number floatValue]; break;
+            case CBORTypedArrayTypeFloat64: value.f64 = [number doubleValue]; break;
+        }
+        memcpy(bytes + index * elementSize, &value, elementSize);
+        index++;
+    }
+    
+    return [[self alloc] initWithType:type data:data];
+}
+
++ (instancetype)typedArrayWithNumbers:(NSArray<NSNumber *> *)numbers {
+    if (![numbers count]) { return nil; }
+    
+    // 元素的存储类型必须完全一致
+    const char *objCType = NULL;
+    for (NSNumber *number in numbers) {
+        if (![number isKindOfClass:[NSNumber class]]) { return nil; }
+        if (CFGetTypeID((__bridge CFTypeRef)number) == CFBooleanGetTypeID()) { return nil; }
+        
+        const char *current = [number objCType];
+        if (!objCType) {
+            objCType = current;
+        } else if (strcmp(objCType, current) != 0) {
+            return nil;
+        }
+    }
+    
+    CBORTypedArrayType type;
+    switch (objCType[0]) {
+        case 'c': type = CBORTypedArrayTypeSInt8; break;
+        case 'C': type = CBORTypedArrayTypeUInt8; break;
+        case 's': type = CBORTypedArrayTypeSInt16; break;
+        case 'S': type = CBORTypedArrayTypeUInt16; break;
+        case 'i': type = CBORTypedArrayTypeSInt32; break;
+        case 'I': type = CBORTypedArrayTypeUInt32; break;
+        case 'l':
+        case 'q': type = CBORTypedArrayTypeSInt64; break;
+        case 'L':
+        case 'Q': type = CBORTypedArrayTypeUInt64; break;
+        case 'f': type = CBORTypedArrayTypeFloat32; break;
+        case 'd': type = CBORTypedArrayTypeFloat64; break;
+        default: return nil;
+    }
+    
+    return [self typedArrayWithNumbers:numbers type:type];
+}
+
++ (instancetype)typedArrayWithTag:(CBORTagType)tag data:(NSData *)data {
+    CBORTypedArrayType type;
+    BOOL littleEndian;
+    if (!CBORTypedArrayTypeWithTag(tag, &type, &littleEndian)) { return nil; }
+    
+    NSUInteger elementSize = CBORTypedArrayElementSize(type);
+    NSUInteger length = [data length];
+    if (length % elementSize) { return nil; }
+    
+    // 字节序与本机一致时直接引用数据
+    if (elementSize == 1 || littleEndian == CBORTypedArrayHostIsLittleEndian()) {
+        return [[self alloc] initWithType:type data:data];
+    }
+    
+    NSMutableData *swapped = [NSMutableData dataWithLength:length];
+    if (!swapped) { return nil; }
+    CBORTypedArraySwapKernelSelect()([swapped mutableBytes], [data bytes], length, elementSize);
+    
+    return [[self alloc] initWithType:type data:swapped];
+}
+
++ (BOOL)isTypedArrayTag:(CBORTagType)tag {
+    return CBORTypedArrayTypeWithTag(tag, NULL, NULL);
+}
+
+- (CBORTagType)tag {
+    return CBORTypedArrayTagWithType(_type, CBORTypedArrayHostIsLittleEndian());
+}
+
+- (NSNumber *)numberAtIndex:(NSUInteger)index {
+    if (index >= _count) {
+        [NSException raise:NSRangeException format:@"index %lu beyond bounds [0 .. %lu]", (unsigned long)index, (unsigned long)_count];
+    }
+    
+    CBORTypedArrayValue value;
+    memcpy(&value, (const UInt8 *)[_data bytes] + index * _elementSize, _elementSize);
+    
+    SInt64 signedValue = 0;
+    switch (_type) {
+        case CBORTypedArrayTypeUInt8:
+        case CBORTypedArrayTypeUInt8Clamped: return CBORDecodeUnsignedNumber(value.u8);
+        case CBORTypedArrayTypeUInt16: return CBORDecodeUnsignedNumber(value.u16);
+        case CBORTypedArrayTypeUInt32: return CBORDecodeUnsignedNumber(value.u32);
+        case CBORTypedArrayTypeUInt64: return CBORDecodeUnsignedNumber(value.u64);
+        case CBORTypedArrayTypeSInt8: signedValue = value.s8; break;
+        case CBORTypedArrayTypeSInt16: signedValue = value.s16; break;
+        case CBORTypedArrayTypeSInt32: signedValue = value.s32; break;
+        case CBORTypedArrayTypeSInt64: signedValue = value.s64; break;
+        case CBORTypedArrayTypeFloat16: return @((Float64)uint16_to_float(value.u16));
+        case CBORTypedArrayTypeFloat32: return @((Float64)value.f32);
+        case CBORTypedArrayTypeFloat64: return @(value.f64);
+    }
+    
+    // 与整数解码一致：非负数按无符号返回
+    if (signedValue >= 0) { return CBORDecodeUnsignedNumber((UInt64)signedValue); }
+    return CBORDecodeNegativeNumber((UInt64)(-(signedValue + 1)));
+}
+
+- (NSArray<NSNumber *> *)numbers {
+    NSMutableArray *ret = [NSMutableArray arrayWithCapacity:_count];
+    if (_type == CBORTypedArrayTypeFloat16) {
+        // 先批量转为单精度
+        NSData *widened = [self float32Data];
+        const Float32 *values = [widened bytes];
+        for (NSUInteger index = 0; index < _count; index++) {
+            [ret addObject:@((Float64)values[index])];
+        }
+        return ret;
+    }
+    
+    for (NSUInteger index = 0; index < _count; index++) {
+        [ret addObject:[self numberAtIndex:index]];
+    }
+    return ret;
+}
+
+- (NSData *)float32Data {
+    switch (_type) {
+        case CBORTypedArrayTypeFloat32:
+            return _data;
+        case CBORTypedArrayTypeFloat16: {
+            NSMutableData *ret = [NSMutableData dataWithLength:_count * sizeof(Float32)];
+            CBORTypedArrayWidenHalf([ret mutableBytes], [_data bytes], _count);
+            return ret;
+        }
+        default:
+            return nil;
+    }
+}
+
+/// 指定字节序的元素数据
+- (NSData *)dataWithLittleEndian:(BOOL)littleEndian {
+    if (_elementSize == 1 || littleEndian == CBORTypedArrayHostIsLittleEndian()) { return _data; }
+    
+    NSUInteger length = [_data length];
+    NSMutableData *ret = [NSMutableData dataWithLength:length];
+    CBORTypedArraySwapKernelSelect()([ret mutableBytes], [_data bytes], length, _elementSize);
+    return ret;
+}
+
+
+// MARK: - CBOREncodable
+- (nullable CBORObject *)cborObject {
+    CBORArray *value = [[CBORArray alloc] initWithMajor:CBORMajorTypeBytes value:_data];
+    return [[CBORTag alloc] initWithMajor:CBORMajorTypeTag
+                                      tag:self.tag
+                                    value:value];
+}
+
+- (nullable CBORObject *)cborObjectWithMajor:(CBORMajorType)major
+                                       minor:(CBORUInt64)minor {
+    if (CBORMajorTypeIsUnknown(major)) { return [self cborObject]; }
+    
+    CBORMajorType majorType = CBORTypeMajor(major);
+    switch (majorType) {
+        case CBORMajorTypeBytes:
+            // 仅元素数据（本机字节序）
+            return [[CBORArray alloc] initWithMajor:majorType
+                                              minor:(CBORByte)minor
+                                              value:_data];
+        case CBORMajorTypeTag: {
+            // 指定字节序的标记，元素类型必须一致
+            CBORTypedArrayType type;
+            BOOL littleEndian;
+            if (!CBORTypedArrayTypeWithTag(minor, &type, &littleEndian) || type != _type) { return nil; }
+            
+            CBORArray *value = [[CBORArray alloc] initWithMajor:CBORMajorTypeBytes
+                                                          minor:(CBORByte)CBORTypeMinor(major)
+                                                          value:[self dataWithLittleEndian:littleEndian]];
+            return [[CBORTag alloc] initWithMajor:majorType
+                                              tag:minor
+                                            value:value];
+        }
+        default:
+            return nil;
+    }
+}
+
+
+// MARK: - NSObject
+- (id)copyWithZone:(NSZone *)zone {
+    return self;
+}
+
+- (BOOL)isEqual:(id)object {
+    if (self == object) { return YES; }
+    if (![object isKindOfClass:[CBORTypedArray class]]) { return NO; }
+    
+    CBORTypedArray *other = object;
+    return other.type == _type && [other.data isEqualToData:_data];
+}
+
+- (NSUInteger)hash {
+    return [_data hash] ^ _type;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"[CBORTypedArray] type: %d, count: %lu; numbers: %@", _type, (unsigned long)_count, [self numbers]];
+}
+
+@end
@@ -9,7 +9,7 @@
 @implementation CBORUndefined
 
 - (CBORObject *)cborObject {
-    return [[CBORSimple alloc] initWithMajor:CBORMajorTypeAdditional minor:CBORAdditionalTypeUndefined];
+    return [CBORSimple cborUndefined];
 }
 
 - (CBORObject *)cborObjectWithMajor:(CBORMajorType)major minor:(CBORUInt64)minor {
@@ -1,5 +1,10 @@
 #import <XCTest/XCTest.h>
 #import "CBOR.h"
+#import "CBORDecoder.h"
+#import "CBORArray.h"
+#import "CBORMap.h"
+#import "CBORNumber.h"
+#import "CBORSimple.h"
 //#import "CBORConstant.h"
 //#import "CBORModel.h"
 //#import "CBORParser.h"
@@ -12,6 +17,164 @@
 }()
 
 
+/// 事件记录
+@interface CBORTestEventRecorder : NSObject <CBORDecoderDelegate>
+@property (nonatomic, strong) NSMutableArray<NSString *> *events;
+/// 遇到该扩展标记时跳过其内容
+@property (nonatomic, assign) CBORTagType skipTag;
+/// 遇到该字符串时停止
+@property (nonatomic, copy) NSString *stopString;
+@end
+
+@implementation CBORTestEventRecorder
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _events = [NSMutableArray array];
+        _skipTag = CBORUnknownMinorType;
+    }
+    return self;
+}
+- (CBORDecodeAction)decoderDidBeginArray:(UInt64)count {
+    [_events addObject:count == CBORIndefiniteCount ? @"[_" : [NSString stringWithFormat:@"[%llu", count]];
+    return CBORDecodeActionContinue;
+}
+- (CBORDecodeAction)decoderDidEndArray { [_events addObject:@"]"]; return CBORDecodeActionContinue; }
+- (CBORDecodeAction)decoderDidBeginMap:(UInt64)count {
+    [_events addObject:count == CBORIndefiniteCount ? @"{_" : [NSString stringWithFormat:@"{%llu", count]];
+    return CBORDecodeActionContinue;
+}
+- (CBORDecodeAction)decoderDidEndMap { [_events addObject:@"}"]; return CBORDecodeActionContinue; }
+- (CBORDecodeAction)decoderDidReadUnsigned:(UInt64)value {
+    [_events addObject:[NSString stringWithFormat:@"%llu", value]];
+    return CBORDecodeActionContinue;
+}
+- (CBORDecodeAction)decoderDidReadNegative:(UInt64)value {
+    [_events addObject:[NSString stringWithFormat:@"-%llu", value + 1]];
+    return CBORDecodeActionContinue;
+}
+- (CBORDecodeAction)decoderDidReadFloat:(Float64)value {
+    [_events addObject:[NSString stringWithFormat:@"%g", value]];
+    return CBORDecodeActionContinue;
+}
+- (CBORDecodeAction)decoderDidReadSimple:(UInt8)value {
+    [_events addObject:[NSString stringWithFormat:@"simple(%u)", value]];
+    return CBORDecodeActionContinue;
+}
+- (CBORDecodeAction)decoderDidReadTag:(CBORTagType)tag {
+    [_events addObject:[NSString stringWithFormat:@"tag(%llu)", tag]];
+    return tag == _skipTag ? CBORDecodeActionSkip : CBORDecodeActionContinue;
+}
+- (CBORDecodeAction)decoderDidReadBytes:(const UInt8 *)bytes length:(NSUInteger)length {
+    [_events addObject:[NSString stringWithFormat:@"h%lu", (unsigned long)length]];
+    return CBORDecodeActionContinue;
+}
+- (CBORDecodeAction)decoderDidReadString:(const UInt8 *)bytes length:(NSUInteger)length {
+    NSString *string = [[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding];
+    [_events addObject:string];
+    return [string isEqualToString:_stopString] ? CBORDecodeActionStop : CBORDecodeActionContinue;
+}
+- (CBORDecodeAction)decoderDidBeginChunkedString { [_events addObject:@"(_"]; return CBORDecodeActionContinue; }
+- (CBORDecodeAction)decoderDidEndChunkedString { [_events addObject:@")"]; return CBORDecodeActionContinue; }
+@end
+
+
+/// 单次遍历解码的嵌套模型
+@interface CBORTestModelItem : NSObject
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, assign) NSInteger count;
+@end
+
+@implementation CBORTestModelItem
+@end
+
+@interface CBORTestModel : NSObject
+@property (nonatomic, copy) NSString *identifier;
+@property (nonatomic, copy) NSString *city;
+@property (nonatomic, assign) double score;
+@property (nonatomic, strong) CBORTestModelItem *item;
+@property (nonatomic, copy) NSArray<CBORTestModelItem *> *items;
+@property (nonatomic, copy) NSDictionary<NSString *, CBORTestModelItem *> *named;
+@end
+
+@implementation CBORTestModel
++ (NSDictionary *)modelCustomPropertyMapper {
+    return @{ @"identifier": @[@"id", @"ID"], @"city": @"address.city" };
+}
++ (NSDictionary *)modelContainerPropertyGenericClass {
+    return @{ @"items": [CBORTestModelItem class], @"named": [CBORTestModelItem class] };
+}
+@end
+
+/// 编码计划：标量属性与共享上级的键路径
+@interface CBORTestScalarModel : NSObject
+@property (nonatomic, assign) BOOL flag;
+@property (nonatomic, assign) int16_t small;
+@property (nonatomic, assign) UInt32 medium;
+@property (nonatomic, assign) UInt64 large;
+@property (nonatomic, assign) float ratio;
+@property (nonatomic, assign) double invalid;
+@property (nonatomic, copy) NSString *city;
+@property (nonatomic, copy) NSString *street;
+@end
+
+@implementation CBORTestScalarModel
++ (NSDictionary *)modelCustomPropertyMapper {
+    return @{ @"city": @"address.city", @"street": @"address.street" };
+}
++ (NSArray *)modelCustomPropertySequeue {
+    return @[@"flag", @"small", @"medium", @"large", @"ratio", @"invalid", @"city", @"street"];
+}
+@end
+
+
+/// 整数键：COSE风格的单字节键，`ext`的整数键超出单字节查表范围
+@interface CBORTestIntegerKeyModel : NSObject
+@property (nonatomic, assign) NSInteger alg;
+@property (nonatomic, copy) NSString *kid;
+@property (nonatomic, copy) NSString *ext;
+@property (nonatomic, copy) NSString *label;
+@end
+
+@implementation CBORTestIntegerKeyModel
++ (NSDictionary *)modelCustomPropertyIntegerKeys {
+    return @{ @"alg": @1, @"kid": @4, @"ext": @100 };
+}
++ (NSDictionary *)modelCustomPropertyMapper {
+    return @{ @"ext": @"meta.ext" };
+}
++ (NSArray *)modelCustomPropertySequeue {
+    return @[@"alg", @"kid", @"ext", @"label"];
+}
+@end
+
+/// 整数键模型经由字典转换
+@interface CBORTestIntegerKeyTransformModel : CBORTestIntegerKeyModel
+@end
+
+@implementation CBORTestIntegerKeyTransformModel
+- (NSDictionary *)modelCustomWillTransformFromDictionary:(NSDictionary *)dic {
+    return dic;
+}
+@end
+
+
+/// 多个属性映射到同一个键
+@interface CBORTestDuplicateKeyModel : NSObject
+@property (nonatomic, copy) NSString *first;
+@property (nonatomic, copy) NSString *second;
+@end
+
+@implementation CBORTestDuplicateKeyModel
++ (NSDictionary *)modelCustomPropertyMapper {
+    return @{ @"first": @"value", @"second": @"value" };
+}
++ (NSArray *)modelCustomPropertySequeue {
+    return @[@"first", @"second"];
+}
+@end
+
+
 @interface CBORTests : XCTestCase
 
 @end
@@ -422,4 +585,1039 @@ static inline UInt64 ConvertDataToBignumN(NSData *data) {
                 data:CBORData(0xd8, 0x21, 0x74, 0x53, 0x47, 0x56, 0x73, 0x62, 0x47, 0x38, 0x73, 0x49, 0x46, 0x64, 0x76, 0x63, 0x6D, 0x78, 0x6B, 0x49, 0x51, 0x3D, 0x3D)];
 }
 
+/// 测试截断数据
+- (void)testTruncated {
+    // 长度前缀不完整
+    XCTAssertNil([CBORParser decodeData:CBORData(0x19, 0x03)]);
+    XCTAssertNil([CBORParser decodeData:CBORData(0x1b, 0x00, 0x00, 0x00, 0xe8)]);
+    XCTAssertNil([CBORParser decodeData:CBORData(0xfa, 0x47, 0xc3)]);
+    // 内容不完整
+    XCTAssertNil([CBORParser decodeData:CBORData(0x43, 0xc0, 0xff)]);
+    XCTAssertNil([CBORParser decodeData:CBORData(0x79, 0x00, 3, 0x41, 0x42)]);
+    XCTAssertNil([CBORParser decodeData:CBORData(0x82, 0x01)]);
+    
+    // 字节数组为共享输入数据的视图，不复制
+    NSData *source = CBORData(0x82, 0x43, 0x01, 0x02, 0x03, 0x01);
+    NSData *view = [CBORParser decodeData:source][0];
+    XCTAssertEqualObjects(view, CBORData(0x01, 0x02, 0x03));
+    XCTAssertEqual((const UInt8 *)[view bytes], (const UInt8 *)[source bytes] + 2);
+}
+
+
+/// 测试增量解码
+- (void)testIncrementalDecoder {
+    NSMutableArray *objects = [NSMutableArray array];
+    CBORIncrementalDecoder *decoder = [[CBORIncrementalDecoder alloc] initWithItemHandler:^(id object) {
+        [objects addObject:object];
+    }];
+    
+    // 1, [1, 2], "abc", {_ "a": 1}, h'0102' 逐字节输入
+    NSData *data = CBORData(0x01,
+                            0x82, 0x01, 0x02,
+                            0x63, 0x61, 0x62, 0x63,
+                            0xbf, 0x61, 0x61, 0x01, 0xff,
+                            0x42, 0x01, 0x02);
+    const UInt8 *bytes = [data bytes];
+    for (NSUInteger index = 0; index < [data length]; index++) {
+        CBORDecodeStatus status = [decoder feed:[NSData dataWithBytes:bytes + index length:1]];
+        XCTAssertNotEqual(status, CBORDecodeStatusMalformed);
+    }
+    XCTAssertEqual([decoder status], CBORDecodeStatusOK);
+    XCTAssertEqual([decoder decodedCount], 5);
+    NSArray *expected = @[@1, @[@1, @2], @"abc", @{@"a": @1}, CBORData(0x01, 0x02)];
+    XCTAssertEqualObjects(objects, expected);
+    
+    // 长度前缀跨输入
+    [objects removeAllObjects];
+    XCTAssertEqual([decoder feed:CBORData(0x19, 0x03)], CBORDecodeStatusNeedMoreData);
+    XCTAssertEqual([decoder feed:CBORData(0xe8)], CBORDecodeStatusOK);
+    XCTAssertEqualObjects(objects, @[@1000]);
+    
+    // 格式错误后保持状态直至重置
+    XCTAssertEqual([decoder feed:CBORData(0x1c)], CBORDecodeStatusMalformed);
+    XCTAssertEqual([decoder feed:CBORData(0x01)], CBORDecodeStatusMalformed);
+    [decoder reset];
+    XCTAssertEqual([decoder feed:CBORData(0x5f, 0x61)], CBORDecodeStatusMalformed);
+    
+    // 顶层的单独终止符不是数据项
+    [decoder reset];
+    [objects removeAllObjects];
+    XCTAssertEqual([decoder feed:CBORData(0xff)], CBORDecodeStatusMalformed);
+    XCTAssertEqual([objects count], 0);
+    
+    // 解码限制作用于每个顶层元素，声明的长度/数量超出时无需等待数据
+    CBORIncrementalDecoder *limited = [[CBORIncrementalDecoder alloc] initWithItemHandler:^(id object) {
+        [objects addObject:object];
+    } limits:CBORDecodeLimitsMake(2, 4, 16)];
+    [objects removeAllObjects];
+    XCTAssertEqual([limited feed:CBORData(0x82, 0x01, 0x02, 0x83, 0x01, 0x02, 0x03)], CBORDecodeStatusOK);
+    XCTAssertEqualObjects(objects, (@[@[@1, @2], @[@1, @2, @3]]));
+    XCTAssertEqual([limited feed:CBORData(0x5b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff)], CBORDecodeStatusMalformed);
+    [limited reset];
+    XCTAssertEqual([limited feed:CBORData(0x9b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04)], CBORDecodeStatusMalformed);
+    [limited reset];
+    XCTAssertEqual([limited feed:CBORData(0xbb, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02)], CBORDecodeStatusMalformed);
+    // 嵌套深度
+    [limited reset];
+    XCTAssertEqual([limited feed:CBORData(0x81, 0x81)], CBORDecodeStatusNeedMoreData);
+    XCTAssertEqual([limited feed:CBORData(0x81)], CBORDecodeStatusMalformed);
+    // 不定长元素逐个到达时累计元素数量与字节数
+    [limited reset];
+    XCTAssertEqual([limited feed:CBORData(0x9f, 0x01, 0x02, 0x03)], CBORDecodeStatusNeedMoreData);
+    XCTAssertEqual([limited feed:CBORData(0x04)], CBORDecodeStatusMalformed);
+    [limited reset];
+    XCTAssertEqual([limited feed:CBORData(0x5f, 0x47, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07)], CBORDecodeStatusNeedMoreData);
+    XCTAssertEqual([limited feed:CBORData(0x48)], CBORDecodeStatusMalformed);
+}
+
+
+/// 测试解码限制
+- (void)testDecodeLimits {
+    // 深层嵌套数组 [[[...]]]
+    NSUInteger depth = 2000;
+    NSMutableData *nested = [NSMutableData dataWithLength:depth + 1];
+    memset([nested mutableBytes], 0x81, depth);
+    ((UInt8 *)[nested mutableBytes])[depth] = 0x01;
+    
+    XCTAssertNil([CBORParser decodeData:nested]);
+    XCTAssertNotNil([CBORParser decodeData:nested limits:CBORDecodeLimitsMake(0, 0, 0)]);
+    XCTAssertNotNil([CBORParser decodeData:nested limits:CBORDecodeLimitsMake(depth, 0, 0)]);
+    XCTAssertNil([CBORParser decodeData:nested limits:CBORDecodeLimitsMake(depth - 1, 0, 0)]);
+    
+    // [1, 2, 3]
+    NSData *data = CBORData(0x83, 0x01, 0x02, 0x03);
+    XCTAssertEqualObjects([CBORParser decodeData:data limits:CBORDecodeLimitsMake(0, 4, 4)], (@[@1, @2, @3]));
+    XCTAssertNil([CBORParser decodeData:data limits:CBORDecodeLimitsMake(0, 3, 0)]);
+    XCTAssertNil([CBORParser decodeData:data limits:CBORDecodeLimitsMake(0, 0, 3)]);
+    
+    // 声明数量超出剩余数据
+    XCTAssertNil([CBORParser decodeData:CBORData(0x9b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01)]);
+    XCTAssertNil([CBORParser decodeData:CBORData(0xbb, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01)]);
+    // 终止符位置非法
+    XCTAssertNil([CBORParser decodeData:CBORData(0x82, 0x01, 0xff)]);
+    XCTAssertNil([CBORParser decodeData:CBORData(0xbf, 0x01, 0xff)]);
+    XCTAssertNil([CBORParser decodeData:CBORData(0x5f, 0x61, 0x61, 0xff)]);
+    // 不定长元素
+    XCTAssertEqualObjects([CBORParser decodeData:CBORData(0x9f, 0x01, 0x9f, 0x02, 0xff, 0xff)], (@[@1, @[@2]]));
+    XCTAssertEqualObjects([CBORParser decodeData:CBORData(0x7f, 0x61, 0x61, 0x61, 0x62, 0xff)], @"ab");
+}
+
+
+/// 测试直接解码为原生对象
+- (void)testDecodeObject {
+    // {"a": [1, -1, 1.5, true, null], "b": {_ "c": h'01'}, 34("YWI="): (_ "x", "y")}
+    NSData *data = CBORData(0xa3,
+                            0x61, 0x61, 0x85, 0x01, 0x20, 0xf9, 0x3e, 0x00, 0xf5, 0xf6,
+                            0x61, 0x62, 0xbf, 0x61, 0x63, 0x41, 0x01, 0xff,
+                            0xd8, 0x22, 0x64, 0x59, 0x57, 0x49, 0x3d, 0x7f, 0x61, 0x78, 0x61, 0x79, 0xff);
+    NSDictionary *expected = @{@"a": @[@1, @(-1), @1.5, @YES, [NSNull null]],
+                               @"b": @{@"c": CBORData(0x01)},
+                               @"ab": @"xy"};
+    XCTAssertEqualObjects([CBORParser decodeData:data], expected);
+    
+    // 非法UTF8字符串作为值时忽略该项
+    XCTAssertEqualObjects([CBORParser decodeData:CBORData(0xa2, 0x01, 0x61, 0xff, 0x02, 0x03)], @{@2: @3});
+    XCTAssertNil([CBORParser decodeData:CBORData(0x81, 0x61, 0xff)]);
+}
+
+
+/// 测试事件驱动解码
+- (void)testDecodeEvents {
+    // {"a": [1, -2, 1.5, null], "b": 1(h'0102'), "c": (_ "x", "y"), "d": []}
+    NSData *data = CBORData(0xa4,
+                            0x61, 0x61, 0x84, 0x01, 0x21, 0xf9, 0x3e, 0x00, 0xf6,
+                            0x61, 0x62, 0xc1, 0x42, 0x01, 0x02,
+                            0x61, 0x63, 0x7f, 0x61, 0x78, 0x61, 0x79, 0xff,
+                            0x61, 0x64, 0x80);
+    CBORTestEventRecorder *recorder = [CBORTestEventRecorder new];
+    XCTAssertTrue([CBORParser decodeData:data delegate:recorder]);
+    NSArray *expected = @[@"{4", @"a", @"[4", @"1", @"-2", @"1.5", @"simple(22)", @"]",
+                          @"b", @"tag(1)", @"h2",
+                          @"c", @"(_", @"x", @"y", @")",
+                          @"d", @"[0", @"]", @"}"];
+    XCTAssertEqualObjects(recorder.events, expected);
+    
+    // 跳过扩展标记内容
+    recorder = [CBORTestEventRecorder new];
+    recorder.skipTag = 1;
+    XCTAssertTrue([CBORParser decodeData:CBORData(0x82, 0xc1, 0x82, 0x01, 0x02, 0x03) delegate:recorder]);
+    XCTAssertEqualObjects(recorder.events, (@[@"[2", @"tag(1)", @"3", @"]"]));
+    
+    // 提前停止
+    recorder = [CBORTestEventRecorder new];
+    recorder.stopString = @"b";
+    XCTAssertTrue([CBORParser decodeData:data delegate:recorder]);
+    XCTAssertEqualObjects([recorder.events lastObject], @"b");
+    
+    // 与对象解码接受同样的输入
+    XCTAssertFalse([CBORParser decodeData:CBORData(0x82, 0x01, 0xff) delegate:[CBORTestEventRecorder new]]);
+    XCTAssertFalse([CBORParser decodeData:CBORData(0x5f, 0x61, 0x61, 0xff) delegate:[CBORTestEventRecorder new]]);
+    XCTAssertFalse([CBORParser decodeData:CBORData(0x19, 0x03) delegate:[CBORTestEventRecorder new]]);
+    // 单独的终止符不是数据项，跳过元素时同样不合法
+    XCTAssertFalse([CBORParser decodeData:CBORData(0xff) delegate:[CBORTestEventRecorder new]]);
+    XCTAssertNil([CBORParser valueAtPath:@[@"b"] inData:CBORData(0xa2, 0x61, 'a', 0xff, 0x61, 'b', 0x01)]);
+    // 只校验结构，字符串的UTF8编码不影响结构
+    XCTAssertTrue([CBORParser decodeData:CBORData(0x82, 0x61, 0xc0, 0x01) delegate:[CBORTestEventRecorder new]]);
+}
+
+
+/// 测试按路径解码
+- (void)testValueAtPath {
+    // {"meta": {"items": [h'0102', (_ "x"), 55("a"), {"id": 7}], 1: "one"}}
+    NSData *data = CBORData(0xa1, 0x64, 0x6d, 0x65, 0x74, 0x61,
+                            0xa2, 0x65, 0x69, 0x74, 0x65, 0x6d, 0x73,
+                            0x84, 0x42, 0x01, 0x02, 0x7f, 0x61, 0x78, 0xff, 0xd8, 0x37, 0x61, 0x61,
+                            0xa1, 0x62, 0x69, 0x64, 0x07,
+                            0x01, 0x63, 0x6f, 0x6e, 0x65);
+    XCTAssertEqualObjects([CBORParser valueAtPath:@[@"meta", @"items", @3, @"id"] inData:data], @7);
+    XCTAssertEqualObjects([CBORParser valueAtPath:@[@"meta", @"items", @1] inData:data], @"x");
+    XCTAssertEqualObjects([CBORParser valueAtPath:@[@"meta", @1] inData:data], @"one");
+    XCTAssertEqualObjects([CBORParser valueAtPath:@[] inData:data], [CBORParser decodeData:data]);
+    
+    XCTAssertNil([CBORParser valueAtPath:@[@"meta", @"items", @4] inData:data]);
+    XCTAssertNil([CBORParser valueAtPath:@[@"meta", @"other"] inData:data]);
+    XCTAssertNil([CBORParser valueAtPath:@[@"meta", @"items", @"id"] inData:data]);
+    // 不定长容器
+    XCTAssertEqualObjects([CBORParser valueAtPath:@[@1] inData:CBORData(0x9f, 0x01, 0x02, 0xff)], @2);
+    XCTAssertNil([CBORParser valueAtPath:@[@2] inData:CBORData(0x9f, 0x01, 0x02, 0xff)]);
+    XCTAssertEqualObjects([CBORParser valueAtPath:@[@"b"] inData:CBORData(0xbf, 0x61, 0x61, 0x01, 0x61, 0x62, 0x02, 0xff)], @2);
+    
+    // 重复键与完整解码一致取最后一个
+    NSData *duplicate = CBORData(0xa3, 0x61, 0x61, 0x01, 0x61, 0x62, 0x02, 0x61, 0x61, 0x03);
+    XCTAssertEqualObjects([CBORParser valueAtPath:@[@"a"] inData:duplicate], @3);
+    XCTAssertEqualObjects([CBORParser valueAtPath:@[@"a"] inData:duplicate], [CBORParser decodeData:duplicate][@"a"]);
+    XCTAssertEqualObjects([CBORParser valueAtPath:@[@"a"] inData:CBORData(0xbf, 0x61, 0x61, 0x01, 0x61, 0x61, 0x02, 0xff)], @2);
+}
+
+
+/// 测试扁平文档
+- (void)testDocument {
+    // {"a": [1, -2, 1.5, true, null], "b": (_ "x", "y"), 1: h'0102', "c": 1("z")}
+    NSData *data = CBORData(0xa4,
+                            0x61, 0x61, 0x85, 0x01, 0x21, 0xf9, 0x3e, 0x00, 0xf5, 0xf6,
+                            0x61, 0x62, 0x7f, 0x61, 0x78, 0x61, 0x79, 0xff,
+                            0x01, 0x42, 0x01, 0x02,
+                            0x61, 0x63, 0xc1, 0x61, 0x7a);
+    CBORDocument *document = [CBORDocument documentWithData:data];
+    XCTAssertNotNil(document);
+    // 1 + (1 + 6) + (1 + 3) + (1 + 1) + (1 + 2)
+    XCTAssertEqual(document.count, 17);
+    
+    CBORValue *root = document.root;
+    XCTAssertEqual(root.type, CBORDocumentTypeMap);
+    XCTAssertEqual(root.count, 4);
+    
+    CBORValue *array = root[@"a"];
+    XCTAssertEqual(array.count, 5);
+    XCTAssertEqual(array[0].unsignedValue, 1);
+    XCTAssertEqual(array[1].integerValue, -2);
+    XCTAssertEqual(array[2].floatValue, 1.5);
+    XCTAssertTrue(array[3].boolValue);
+    XCTAssertTrue(array[4].isNull);
+    XCTAssertNil(array[5]);
+    
+    CBORValue *chunked = root[@"b"];
+    XCTAssertTrue(chunked.isIndefinite);
+    XCTAssertEqual(chunked.count, 2);
+    XCTAssertEqualObjects(chunked.stringValue, @"xy");
+    XCTAssertEqualObjects(root[@1].dataValue, CBORData(0x01, 0x02));
+    XCTAssertEqual(root[@"c"].tag, 1);
+    XCTAssertEqualObjects(root[@"c"].taggedValue.stringValue, @"z");
+    XCTAssertEqualObjects([root keyAtIndex:2].nsObject, @1);
+    XCTAssertNil(root[@"d"]);
+    
+    // 子树转原生对象
+    XCTAssertEqualObjects(array.nsObject, (@[@1, @(-2), @1.5, @YES, [NSNull null]]));
+    XCTAssertEqualObjects(root.nsObject, [CBORParser decodeData:data]);
+    
+    // 重复键与完整解码一致取最后一个：{"k": 1, 2: 2, "k": 3, 2: 4}
+    NSData *duplicate = CBORData(0xa4, 0x61, 'k', 0x01, 0x02, 0x02, 0x61, 'k', 0x03, 0x02, 0x04);
+    CBORValue *duplicateRoot = [CBORDocument documentWithData:duplicate].root;
+    XCTAssertEqual(duplicateRoot[@"k"].unsignedValue, 3);
+    XCTAssertEqual(duplicateRoot[@2].unsignedValue, 4);
+    XCTAssertEqualObjects(duplicateRoot[@"k"].nsObject, duplicateRoot.nsObject[@"k"]);
+    XCTAssertEqualObjects(duplicateRoot[@"k"].nsObject, [CBORParser decodeData:duplicate][@"k"]);
+    
+    XCTAssertNil([CBORDocument documentWithData:CBORData(0x82, 0x01)]);
+    XCTAssertNil([CBORDocument documentWithData:CBORData(0x82, 0x01, 0xff)]);
+}
+
+
+/// 测试并行解码
+- (void)testDecodeConcurrently {
+    // [0, "0", {"k": [0]}, 1, "1", {"k": [1]}, ...]
+    NSUInteger count = 3000;
+    NSMutableData *data = [NSMutableData dataWithData:CBORData(0x99, (count * 3) >> 8, (count * 3) & 0xff)];
+    for (NSUInteger index = 0; index < count; index++) {
+        UInt8 value = index % 24;
+        [data appendData:CBORData(value, 0x61, 0x30 + index % 10, 0xa1, 0x61, 0x6b, 0x81, value)];
+    }
+    id expected = [CBORParser decodeData:data];
+    XCTAssertEqual([expected count], count * 3);
+    XCTAssertEqualObjects([CBORParser decodeDataConcurrently:data], expected);
+    
+    // 不定长数组
+    ((UInt8 *)[data mutableBytes])[0] = 0x9f;
+    [data replaceBytesInRange:NSMakeRange(1, 2) withBytes:NULL length:0];
+    [data appendData:CBORData(0xff)];
+    XCTAssertEqualObjects([CBORParser decodeDataConcurrently:data], expected);
+    
+    // 元素非法
+    [data replaceBytesInRange:NSMakeRange([data length] - 2, 1) withBytes:(UInt8[]){0x1c} length:1];
+    XCTAssertNil([CBORParser decodeDataConcurrently:data]);
+    XCTAssertEqualObjects([CBORParser decodeDataConcurrently:CBORData(0x01)], @1);
+    
+    // 定长数组中的终止符：与顺序解码一样失败
+    NSMutableData *breaks = [NSMutableData dataWithData:CBORData(0x99, 0x01, 0x2c)];
+    for (NSUInteger index = 0; index < 300; index++) {
+        [breaks appendData:index == 150 ? CBORData(0xff) : CBORData(0x01)];
+    }
+    XCTAssertNil([CBORParser decodeData:breaks]);
+    XCTAssertNil([CBORParser decodeDataConcurrently:breaks]);
+    
+    NSArray *batch = [CBORParser decodeDataBatch:@[CBORData(0x01), CBORData(0x19, 0x03), CBORData(0x62, 0x61, 0x62)]];
+    XCTAssertEqualObjects(batch, (@[@1, [NSNull null], @"ab"]));
+}
+
+
+/// 测试CBOR序列
+- (void)testSequence {
+    NSMutableData *data = [NSMutableData data];
+    CBORSequenceWriter *writer = [[CBORSequenceWriter alloc] initWithMutableData:data];
+    XCTAssertTrue([writer appendObject:@1]);
+    XCTAssertTrue([writer appendObject:@"ab"]);
+    // 非法记录：结构完整但字符串编码非法 / 保留的次要类型 / 单独的终止符
+    XCTAssertTrue([writer appendEncodedData:CBORData(0x61, 0xff)]);
+    XCTAssertTrue([writer appendEncodedData:CBORData(0x1c)]);
+    XCTAssertTrue([writer appendEncodedData:CBORData(0xff)]);
+    XCTAssertTrue([writer appendObject:@[@2]]);
+    
+    CBORSequenceReader *reader = [[CBORSequenceReader alloc] initWithData:data];
+    id object = nil;
+    NSUInteger offset = 0;
+    XCTAssertEqual([reader readObject:&object offset:&offset], CBORDecodeStatusOK);
+    XCTAssertEqualObjects(object, @1);
+    XCTAssertEqual(offset, 0);
+    XCTAssertEqual([reader readObject:&object offset:&offset], CBORDecodeStatusOK);
+    XCTAssertEqualObjects(object, @"ab");
+    XCTAssertEqual(offset, 1);
+    XCTAssertEqual([reader readObject:&object offset:&offset], CBORDecodeStatusMalformed);
+    XCTAssertEqual(offset, 4);
+    XCTAssertEqual([reader readObject:&object offset:&offset], CBORDecodeStatusMalformed);
+    XCTAssertEqual(offset, 6);
+    XCTAssertEqual([reader readObject:&object offset:&offset], CBORDecodeStatusMalformed);
+    XCTAssertNil(object);
+    XCTAssertEqual(offset, 7);
+    XCTAssertEqual([reader readObject:&object offset:&offset], CBORDecodeStatusOK);
+    XCTAssertEqualObjects(object, @[@2]);
+    XCTAssertTrue([reader isAtEnd]);
+    XCTAssertEqual([reader readObject:&object offset:&offset], CBORDecodeStatusNeedMoreData);
+    
+    // 文件追加
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    writer = [[CBORSequenceWriter alloc] initWithFile:path];
+    XCTAssertTrue([writer appendObject:@{@"a": @1}]);
+    [writer close];
+    writer = [[CBORSequenceWriter alloc] initWithFile:path];
+    XCTAssertTrue([writer appendObject:@3]);
+    [writer close];
+    XCTAssertFalse([writer appendObject:@4]);
+    
+    reader = [[CBORSequenceReader alloc] initWithContentsOfFile:path];
+    XCTAssertEqualObjects([reader nextObject], @{@"a": @1});
+    XCTAssertEqualObjects([reader nextObject], @3);
+    XCTAssertNil([reader nextObject]);
+    [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
+}
+
+- (void)testDecodeContentsOfFile {
+    // {"k": h'0102', "s": ["abc", "é"]}
+    NSData *data = CBORData(0xa2, 0x61, 0x6b, 0x42, 0x01, 0x02, 0x61, 0x73, 0x82, 0x63, 0x61, 0x62, 0x63, 0x62, 0xc3, 0xa9);
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    XCTAssertTrue([data writeToFile:path atomically:YES]);
+    
+    id expected = [CBORParser decodeData:data];
+    XCTAssertEqualObjects([CBORParser decodeContentsOfFile:path options:CBORDecodeOptionsNone], expected);
+    
+    id object = [CBORParser decodeContentsOfFile:path options:CBORDecodeOptionsNoCopyStrings];
+    XCTAssertEqualObjects(object, expected);
+    XCTAssertEqualObjects(object[@"s"][0], @"abc");
+    XCTAssertEqualObjects(object[@"k"], CBORData(0x01, 0x02));
+    [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
+    
+    XCTAssertNil([CBORParser decodeContentsOfFile:path options:CBORDecodeOptionsNone]);
+}
+
+- (void)testInternTable {
+    // [{"id": 1, "v": -1}, {"id": 2, "v": true}]
+    NSData *data = CBORData(0x82, 0xa2, 0x62, 0x69, 0x64, 0x01, 0x61, 0x76, 0x20, 0xa2, 0x62, 0x69, 0x64, 0x02, 0x61, 0x76, 0xf5);
+    NSArray *object = [CBORParser decodeData:data];
+    XCTAssertEqualObjects(object, (@[@{@"id": @1, @"v": @-1}, @{@"id": @2, @"v": @YES}]));
+    
+    // 重复的键为同一实例
+    NSArray *firstKeys = [object[0] allKeys];
+    NSArray *secondKeys = [object[1] allKeys];
+    NSString *first = firstKeys[[firstKeys indexOfObject:@"id"]];
+    NSString *second = secondKeys[[secondKeys indexOfObject:@"id"]];
+    XCTAssertTrue(first == second);
+    
+    CBORInternTable *table = [[CBORInternTable alloc] initWithCapacity:2];
+    NSString *a = [table stringWithUTF8Bytes:"key" length:3];
+    XCTAssertTrue(a == [table stringWithUTF8Bytes:"key" length:3]);
+    XCTAssertNotNil([table stringWithUTF8Bytes:"k2" length:2]);
+    XCTAssertEqualObjects([table stringWithUTF8Bytes:"k3" length:2], @"k3");
+    XCTAssertEqual(table.count, 2);
+    XCTAssertNil([table stringWithUTF8Bytes:"\xff" length:1]);
+    
+    XCTAssertEqualObjects([CBORParser decodeData:data internTable:table], object);
+    [table removeAllStrings];
+    XCTAssertEqual(table.count, 0);
+}
+
+- (void)testUTF8 {
+    // 纯ASCII（超过向量宽度）
+    NSString *ascii = @"abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJ";
+    NSMutableData *data = [CBORData(0x78, (UInt8)ascii.length) mutableCopy];
+    [data appendData:[ascii dataUsingEncoding:NSUTF8StringEncoding]];
+    XCTAssertEqualObjects([CBORParser decodeData:data], ascii);
+    
+    // ASCII后接多字节字符
+    XCTAssertEqualObjects([CBORParser decodeData:CBORData(0x69, 0x61, 0x62, 0xc3, 0xa9, 0xe4, 0xb8, 0xad, 0x21, 0x7a)], @"ab\u00e9\u4e2d!z");
+    XCTAssertEqualObjects([CBORParser decodeData:CBORData(0x64, 0xf0, 0x9f, 0x98, 0x80)], @"\U0001F600");
+    
+    // 超长编码、代理区、超出范围与截断的字符
+    XCTAssertNil([CBORParser decodeData:CBORData(0x62, 0xc0, 0xaf)]);
+    XCTAssertNil([CBORParser decodeData:CBORData(0x63, 0xed, 0xa0, 0x80)]);
+    XCTAssertNil([CBORParser decodeData:CBORData(0x64, 0xf4, 0x90, 0x80, 0x80)]);
+    XCTAssertNil([CBORParser decodeData:CBORData(0x62, 0x61, 0xe4)]);
+    
+    // 不定长字符串拼接，任一分段非法则整体非法
+    id chunked = [CBORParser decodeData:CBORData(0x7f, 0x62, 0x61, 0x62, 0x62, 0xc3, 0xa9, 0xff)];
+    XCTAssertEqualObjects(chunked, @"ab\u00e9");
+    XCTAssertTrue([chunked isKindOfClass:[NSMutableString class]]);
+    XCTAssertNil([CBORParser decodeData:CBORData(0x7f, 0x61, 0xc3, 0x61, 0xa9, 0xff)]);
+    
+    // 非法字符串作为键值对的值时忽略该项，定长与不定长一致
+    XCTAssertEqualObjects([CBORParser decodeData:CBORData(0xa2, 0x61, 0x61, 0x61, 0xc3, 0x61, 0x62, 0x01)], (@{@"b": @1}));
+    XCTAssertEqualObjects([CBORParser decodeData:CBORData(0xa2, 0x61, 0x61, 0x7f, 0x61, 0xc3, 0x61, 0x78, 0xff, 0x61, 0x62, 0x01)], (@{@"b": @1}));
+    
+    // 多字节字符跨越向量块边界
+    NSMutableData *mixed = [CBORData(0x78, 0x28) mutableCopy];
+    for (NSUInteger i = 0; i < 10; i++) { [mixed appendBytes:"a\xe4\xb8\xad" length:4]; }
+    NSString *expected = [@"" stringByPaddingToLength:20 withString:@"a\u4e2d" startingAtIndex:0];
+    XCTAssertEqualObjects([CBORParser decodeData:mixed], expected);
+    [mixed replaceBytesInRange:NSMakeRange(mixed.length - 1, 1) withBytes:"a"];
+    XCTAssertNil([CBORParser decodeData:mixed]);
+}
+
+- (void)testTypedArray {
+    // 64(h'0102')，65(h'00010203')，69(h'00010203')
+    CBORTypedArray *bytes = [CBORParser decodeData:CBORData(0xd8, 0x40, 0x42, 0x01, 0x02)];
+    XCTAssertEqual(bytes.type, CBORTypedArrayTypeUInt8);
+    XCTAssertEqualObjects([bytes numbers], (@[@1, @2]));
+    CBORTypedArray *big = [CBORParser decodeData:CBORData(0xd8, 0x41, 0x44, 0x00, 0x01, 0x02, 0x03)];
+    XCTAssertEqualObjects([big numbers], (@[@1, @515]));
+    CBORTypedArray *little = [CBORParser decodeData:CBORData(0xd8, 0x45, 0x44, 0x00, 0x01, 0x02, 0x03)];
+    XCTAssertEqualObjects([little numbers], (@[@256, @770]));
+    
+    // 72(h'ff01')，84(h'003c00c0')
+    XCTAssertEqualObjects([[CBORParser decodeData:CBORData(0xd8, 0x48, 0x42, 0xff, 0x01)] numbers], (@[@-1, @1]));
+    CBORTypedArray *halves = [CBORParser decodeData:CBORData(0xd8, 0x54, 0x44, 0x00, 0x3c, 0x00, 0xc0)];
+    XCTAssertEqual(halves.type, CBORTypedArrayTypeFloat16);
+    XCTAssertEqualObjects([halves numbers], (@[@1.0, @-2.0]));
+    XCTAssertEqual([[halves float32Data] length], 2 * sizeof(Float32));
+    
+    // 长度不整齐非法；128位浮点数保持字节数组
+    XCTAssertNil([CBORParser decodeData:CBORData(0xd8, 0x41, 0x43, 0x00, 0x01, 0x02)]);
+    XCTAssertEqualObjects([CBORParser decodeData:CBORData(0xd8, 0x53, 0x41, 0x00)], CBORData(0x00));
+    
+    // 大端数据批量转换字节序
+    NSMutableData *samples = [CBORData(0xd8, 0x52, 0x58, 0x50) mutableCopy];
+    NSMutableArray *expected = [NSMutableArray array];
+    for (UInt64 index = 0; index < 10; index++) {
+        Float64 value = index * 0.5;
+        UInt64 bits = 0;
+        memcpy(&bits, &value, sizeof(bits));
+        bits = CFSwapInt64HostToBig(bits);
+        [samples appendBytes:&bits length:sizeof(bits)];
+        [expected addObject:@(index * 0.5)];
+    }
+    XCTAssertEqualObjects([[CBORParser decodeData:samples] numbers], expected);
+    
+    // 元素类型一致的数值数组按选项编码
+    NSArray *numbers = @[@1, @2, @3];
+    NSData *encoded = [CBORParser encodeObject:numbers options:CBOREncodeOptionsTypedArrays];
+    CBORTypedArray *typed = [CBORTypedArray typedArrayWithNumbers:numbers];
+    XCTAssertEqual(typed.type, CBORTypedArrayTypeSInt32);
+    XCTAssertEqual(encoded.length, 3 + 12);
+    XCTAssertEqualObjects([[CBORParser decodeData:encoded] numbers], numbers);
+    XCTAssertEqualObjects([CBORParser encodeObject:numbers], CBORData(0x83, 0x01, 0x02, 0x03));
+    XCTAssertEqualObjects([CBORParser encodeObject:(@[@1, @1.5]) options:CBOREncodeOptionsTypedArrays], [CBORParser encodeObject:(@[@1, @1.5])]);
+    
+    // 指定字节序编码
+    XCTAssertEqualObjects([CBORParser encodeObject:[CBORTypedArray typedArrayWithNumbers:@[@1, @515] type:CBORTypedArrayTypeUInt16]
+                                             major:CBORMajorTypeTag
+                                             minor:CBORTagTypeTypedArrayUInt16BE],
+                          CBORData(0xd8, 0x41, 0x44, 0x00, 0x01, 0x02, 0x03));
+}
+
+- (void)testDecodeClassSinglePass {
+    NSDictionary *source = @{
+        @"ID": @"m1",
+        @"address": @{ @"city": @"Xiamen", @"zip": @"361000" },
+        @"score": @"9.5",
+        @"item": @{ @"name": @"a", @"count": @2 },
+        @"items": @[@{ @"name": @"b" }, @1, @{ @"count": @3 }],
+        @"named": @{ @"c": @{ @"name": @"c" }, @"skip": @"value" },
+        @"unused": @[@{ @"deep": @[@1, @2] }],
+        @1: @"number key",
+    };
+    NSData *data = [CBORParser encodeObject:source];
+    CBORTestModel *model = [CBORParser decodeClass:[CBORTestModel class] fromData:data];
+    XCTAssertEqualObjects(model.identifier, @"m1");
+    XCTAssertEqualObjects(model.city, @"Xiamen");
+    XCTAssertEqual(model.score, 9.5);
+    XCTAssertEqualObjects(model.item.name, @"a");
+    XCTAssertEqual(model.item.count, 2);
+    XCTAssertEqual(model.items.count, 2);
+    XCTAssertEqualObjects(model.items[0].name, @"b");
+    XCTAssertEqual(model.items[1].count, 3);
+    XCTAssertEqualObjects([model.named allKeys], @[@"c"]);
+    XCTAssertEqualObjects(model.named[@"c"].name, @"c");
+    
+    // 模型数组跳过非字典元素；跳过的值同样校验合法性
+    NSArray *models = [CBORParser decodeClass:[CBORTestModelItem class] fromData:[CBORParser encodeObject:@[@{ @"name": @"x" }, @"y"]]];
+    XCTAssertEqual(models.count, 1);
+    XCTAssertEqualObjects([models.firstObject name], @"x");
+    // {"unused": [1, 2 (截断)}
+    XCTAssertNil([CBORParser decodeClass:[CBORTestModelItem class] fromData:CBORData(0xa1, 0x66, 0x75, 0x6e, 0x75, 0x73, 0x65, 0x64, 0x82, 0x01)]);
+    // {_ "name": "z"}，定长数组中的终止符非法
+    XCTAssertEqualObjects([[CBORParser decodeClass:[CBORTestModelItem class] fromData:CBORData(0xbf, 0x64, 0x6e, 0x61, 0x6d, 0x65, 0x61, 0x7a, 0xff)] name], @"z");
+    XCTAssertNil([CBORParser decodeClass:[CBORTestModelItem class] fromData:CBORData(0x81, 0xff)]);
+}
+
+- (void)testEncodeWriter {
+    XCTAssertEqualObjects([CBORParser encodeObject:(@[@1, @[@2, @3], @{ @"a": @"b" }])],
+                          CBORData(0x83, 0x01, 0x82, 0x02, 0x03, 0xa1, 0x61, 0x61, 0x61, 0x62));
+    // 指定长度类型
+    XCTAssertEqualObjects([CBORParser encodeObject:@[@1] major:CBORMajorTypeArray minor:CBORLengthTypeUInt16], CBORData(0x99, 0x00, 0x01, 0x01));
+    // 数组中存在无法编码的元素时整体失败
+    XCTAssertNil([CBORParser encodeObject:(@[@1, [NSObject new]])]);
+    
+    // 无法编码的值不计入数量，头部随实际数量缩短
+    NSMutableDictionary *dictionary = [NSMutableDictionary dictionary];
+    for (NSInteger index = 0; index < 23; index++) { dictionary[@(index)] = @(index); }
+    dictionary[@"skip"] = [NSObject new];
+    NSData *data = [CBORParser encodeObject:dictionary];
+    XCTAssertEqual(((const UInt8 *)[data bytes])[0], 0xb7);
+    XCTAssertEqual([[CBORParser decodeData:data] count], 23);
+    
+    // 嵌套模型
+    CBORTestModelItem *item = [CBORTestModelItem new];
+    item.name = @"a";
+    item.count = 2;
+    NSDictionary *decoded = [[CBORParser decodeData:[CBORParser encodeObject:@[item]]] firstObject];
+    XCTAssertEqualObjects(decoded, (@{ @"name": @"a", @"count": @2 }));
+}
+
+- (void)testEncodedLength {
+    NSArray *objects = @[@0, @24, @-500, @1.5, @(M_PI), @"", @"hello", [NSNull null], CBORData(0x01, 0x02),
+                         @[@1, @[@2]], @{ @"a": @[@1, @2], @3: @{ @"b": @YES } }, [NSDate dateWithTimeIntervalSince1970:0]];
+    for (id object in objects) {
+        XCTAssertEqual([CBORParser encodedLengthOfObject:object], [[CBORParser encodeObject:object] length], @"%@", object);
+    }
+    
+    // 跨越头部长度边界
+    NSMutableArray *array = [NSMutableArray array];
+    for (NSInteger index = 0; index < 300; index++) { [array addObject:@(index)]; }
+    XCTAssertEqual([CBORParser encodedLengthOfObject:array], [[CBORParser encodeObject:array] length]);
+    XCTAssertEqual([CBORParser encodedLengthOfObject:array options:CBOREncodeOptionsTypedArrays],
+                   [[CBORParser encodeObject:array options:CBOREncodeOptionsTypedArrays] length]);
+    
+    // 精确预分配与默认单次写入输出一致
+    XCTAssertEqualObjects([CBORParser encodeObject:array options:CBOREncodeOptionsExactCapacity], [CBORParser encodeObject:array]);
+    
+    // 无法编码
+    XCTAssertEqual([CBORParser encodedLengthOfObject:(@[[NSObject new]])], 0);
+}
+
+- (void)testStreamEncoder {
+    NSMutableData *output = [NSMutableData data];
+    CBORStreamEncoder *encoder = [[CBORStreamEncoder alloc] initWithSink:^NSInteger(const UInt8 *bytes, NSUInteger length) {
+        [output appendBytes:bytes length:length];
+        return length;
+    } bufferCapacity:16];
+    
+    // [_ 1, {_ "a": 2}, (_ "ab", "c")]
+    XCTAssertEqual([encoder beginArray], CBOREncodeStatusOK);
+    XCTAssertEqual([encoder encodeObject:@1], CBOREncodeStatusOK);
+    XCTAssertEqual([encoder beginMap], CBOREncodeStatusOK);
+    XCTAssertEqual([encoder encodeObject:@"a"], CBOREncodeStatusOK);
+    XCTAssertEqual([encoder end], CBOREncodeStatusInvalid);
+    XCTAssertEqual([encoder encodeObject:@2], CBOREncodeStatusOK);
+    XCTAssertEqual([encoder end], CBOREncodeStatusOK);
+    XCTAssertEqual([encoder beginTextString], CBOREncodeStatusOK);
+    XCTAssertEqual([encoder encodeObject:@1], CBOREncodeStatusInvalid);
+    XCTAssertEqual([encoder encodeObject:@"ab"], CBOREncodeStatusOK);
+    XCTAssertEqual([encoder encodeObject:@"c"], CBOREncodeStatusOK);
+    XCTAssertEqual([encoder end], CBOREncodeStatusOK);
+    XCTAssertEqual([encoder finish], CBOREncodeStatusInvalid);
+    XCTAssertEqual([encoder end], CBOREncodeStatusOK);
+    XCTAssertEqual([encoder end], CBOREncodeStatusInvalid);
+    XCTAssertEqual([encoder finish], CBOREncodeStatusOK);
+    XCTAssertEqualObjects(output, CBORData(0x9f, 0x01, 0xbf, 0x61, 0x61, 0x02, 0xff, 0x7f, 0x62, 0x61, 0x62, 0x61, 0x63, 0xff, 0xff));
+    XCTAssertEqualObjects([CBORParser decodeData:output], (@[@1, @{ @"a": @2 }, @"abc"]));
+    XCTAssertEqual(encoder.bytesWritten, output.length);
+    
+    // 输出流
+    NSOutputStream *stream = [NSOutputStream outputStreamToMemory];
+    [stream open];
+    CBORStreamEncoder *streamEncoder = [[CBORStreamEncoder alloc] initWithOutputStream:stream];
+    XCTAssertEqual([streamEncoder encodeObject:@[@1, @"x"]], CBOREncodeStatusOK);
+    XCTAssertEqual([streamEncoder finish], CBOREncodeStatusOK);
+    XCTAssertEqualObjects([stream propertyForKey:NSStreamDataWrittenToMemoryStreamKey], CBORData(0x82, 0x01, 0x61, 0x78));
+    [stream close];
+    
+    // 背压：缓冲区满后拒绝写入，可写后继续
+    __block BOOL writable = NO;
+    NSMutableData *blocked = [NSMutableData data];
+    CBORStreamEncoder *blocking = [[CBORStreamEncoder alloc] initWithSink:^NSInteger(const UInt8 *bytes, NSUInteger length) {
+        if (!writable) { return 0; }
+        [blocked appendBytes:bytes length:length];
+        return length;
+    } bufferCapacity:16];
+    CBOREncodeStatus status = CBOREncodeStatusOK;
+    NSUInteger accepted = 0;
+    while ((status = [blocking encodeObject:@"0123456789"]) == CBOREncodeStatusOK) { accepted++; }
+    XCTAssertEqual(status, CBOREncodeStatusWouldBlock);
+    XCTAssertEqual(accepted, 2);
+    writable = YES;
+    XCTAssertEqual([blocking flush], CBOREncodeStatusOK);
+    XCTAssertEqual(blocked.length, 22);
+    
+    // 写入失败
+    CBORStreamEncoder *failing = [[CBORStreamEncoder alloc] initWithSink:^NSInteger(const UInt8 *bytes, NSUInteger length) {
+        return -1;
+    }];
+    XCTAssertEqual([failing encodeObject:@1], CBOREncodeStatusOK);
+    XCTAssertEqual([failing finish], CBOREncodeStatusError);
+    XCTAssertEqual([failing encodeObject:@1], CBOREncodeStatusError);
+}
+
+- (void)testEncodeModelPlan {
+    CBORTestScalarModel *model = [CBORTestScalarModel new];
+    model.flag = YES;
+    model.small = -2;
+    model.medium = 1000;
+    model.large = UINT64_MAX;
+    model.ratio = 1.5f;
+    model.invalid = NAN;
+    model.city = @"x";
+    
+    // 非法浮点数不编码；键路径只有部分值时嵌套字典只含已有的值
+    NSData *expected = CBORData(0xa6,
+                                0x64, 'f', 'l', 'a', 'g', 0xf5,
+                                0x65, 's', 'm', 'a', 'l', 'l', 0x21,
+                                0x66, 'm', 'e', 'd', 'i', 'u', 'm', 0x19, 0x03, 0xe8,
+                                0x65, 'l', 'a', 'r', 'g', 'e', 0x1b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                                0x65, 'r', 'a', 't', 'i', 'o', 0xf9, 0x3e, 0x00,
+                                0x67, 'a', 'd', 'd', 'r', 'e', 's', 's', 0xa1, 0x64, 'c', 'i', 't', 'y', 0x61, 'x');
+    XCTAssertEqualObjects([CBORParser encodeObject:model], expected);
+    XCTAssertEqual([CBORParser encodedLengthOfObject:model], expected.length);
+    
+    // 共享上级的键路径合并到同一嵌套字典
+    model.street = @"y";
+    NSData *data = [CBORParser encodeObject:model];
+    NSDictionary *decoded = (NSDictionary *)[CBORParser decodeData:data];
+    XCTAssertEqualObjects(decoded[@"address"], (@{ @"city": @"x", @"street": @"y" }));
+    XCTAssertEqual([decoded count], 6);
+    
+    CBORTestScalarModel *decodedModel = (CBORTestScalarModel *)[CBORParser decodeClass:[CBORTestScalarModel class] fromData:data];
+    XCTAssertEqual(decodedModel.small, -2);
+    XCTAssertEqual(decodedModel.large, UINT64_MAX);
+    XCTAssertEqualObjects(decodedModel.street, @"y");
+}
+
+- (void)testEncodeLeafFastPaths {
+    // 字符串：ASCII、含空字符、非ASCII与可变字符串
+    XCTAssertEqualObjects([CBORParser encodeObject:@"abc"], CBORData(0x63, 0x61, 0x62, 0x63));
+    XCTAssertEqualObjects([CBORParser encodeObject:@""], CBORData(0x60));
+    XCTAssertEqualObjects([CBORParser encodeObject:[NSString stringWithFormat:@"a%Cb", (unichar)0]], CBORData(0x63, 0x61, 0x00, 0x62));
+    XCTAssertEqualObjects([CBORParser encodeObject:@"\u00fc"], CBORData(0x62, 0xc3, 0xbc));
+    XCTAssertEqualObjects([CBORParser encodeObject:[NSMutableString stringWithString:@"h\u00e9"]], CBORData(0x63, 0x68, 0xc3, 0xa9));
+    NSString *longString = [@"" stringByPaddingToLength:300 withString:@"\u00e9" startingAtIndex:0];
+    NSData *longData = [CBORParser encodeObject:longString];
+    XCTAssertEqual(longData.length, 3 + 600);
+    XCTAssertEqualObjects([CBORParser decodeData:longData], longString);
+    
+    // 数字：按类型编码字符区分布尔、整数与浮点数
+    XCTAssertEqualObjects([CBORParser encodeObject:@YES], CBORData(0xf5));
+    XCTAssertEqualObjects([CBORParser encodeObject:@((UInt8)200)], CBORData(0x18, 0xc8));
+    XCTAssertEqualObjects([CBORParser encodeObject:@(-500)], CBORData(0x39, 0x01, 0xf3));
+    XCTAssertEqualObjects([CBORParser encodeObject:@(UINT64_MAX)], CBORData(0x1b, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff));
+    XCTAssertEqualObjects([CBORParser encodeObject:@1.5f], CBORData(0xf9, 0x3e, 0x00));
+    XCTAssertEqualObjects([CBORParser encodeObject:@(0.1)], CBORData(0xfb, 0x3f, 0xb9, 0x99, 0x99, 0x99, 0x99, 0x99, 0x9a));
+    
+    // 时间：整数秒与小数秒
+    XCTAssertEqualObjects([CBORParser encodeObject:[NSDate dateWithTimeIntervalSince1970:0]], CBORData(0xc1, 0x00));
+    XCTAssertEqualObjects([CBORParser encodeObject:[NSDate dateWithTimeIntervalSince1970:1.5]], CBORData(0xc1, 0xfb, 0x3f, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00));
+    
+    // 计量长度与写入一致
+    XCTAssertEqual([CBORParser encodedLengthOfObject:(@[@"\u00fc", @(-500), [NSDate dateWithTimeIntervalSince1970:1.5]])], 1 + 3 + 3 + 10);
+}
+
+- (void)testEncodeObjectsParallel {
+    NSMutableArray *models = [NSMutableArray array];
+    NSMutableData *sequence = [NSMutableData data];
+    for (NSInteger index = 0; index < 2000; index++) {
+        CBORTestModelItem *item = [CBORTestModelItem new];
+        item.name = [NSString stringWithFormat:@"item-%ld", (long)index];
+        item.count = index - 1000;
+        [models addObject:item];
+        [sequence appendData:[CBORParser encodeObject:item]];
+    }
+    
+    // 与顺序编码逐字节一致
+    NSData *serial = [CBORParser encodeObject:models];
+    XCTAssertEqualObjects([CBORParser encodeObjects:models parallel:YES], serial);
+    XCTAssertEqualObjects([CBORParser encodeObjects:models parallel:NO], serial);
+    XCTAssertEqualObjects([CBORParser encodeSequenceOfObjects:models parallel:YES], sequence);
+    XCTAssertEqualObjects([CBORParser encodeSequenceOfObjects:models parallel:NO], sequence);
+    XCTAssertEqualObjects([CBORParser encodeObjects:@[] parallel:YES], CBORData(0x80));
+    
+    // 任一元素无法编码时整体失败
+    [models addObject:[NSObject new]];
+    XCTAssertNil([CBORParser encodeObjects:models parallel:YES]);
+    XCTAssertNil([CBORParser encodeSequenceOfObjects:models parallel:YES]);
+}
+
+- (void)testStringReferences {
+    // 重复的键与值写为引用
+    NSArray *records = @[@{ @"name": @"alpha" }, @{ @"name": @"alpha" }];
+    NSData *data = [CBORParser encodeObject:records options:CBOREncodeOptionsStringReferences];
+    XCTAssertEqualObjects(data, CBORData(0xd9, 0x01, 0x00, 0x82,
+                                         0xa1, 0x64, 'n', 'a', 'm', 'e', 0x65, 'a', 'l', 'p', 'h', 'a',
+                                         0xa1, 0xd8, 0x19, 0x00, 0xd8, 0x19, 0x01));
+    XCTAssertEqualObjects([CBORParser decodeData:data], records);
+    XCTAssertEqual([CBORParser encodedLengthOfObject:records options:CBOREncodeOptionsStringReferences], data.length);
+    
+    // 短字符串不编入字符串表
+    XCTAssertEqualObjects([CBORParser encodeObject:@[@"ab", @"ab"] options:CBOREncodeOptionsStringReferences], CBORData(0xd9, 0x01, 0x00, 0x82, 0x62, 'a', 'b', 0x62, 'a', 'b'));
+    
+    // 回退的键值对不占用下标
+    NSArray *skipped = @[@{ @"skipped": [NSObject new] }, @"skipped"];
+    XCTAssertEqualObjects([CBORParser encodeObject:skipped options:CBOREncodeOptionsStringReferences],
+                          CBORData(0xd9, 0x01, 0x00, 0x82, 0xa0, 0x67, 's', 'k', 'i', 'p', 'p', 'e', 'd'));
+    
+    // 模型编码与解码
+    CBORTestModel *model = [CBORTestModel new];
+    NSMutableArray *items = [NSMutableArray array];
+    for (NSInteger index = 0; index < 3; index++) {
+        CBORTestModelItem *item = [CBORTestModelItem new];
+        item.name = @"repeated";
+        item.count = index;
+        [items addObject:item];
+    }
+    model.items = items;
+    model.city = @"repeated";
+    NSData *plain = [CBORParser encodeObject:model];
+    NSData *packed = [CBORParser encodeObject:model options:CBOREncodeOptionsStringReferences];
+    XCTAssertLessThan(packed.length, plain.length);
+    XCTAssertEqualObjects([CBORParser decodeData:packed], [CBORParser decodeData:plain]);
+    
+    CBORTestModel *decoded = [CBORParser decodeClass:[CBORTestModel class] fromData:packed];
+    XCTAssertEqualObjects(decoded.city, @"repeated");
+    XCTAssertEqual(decoded.items.count, 3);
+    XCTAssertEqualObjects(decoded.items.lastObject.name, @"repeated");
+    
+    // 命名空间的头部不限宽度（tag 256写为4字节参数）
+    NSData *wide = CBORData(0xda, 0x00, 0x00, 0x01, 0x00, 0xa2,
+                            0x67, 'a', 'd', 'd', 'r', 'e', 's', 's', 0xa1, 0x64, 'c', 'i', 't', 'y', 0x68, 'r', 'e', 'p', 'e', 'a', 't', 'e', 'd',
+                            0x65, 'i', 't', 'e', 'm', 's', 0x81, 0xa1, 0x64, 'n', 'a', 'm', 'e', 0xd8, 0x19, 0x02);
+    decoded = [CBORParser decodeClass:[CBORTestModel class] fromData:wide];
+    XCTAssertEqualObjects(decoded.city, @"repeated");
+    XCTAssertEqualObjects(decoded.items.firstObject.name, @"repeated");
+    
+    // 嵌套在模型内的命名空间
+    NSData *nested = CBORData(0xa1, 0x65, 'i', 't', 'e', 'm', 's', 0xd9, 0x01, 0x00, 0x82,
+                              0xa1, 0x64, 'n', 'a', 'm', 'e', 0x68, 'r', 'e', 'p', 'e', 'a', 't', 'e', 'd',
+                              0xa1, 0xd8, 0x19, 0x00, 0xd8, 0x19, 0x01);
+    decoded = [CBORParser decodeClass:[CBORTestModel class] fromData:nested];
+    XCTAssertEqual(decoded.items.count, 2);
+    XCTAssertEqualObjects(decoded.items.lastObject.name, @"repeated");
+    
+    NSData *element = CBORData(0xa1, 0x65, 'i', 't', 'e', 'm', 's', 0x81, 0xd9, 0x01, 0x00,
+                               0xa1, 0x64, 'n', 'a', 'm', 'e', 0x68, 'r', 'e', 'p', 'e', 'a', 't', 'e', 'd');
+    decoded = [CBORParser decodeClass:[CBORTestModel class] fromData:element];
+    XCTAssertEqualObjects(decoded.items.firstObject.name, @"repeated");
+    
+    // 引用超出字符串表时数据非法
+    XCTAssertNil([CBORParser decodeData:CBORData(0xd9, 0x01, 0x00, 0xd8, 0x19, 0x00)]);
+}
+
+- (void)testModelIntegerKeys {
+    CBORTestIntegerKeyModel *model = [CBORTestIntegerKeyModel new];
+    model.alg = -7;
+    model.kid = @"k";
+    model.ext = @"e";
+    model.label = @"x";
+    
+    // 整数键替代属性名与键路径，未声明的属性仍使用字符串键
+    NSData *expected = CBORData(0xa4, 0x01, 0x26, 0x04, 0x61, 'k', 0x18, 0x64, 0x61, 'e',
+                                0x65, 'l', 'a', 'b', 'e', 'l', 0x61, 'x');
+    XCTAssertEqualObjects([CBORParser encodeObject:model], expected);
+    XCTAssertEqual([CBORParser encodedLengthOfObject:model], expected.length);
+    
+    CBORTestIntegerKeyModel *decoded = (CBORTestIntegerKeyModel *)[CBORParser decodeClass:[CBORTestIntegerKeyModel class] fromData:expected];
+    XCTAssertEqual(decoded.alg, -7);
+    XCTAssertEqualObjects(decoded.kid, @"k");
+    XCTAssertEqualObjects(decoded.ext, @"e");
+    XCTAssertEqualObjects(decoded.label, @"x");
+    
+    // 整数键不编入字符串表
+    NSData *packed = [CBORParser encodeObject:model options:CBOREncodeOptionsStringReferences];
+    XCTAssertEqualObjects([packed subdataWithRange:NSMakeRange(3, packed.length - 3)], expected);
+    
+    // 兼容字符串键，跳过未声明的整数键
+    NSData *named = CBORData(0xa3, 0x63, 'a', 'l', 'g', 0x26, 0x07, 0xf5,
+                             0x64, 'm', 'e', 't', 'a', 0xa1, 0x63, 'e', 'x', 't', 0x61, 'e');
+    decoded = (CBORTestIntegerKeyModel *)[CBORParser decodeClass:[CBORTestIntegerKeyModel class] fromData:named];
+    XCTAssertEqual(decoded.alg, -7);
+    XCTAssertEqualObjects(decoded.ext, @"e");
+    XCTAssertNil(decoded.kid);
+    
+    // 经由字典转换时同样跳过未声明的整数键
+    NSData *unmapped = CBORData(0xa2, 0x18, 0x63, 0x61, 'x', 0x01, 0x26);
+    CBORTestIntegerKeyTransformModel *transformed = (CBORTestIntegerKeyTransformModel *)[CBORParser decodeClass:[CBORTestIntegerKeyTransformModel class] fromData:unmapped];
+    XCTAssertEqual(transformed.alg, -7);
+    XCTAssertNil(transformed.kid);
+}
+
+- (void)testReusableContexts {
+    NSArray *objects = @[@{ @"name": @"alpha", @"values": @[@1, @-2, @"x"] }, @"text", @[], [NSData dataWithBytes:"ab" length:2]];
+    
+    // 编码结果与无状态接口一致，缓冲区在多次编码间保留
+    CBOREncodeContext *encoder = [CBOREncodeContext new];
+    for (id object in objects) {
+        XCTAssertEqualObjects([encoder encodeObject:object], [CBORParser encodeObject:object]);
+    }
+    NSUInteger capacity = encoder.bufferCapacity;
+    XCTAssertGreaterThan(capacity, 0);
+    [encoder encodeObject:objects.firstObject];
+    XCTAssertEqual(encoder.bufferCapacity, capacity);
+    NSArray *unencodable = @[[NSObject new]];
+    XCTAssertEqualObjects([encoder encodeObject:unencodable], [CBORParser encodeObject:unencodable]);
+    XCTAssertEqualObjects([encoder encodeObject:@"text"], [CBORParser encodeObject:@"text"]);
+    
+    encoder.maximumRetainedCapacity = 0;
+    XCTAssertEqualObjects([encoder encodeObject:objects], [CBORParser encodeObject:objects]);
+    XCTAssertEqual(encoder.bufferCapacity, 0);
+    XCTAssertEqual([CBOREncodeContext currentContext], [CBOREncodeContext currentContext]);
+    
+    // 解码失败后帧栈清空，后续解码不受影响；驻留表跨调用复用
+    CBORDecodeContext *decoder = [CBORDecodeContext new];
+    NSData *data = [CBORParser encodeObject:objects.firstObject];
+    NSDictionary *first = [decoder decodeData:data];
+    XCTAssertEqualObjects(first, objects.firstObject);
+    XCTAssertNil([decoder decodeData:CBORData(0x82, 0xa1, 0x61, 'a')]);
+    NSDictionary *second = [decoder decodeData:data];
+    XCTAssertEqualObjects(second, first);
+    XCTAssertEqual([[first allKeys] firstObject], [[second allKeys] firstObject]);
+    XCTAssertGreaterThan(decoder.internTable.count, 0);
+    
+    CBORTestScalarModel *model = [CBORTestScalarModel new];
+    model.small = -2;
+    model.city = @"x";
+    CBORTestScalarModel *decoded = (CBORTestScalarModel *)[decoder decodeClass:[CBORTestScalarModel class] fromData:[CBORParser encodeObject:model]];
+    XCTAssertEqual(decoded.small, -2);
+    XCTAssertEqualObjects(decoded.city, @"x");
+    
+    [decoder reset];
+    XCTAssertEqual(decoder.internTable.count, 0);
+    XCTAssertEqualObjects([decoder decodeData:data], first);
+    XCTAssertEqual([CBORDecodeContext currentContext], [CBORDecodeContext currentContext]);
+}
+
+- (void)testDuplicateMapKeys {
+    // 重复的键只写入首个有值的属性，与转JSON一致
+    CBORTestDuplicateKeyModel *model = [CBORTestDuplicateKeyModel new];
+    model.second = @"b";
+    NSData *expected = CBORData(0xa1, 0x65, 'v', 'a', 'l', 'u', 'e', 0x61, 'b');
+    XCTAssertEqualObjects([CBORParser encodeObject:model], expected);
+    XCTAssertEqual([CBORParser encodedLengthOfObject:model], expected.length);
+    
+    model.first = @"a";
+    expected = CBORData(0xa1, 0x65, 'v', 'a', 'l', 'u', 'e', 0x61, 'a');
+    XCTAssertEqualObjects([CBORParser encodeObject:model], expected);
+    
+    CBORTestDuplicateKeyModel *decoded = (CBORTestDuplicateKeyModel *)[CBORParser decodeClass:[CBORTestDuplicateKeyModel class] fromData:expected];
+    XCTAssertEqualObjects(decoded.first, @"a");
+    XCTAssertEqualObjects(decoded.second, @"a");
+}
+
+- (void)testCBORMapDuplicateKeys {
+    CBORNumber *one = [CBORNumber numberWithMajor:CBORMajorTypeUnsigned unsignedValue:1];
+    CBORNumber *two = [CBORNumber numberWithMajor:CBORMajorTypeUnsigned unsignedValue:2];
+    CBORObject *key = [CBORDecoder decodeData:CBORData(0x61, 'k')];
+    
+    // 各重复键处理方式，条目较少（顺序比较）与较多（散列索引）时一致
+    for (NSUInteger padding = 0; padding <= 12; padding += 12) {
+        CBORMutableMap *lastWins = [[CBORMutableMap alloc] initWithMajor:CBORMajorTypeMap];
+        CBORMutableMap *firstWins = [[CBORMutableMap alloc] initWithMajor:CBORMajorTypeMap];
+        firstWins.duplicateKeyPolicy = CBORMapDuplicateKeyPolicyFirstWins;
+        CBORMutableMap *reject = [[CBORMutableMap alloc] initWithMajor:CBORMajorTypeMap];
+        reject.duplicateKeyPolicy = CBORMapDuplicateKeyPolicyReject;
+        for (CBORMutableMap *map in @[lastWins, firstWins, reject]) {
+            for (NSUInteger index = 0; index < padding; index++) {
+                XCTAssertTrue([map setCBOR:one forKey:[CBORNumber numberWithMajor:CBORMajorTypeUnsigned unsignedValue:100 + index]]);
+            }
+            XCTAssertTrue([map setCBOR:one forKey:key]);
+        }
+        
+        XCTAssertTrue([lastWins setCBOR:two forKey:key]);
+        XCTAssertEqual([lastWins cborForKey:key], two);
+        XCTAssertFalse([firstWins setCBOR:two forKey:key]);
+        XCTAssertEqual([firstWins cborForKey:key], one);
+        XCTAssertFalse([reject setCBOR:two forKey:key]);
+        XCTAssertEqual([reject cborForKey:key], one);
+        for (CBORMutableMap *map in @[lastWins, firstWins, reject]) {
+            XCTAssertEqual(map.count, padding + 1);
+        }
+    }
+    
+    // 散列索引：不同编码宽度的整数键命中同一条目，替换值不改变条目数量与顺序
+    CBORMutableMap *map = [[CBORMutableMap alloc] initWithMajor:CBORMajorTypeMap];
+    for (NSUInteger index = 0; index < 12; index++) {
+        map[[CBORNumber numberWithMajor:CBORMajorTypeUnsigned unsignedValue:index]] = [CBORNumber numberWithMajor:CBORMajorTypeNegative unsignedValue:index];
+    }
+    CBORObject *wide = [CBORDecoder decodeData:CBORData(0x19, 0x00, 0x05)];
+    XCTAssertEqualObjects([map cborForKey:wide], [CBORNumber numberWithMajor:CBORMajorTypeNegative unsignedValue:5]);
+    map[wide] = two;
+    XCTAssertEqual(map.count, 12);
+    XCTAssertEqual(map[[CBORNumber numberWithMajor:CBORMajorTypeUnsigned unsignedValue:5]], two);
+    XCTAssertNil([map cborForKey:[CBORNumber numberWithMajor:CBORMajorTypeUnsigned unsignedValue:12]]);
+    
+    // 可变键写入后修改不影响已存储的键
+    CBORMutableArray *mutableKey = [[CBORMutableArray alloc] initWithMajor:CBORMajorTypeArray];
+    [mutableKey addCBOR:one];
+    map[mutableKey] = one;
+    [mutableKey addCBOR:two];
+    XCTAssertEqual([map cborForKey:[CBORDecoder decodeData:CBORData(0x81, 0x01)]], one);
+    XCTAssertNil([map cborForKey:mutableKey]);
+    XCTAssertEqual(map.count, 13);
+    
+    // 相等与散列一致：整数编码宽度、分段与定长字符串、NaN与正负零
+    NSArray<NSArray<NSData *> *> *groups = @[
+        @[CBORData(0x19, 0x01, 0xf4), CBORData(0x1a, 0x00, 0x00, 0x01, 0xf4), CBORData(0x1b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xf4)],
+        @[CBORData(0x62, 'a', 'b'), CBORData(0x7f, 0x61, 'a', 0x61, 'b', 0xff), CBORData(0x7f, 0x62, 'a', 'b', 0xff)],
+        @[CBORData(0xf9, 0x7e, 0x00), CBORData(0xfa, 0x7f, 0xc0, 0x00, 0x00), CBORData(0xfb, 0x7f, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00)],
+        @[CBORData(0xf9, 0x00, 0x00), CBORData(0xf9, 0x80, 0x00), CBORData(0xfb, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00)],
+    ];
+    for (NSArray<NSData *> *group in groups) {
+        CBORObject *expected = [CBORDecoder decodeData:group[0]];
+        XCTAssertNil([map cborForKey:expected]);
+        for (NSData *data in group) {
+            CBORObject *cbor = [CBORDecoder decodeData:data];
+            XCTAssertEqualObjects(cbor, expected);
+            XCTAssertEqual([cbor hash], [expected hash]);
+            
+            map[cbor] = one;
+            XCTAssertEqual([map cborForKey:expected], one);
+        }
+    }
+    XCTAssertEqual(map.count, 13 + groups.count);
+    XCTAssertNotEqualObjects([CBORDecoder decodeData:CBORData(0x62, 'a', 'b')], [CBORDecoder decodeData:CBORData(0x42, 'a', 'b')]);
+}
+
+- (void)testSharedImmutableValues {
+    // 0~23、-1~-24、布尔与null为共享实例，编码宽度与值保持不变
+    NSArray *object = @[@0, @23, @24, @(-1), @(-24), @(-25), @YES, @NO, [NSNull null], @[@1, @[@1]], @{@"a": @1}];
+    NSData *expected = CBORData(0x8b, 0x00, 0x17, 0x18, 0x18, 0x20, 0x37, 0x38, 0x18, 0xf5, 0xf4, 0xf6, 0x82, 0x01, 0x81, 0x01, 0xa1, 0x61, 'a', 0x01);
+    XCTAssertEqualObjects([CBORParser encodeObject:object], expected);
+    
+    // 解码结果不可变，多线程并发解码共享同一批实例
+    __block NSUInteger mismatches = 0;
+    NSLock *lock = [NSLock new];
+    dispatch_apply(64, dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^(size_t iteration) {
+        NSObject *decoded = [CBORParser decodeData:expected];
+        if (![[CBORParser encodeObject:decoded] isEqualToData:expected]) {
+            [lock lock];
+            mismatches++;
+            [lock unlock];
+        }
+    });
+    XCTAssertEqual(mismatches, 0);
+}
+
+- (void)testImmutableCBORObjects {
+    CBORNumber *one = [CBORNumber numberWithMajor:CBORMajorTypeUnsigned unsignedValue:1];
+    CBORNumber *large = [CBORNumber numberWithMajor:CBORMajorTypeUnsigned unsignedValue:1000];
+    CBORObject *keyA = [CBORDecoder decodeData:CBORData(0x61, 'a')];
+    CBORObject *keyB = [CBORDecoder decodeData:CBORData(0x61, 'b')];
+    
+    // 不可变对象拷贝即自身
+    CBORArray *array = (CBORArray *)[CBORDecoder decodeData:CBORData(0x82, 0x01, 0xf5)];
+    CBORMap *map = (CBORMap *)[CBORDecoder decodeData:CBORData(0xa1, 0x61, 'a', 0x01)];
+    XCTAssertEqual([array copy], array);
+    XCTAssertEqual([map copy], map);
+    XCTAssertEqual([large copy], large);
+    XCTAssertEqual([one copy], one);
+    
+    // 简单类型与小整数在不同解码结果间为同一实例
+    // {0: false, 1: true, 2: null, 3: undefined, 4: 23, 5: -24}
+    NSData *data = CBORData(0xa6, 0x00, 0xf4, 0x01, 0xf5, 0x02, 0xf6, 0x03, 0xf7, 0x04, 0x17, 0x05, 0x37);
+    CBORMap *first = (CBORMap *)[CBORDecoder decodeData:data];
+    CBORMap *second = (CBORMap *)[CBORDecoder decodeData:data];
+    NSArray *shared = @[[CBORSimple cborNO], [CBORSimple cborYES], [CBORSimple cborNull], [CBORSimple cborUndefined],
+                        [CBORNumber numberWithMajor:CBORMajorTypeUnsigned unsignedValue:23],
+                        [CBORNumber numberWithMajor:CBORMajorTypeNegative unsignedValue:23]];
+    for (NSUInteger index = 0; index < shared.count; index++) {
+        CBORNumber *key = [CBORNumber numberWithMajor:CBORMajorTypeUnsigned unsignedValue:index];
+        XCTAssertEqual([first cborForKey:key], shared[index]);
+        XCTAssertEqual([second cborForKey:key], shared[index]);
+    }
+    
+    // 可变拷贝与原对象相互独立
+    CBORMutableArray *mutableArray = [array mutableCopy];
+    XCTAssertTrue([mutableArray isKindOfClass:[CBORMutableArray class]]);
+    [mutableArray addCBOR:large];
+    XCTAssertEqual(array.count, 2);
+    XCTAssertEqual(mutableArray.count, 3);
+    
+    // 可变对象的拷贝不可变，不随原对象变化
+    CBORArray *arraySnapshot = [mutableArray copy];
+    XCTAssertNotEqual(arraySnapshot, mutableArray);
+    XCTAssertFalse([arraySnapshot isKindOfClass:[CBORMutableArray class]]);
+    XCTAssertEqual([arraySnapshot copy], arraySnapshot);
+    [mutableArray addCBOR:one];
+    XCTAssertEqual(arraySnapshot.count, 3);
+    XCTAssertEqual(mutableArray.count, 4);
+    CBORMutableArray *otherArray = [mutableArray mutableCopy];
+    XCTAssertNotEqual(otherArray, mutableArray);
+    [otherArray addCBOR:one];
+    XCTAssertEqual(mutableArray.count, 4);
+    XCTAssertEqual(otherArray.count, 5);
+    
+    CBORMutableMap *mutableMap = [map mutableCopy];
+    XCTAssertTrue([mutableMap isKindOfClass:[CBORMutableMap class]]);
+    mutableMap[keyB] = large;
+    XCTAssertEqual(map.count, 1);
+    XCTAssertNil([map cborForKey:keyB]);
+    XCTAssertEqual(mutableMap.count, 2);
+    
+    CBORMap *mapSnapshot = [mutableMap copy];
+    XCTAssertNotEqual(mapSnapshot, mutableMap);
+    XCTAssertFalse([mapSnapshot isKindOfClass:[CBORMutableMap class]]);
+    XCTAssertEqual([mapSnapshot copy], mapSnapshot);
+    mutableMap[keyA] = large;
+    XCTAssertEqual([mapSnapshot cborForKey:keyA], one);
+    XCTAssertEqual([map cborForKey:keyA], one);
+    XCTAssertEqual([mutableMap cborForKey:keyA], large);
+    CBORMutableMap *otherMap = [mutableMap mutableCopy];
+    XCTAssertNotEqual(otherMap, mutableMap);
+    otherMap[keyA] = one;
+    XCTAssertEqual([mutableMap cborForKey:keyA], large);
+    XCTAssertEqual([otherMap cborForKey:keyA], one);
+}
+
 @end